@@ -28,12 +28,17 @@
 #include "controller_interface/chainable_controller_interface.hpp"
 #include "diff_drive_controller/odometry.hpp"
 #include "diff_drive_controller/speed_limiter.hpp"
+#include "geometry_msgs/msg/pose_with_covariance_stamped.hpp"
 #include "geometry_msgs/msg/twist_stamped.hpp"
+#include "mobile_base_controllers_common/inverse_kinematics_cache.hpp"
+#include "mobile_base_controllers_common/inverse_kinematics_cache_diagnostics.hpp"
+#include "mobile_base_controllers_common/odometry_reset_request.hpp"
 #include "nav_msgs/msg/odometry.hpp"
 #include "odometry.hpp"
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_buffer.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
+#include "std_srvs/srv/empty.hpp"
 #include "tf2_msgs/msg/tf_message.hpp"
 
 // auto-generated by generate_parameter_library
@@ -44,6 +49,7 @@ namespace diff_drive_controller
 class DiffDriveController : public controller_interface::ChainableControllerInterface
 {
   using TwistStamped = geometry_msgs::msg::TwistStamped;
+  using PoseWithCovarianceStamped = geometry_msgs::msg::PoseWithCovarianceStamped;
 
 public:
   DiffDriveController();
@@ -124,11 +130,34 @@ protected:
 
   realtime_tools::RealtimeBuffer<std::shared_ptr<TwistStamped>> received_velocity_msg_ptr_{nullptr};
 
+  // Frame of the published odometry, including the tf prefix
+  std::string odom_frame_id_;
+  rclcpp::Service<std_srvs::srv::Empty>::SharedPtr reset_odom_service_ = nullptr;
+  rclcpp::Subscription<PoseWithCovarianceStamped>::SharedPtr set_odometry_pose_subscriber_ =
+    nullptr;
+
+  // Odometry reset requested by the service or the set pose subscriber, applied by the next update
+  using OdometryResetRequest = mobile_base_controllers_common::OdometryResetRequest;
+  mobile_base_controllers_common::OdometryResetSlot odometry_reset_slot_;
+
   std::queue<std::array<double, 2>> previous_two_commands_;
   // speed limiters
   std::unique_ptr<SpeedLimiter> limiter_linear_;
   std::unique_ptr<SpeedLimiter> limiter_angular_;
 
+  // Limited command and wheel velocities of the last steady reference
+  struct SteadyCommand
+  {
+    double linear = 0.0;                // [m/s]
+    double angular = 0.0;               // [rad/s]
+    double left_wheel_velocity = 0.0;   // [rad/s]
+    double right_wheel_velocity = 0.0;  // [rad/s]
+  };
+  using SteadyCommandCache =
+    mobile_base_controllers_common::InverseKinematicsCache<2, SteadyCommand>;
+  SteadyCommandCache ik_cache_;
+  mobile_base_controllers_common::InverseKinematicsCacheDiagnostics ik_cache_diagnostics_;
+
   bool publish_limited_velocity_ = false;
   std::shared_ptr<rclcpp::Publisher<TwistStamped>> limited_velocity_publisher_ = nullptr;
   std::shared_ptr<realtime_tools::RealtimePublisher<TwistStamped>>
@@ -141,6 +170,13 @@ protected:
   rclcpp::Duration publish_period_ = rclcpp::Duration::from_nanoseconds(0);
   rclcpp::Time previous_publish_timestamp_{0, 0, RCL_CLOCK_UNINITIALIZED};
 
+  void reset_odometry(
+    const std::shared_ptr<rmw_request_id_t> request_header,
+    const std::shared_ptr<std_srvs::srv::Empty::Request> req,
+    std::shared_ptr<std_srvs::srv::Empty::Response> res);
+  void set_odometry_pose(const std::shared_ptr<PoseWithCovarianceStamped> msg);
+  void apply_odometry_reset_request();
+
   bool reset();
   void halt();
 
@@ -22,6 +22,8 @@
 #ifndef DIFF_DRIVE_CONTROLLER__ODOMETRY_HPP_
 #define DIFF_DRIVE_CONTROLLER__ODOMETRY_HPP_
 
+#include <array>
+
 #include "rclcpp/time.hpp"
 // \note The versions conditioning is added here to support the source-compatibility with Humble
 #if RCPPUTILS_VERSION_MAJOR >= 2 && RCPPUTILS_VERSION_MINOR >= 6
@@ -42,15 +44,21 @@ public:
   bool updateFromVelocity(double left_vel, double right_vel, const rclcpp::Time & time);
   void updateOpenLoop(double linear, double angular, const rclcpp::Time & time);
   void resetOdometry();
+  // The covariance of x, y and heading is row-major, the default resets it
+  void setPose(
+    double x, double y, double heading, const std::array<double, 9> & pose_covariance = {});
 
   double getX() const { return x_; }
   double getY() const { return y_; }
   double getHeading() const { return heading_; }
   double getLinear() const { return linear_; }
   double getAngular() const { return angular_; }
+  // Row-major covariance of x, y and heading
+  const std::array<double, 9> & getPoseCovariance() const { return pose_covariance_; }
 
   void setWheelParams(double wheel_separation, double left_wheel_radius, double right_wheel_radius);
   void setVelocityRollingWindowSize(size_t velocity_rolling_window_size);
+  void setPoseCovariancePropagation(bool enable, double wheel_variance_rate);
 
 private:
 // \note The versions conditioning is added here to support the source-compatibility with Humble
@@ -62,6 +70,7 @@ private:
 
   void integrateRungeKutta2(double linear, double angular);
   void integrateExact(double linear, double angular);
+  void propagatePoseCovariance(double left_displacement, double right_displacement);
   void resetAccumulators();
 
   // Current timestamp:
@@ -76,6 +85,11 @@ private:
   double linear_;   //   [m/s]
   double angular_;  // [rad/s]
 
+  // Covariance of the pose, propagated by the wheel noise model:
+  bool propagate_pose_covariance_;
+  double wheel_variance_rate_;  // [m^2/m]
+  std::array<double, 9> pose_covariance_;
+
   // Wheel kinematic parameters [m]:
   double wheel_separation_;
   double left_wheel_radius_;
@@ -89,6 +103,8 @@ private:
   size_t velocity_rolling_window_size_;
   RollingMeanAccumulator linear_accumulator_;
   RollingMeanAccumulator angular_accumulator_;
+  // Cleared accumulator of the window size, copied to reset the accumulators without allocation
+  RollingMeanAccumulator empty_accumulator_;
 };
 
 }  // namespace diff_drive_controller
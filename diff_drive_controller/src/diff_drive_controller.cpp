@@ -16,6 +16,8 @@
  * Author: Bence Magyar, Enrique Fernández, Manuel Meraz
  */
 
+#include <array>
+#include <functional>
 #include <memory>
 #include <queue>
 #include <string>
@@ -26,6 +28,7 @@
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
 #include "lifecycle_msgs/msg/state.hpp"
 #include "rclcpp/logging.hpp"
+#include "tf2/LinearMath/Matrix3x3.hpp"
 #include "tf2/LinearMath/Quaternion.hpp"
 
 namespace
@@ -34,6 +37,8 @@ constexpr auto DEFAULT_COMMAND_TOPIC = "~/cmd_vel";
 constexpr auto DEFAULT_COMMAND_OUT_TOPIC = "~/cmd_vel_out";
 constexpr auto DEFAULT_ODOMETRY_TOPIC = "~/odom";
 constexpr auto DEFAULT_TRANSFORM_TOPIC = "/tf";
+constexpr auto DEFAULT_RESET_ODOM_SERVICE = "~/reset_odometry";
+constexpr auto DEFAULT_SET_ODOM_POSE_TOPIC = "~/set_odometry_pose";
 }  // namespace
 
 namespace diff_drive_controller
@@ -146,6 +151,8 @@ controller_interface::return_type DiffDriveController::update_and_write_commands
 {
   auto logger = get_node()->get_logger();
 
+  apply_odometry_reset_request();
+
   // command may be limited further by SpeedLimit,
   // without affecting the stored twist command
   double linear_command = reference_interfaces_[0];
@@ -245,6 +252,11 @@ controller_interface::return_type DiffDriveController::update_and_write_commands
       odometry_message.pose.pose.orientation.w = orientation.w();
       odometry_message.twist.twist.linear.x = odometry_.getLinear();
       odometry_message.twist.twist.angular.z = odometry_.getAngular();
+      if (params_.pose_covariance_propagation.enable)
+      {
+        mobile_base_controllers_common::set_planar_pose_covariance(
+          odometry_.getPoseCovariance(), odometry_message.pose.covariance);
+      }
       realtime_odometry_publisher_->unlockAndPublish();
     }
 
@@ -262,49 +274,84 @@ controller_interface::return_type DiffDriveController::update_and_write_commands
     }
   }
 
-  double & last_linear = previous_two_commands_.back()[0];
-  double & second_to_last_linear = previous_two_commands_.front()[0];
-  double & last_angular = previous_two_commands_.back()[1];
-  double & second_to_last_angular = previous_two_commands_.front()[1];
-
-  limiter_linear_->limit(linear_command, last_linear, second_to_last_linear, period.seconds());
-  limiter_angular_->limit(angular_command, last_angular, second_to_last_angular, period.seconds());
-  previous_two_commands_.pop();
-  previous_two_commands_.push({{linear_command, angular_command}});
+  // Limit the command and compute the wheel velocities, unless the reference is the same as in the
+  // last steady cycle
+  const SteadyCommandCache::Key ik_key = {{linear_command, angular_command}};
+  const SteadyCommand * cached_command =
+    params_.inverse_kinematics_cache.enable ? ik_cache_.lookup(ik_key) : nullptr;
+  SteadyCommand command;
+  if (cached_command)
+  {
+    // a fixed point of the limiters, which are skipped as their history would not change
+    command = *cached_command;
+  }
+  else
+  {
+    const double last_linear = previous_two_commands_.back()[0];
+    const double second_to_last_linear = previous_two_commands_.front()[0];
+    const double last_angular = previous_two_commands_.back()[1];
+    const double second_to_last_angular = previous_two_commands_.front()[1];
+
+    limiter_linear_->limit(linear_command, last_linear, second_to_last_linear, period.seconds());
+    limiter_angular_->limit(
+      angular_command, last_angular, second_to_last_angular, period.seconds());
+    previous_two_commands_.pop();
+    previous_two_commands_.push({{linear_command, angular_command}});
+
+    // Compute wheels velocities:
+    command.linear = linear_command;
+    command.angular = angular_command;
+    command.left_wheel_velocity =
+      (linear_command - angular_command * wheel_separation / 2.0) / left_wheel_radius;
+    command.right_wheel_velocity =
+      (linear_command + angular_command * wheel_separation / 2.0) / right_wheel_radius;
+
+    // The limiters cannot enforce a minimum rate of change, so a command which they pass unchanged
+    // after the same last command is returned again for any following period.
+    if (
+      params_.inverse_kinematics_cache.enable && linear_command == ik_key[0] &&
+      angular_command == ik_key[1] && linear_command == last_linear &&
+      angular_command == last_angular)
+    {
+      ik_cache_.store(ik_key, command);
+    }
+    else
+    {
+      ik_cache_.invalidate();
+    }
+  }
 
   //    Publish limited velocity
   if (publish_limited_velocity_ && realtime_limited_velocity_publisher_->trylock())
   {
     auto & limited_velocity_command = realtime_limited_velocity_publisher_->msg_;
     limited_velocity_command.header.stamp = time;
-    limited_velocity_command.twist.linear.x = linear_command;
+    limited_velocity_command.twist.linear.x = command.linear;
     limited_velocity_command.twist.linear.y = 0.0;
     limited_velocity_command.twist.linear.z = 0.0;
     limited_velocity_command.twist.angular.x = 0.0;
     limited_velocity_command.twist.angular.y = 0.0;
-    limited_velocity_command.twist.angular.z = angular_command;
+    limited_velocity_command.twist.angular.z = command.angular;
     realtime_limited_velocity_publisher_->unlockAndPublish();
   }
 
-  // Compute wheels velocities:
-  const double velocity_left =
-    (linear_command - angular_command * wheel_separation / 2.0) / left_wheel_radius;
-  const double velocity_right =
-    (linear_command + angular_command * wheel_separation / 2.0) / right_wheel_radius;
-
   // Set wheels velocities:
   bool set_command_result = true;
   for (size_t index = 0; index < static_cast<size_t>(wheels_per_side_); ++index)
   {
-    set_command_result &=
-      registered_left_wheel_handles_[index].velocity.get().set_value(velocity_left);
-    set_command_result &=
-      registered_right_wheel_handles_[index].velocity.get().set_value(velocity_right);
+    set_command_result &= registered_left_wheel_handles_[index].velocity.get().set_value(
+      command.left_wheel_velocity);
+    set_command_result &= registered_right_wheel_handles_[index].velocity.get().set_value(
+      command.right_wheel_velocity);
   }
 
   RCLCPP_DEBUG_EXPRESSION(
     logger, !set_command_result, "Unable to set the command to one of the command handles!");
 
+  if (params_.inverse_kinematics_cache.enable)
+  {
+    ik_cache_diagnostics_.publish(time, ik_cache_.hits(), ik_cache_.lookups());
+  }
   return controller_interface::return_type::OK;
 }
 
@@ -334,6 +381,9 @@ controller_interface::CallbackReturn DiffDriveController::on_configure(
 
   odometry_.setWheelParams(wheel_separation, left_wheel_radius, right_wheel_radius);
   odometry_.setVelocityRollingWindowSize(static_cast<size_t>(params_.velocity_rolling_window_size));
+  odometry_.setPoseCovariancePropagation(
+    params_.pose_covariance_propagation.enable,
+    params_.pose_covariance_propagation.wheel_variance_rate);
 
   cmd_vel_timeout_ = rclcpp::Duration::from_seconds(params_.cmd_vel_timeout);
   publish_limited_velocity_ = params_.publish_limited_velocity;
@@ -440,11 +490,11 @@ controller_interface::CallbackReturn DiffDriveController::on_configure(
     }
   }
 
-  const auto odom_frame_id = tf_prefix + params_.odom_frame_id;
+  odom_frame_id_ = tf_prefix + params_.odom_frame_id;
   const auto base_frame_id = tf_prefix + params_.base_frame_id;
 
   auto & odometry_message = realtime_odometry_publisher_->msg_;
-  odometry_message.header.frame_id = odom_frame_id;
+  odometry_message.header.frame_id = odom_frame_id_;
   odometry_message.child_frame_id = base_frame_id;
 
   // limit the publication on the topics /odom and /tf
@@ -474,9 +524,24 @@ controller_interface::CallbackReturn DiffDriveController::on_configure(
   // keeping track of odom and base_link transforms only
   auto & odometry_transform_message = realtime_odometry_transform_publisher_->msg_;
   odometry_transform_message.transforms.resize(1);
-  odometry_transform_message.transforms.front().header.frame_id = odom_frame_id;
+  odometry_transform_message.transforms.front().header.frame_id = odom_frame_id_;
   odometry_transform_message.transforms.front().child_frame_id = base_frame_id;
 
+  // initialize the publisher of the inverse kinematics cache statistics
+  if (params_.inverse_kinematics_cache.enable)
+  {
+    ik_cache_diagnostics_.configure(get_node());
+  }
+
+  // Create odom reset service and pose subscriber
+  reset_odom_service_ = get_node()->create_service<std_srvs::srv::Empty>(
+    DEFAULT_RESET_ODOM_SERVICE, std::bind(
+                                  &DiffDriveController::reset_odometry, this, std::placeholders::_1,
+                                  std::placeholders::_2, std::placeholders::_3));
+  set_odometry_pose_subscriber_ = get_node()->create_subscription<PoseWithCovarianceStamped>(
+    DEFAULT_SET_ODOM_POSE_TOPIC, rclcpp::SystemDefaultsQoS(),
+    [this](const std::shared_ptr<PoseWithCovarianceStamped> msg) { set_odometry_pose(msg); });
+
   previous_update_timestamp_ = get_node()->get_clock()->now();
   return controller_interface::CallbackReturn::SUCCESS;
 }
@@ -541,9 +606,58 @@ controller_interface::CallbackReturn DiffDriveController::on_error(const rclcpp_
   return controller_interface::CallbackReturn::SUCCESS;
 }
 
+void DiffDriveController::reset_odometry(
+  const std::shared_ptr<rmw_request_id_t> /*request_header*/,
+  const std::shared_ptr<std_srvs::srv::Empty::Request> /*req*/,
+  std::shared_ptr<std_srvs::srv::Empty::Response> /*res*/)
+{
+  odometry_reset_slot_.write(OdometryResetRequest{});
+  RCLCPP_INFO(get_node()->get_logger(), "Odometry reset requested");
+}
+
+void DiffDriveController::set_odometry_pose(const std::shared_ptr<PoseWithCovarianceStamped> msg)
+{
+  if (!msg->header.frame_id.empty() && msg->header.frame_id != odom_frame_id_)
+  {
+    RCLCPP_WARN(
+      get_node()->get_logger(), "Odometry pose ignored, it is in frame '%s' instead of '%s'",
+      msg->header.frame_id.c_str(), odom_frame_id_.c_str());
+    return;
+  }
+
+  const auto & pose = msg->pose.pose;
+  double roll, pitch, yaw;
+  tf2::Matrix3x3(tf2::Quaternion(
+                   pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w))
+    .getRPY(roll, pitch, yaw);
+  odometry_reset_slot_.write(
+    {true, pose.position.x, pose.position.y, yaw,
+     mobile_base_controllers_common::planar_pose_covariance(msg->pose.covariance)});
+}
+
+void DiffDriveController::apply_odometry_reset_request()
+{
+  OdometryResetRequest request;
+  if (!odometry_reset_slot_.read(request))
+  {
+    return;
+  }
+  if (request.set_pose)
+  {
+    odometry_.setPose(request.x, request.y, request.heading, request.pose_covariance);
+  }
+  else
+  {
+    odometry_.resetOdometry();
+  }
+}
+
 bool DiffDriveController::reset()
 {
   odometry_.resetOdometry();
+  // discard a request which was not applied yet
+  OdometryResetRequest discarded_request;
+  odometry_reset_slot_.read(discarded_request);
 
   reset_buffers();
 
@@ -566,6 +680,8 @@ void DiffDriveController::reset_buffers()
   std::swap(previous_two_commands_, empty);
   previous_two_commands_.push({{0.0, 0.0}});
   previous_two_commands_.push({{0.0, 0.0}});
+  // computed with the previous commands
+  ik_cache_.invalidate();
 
   // Fill RealtimeBuffer with NaNs so it will contain a known value
   // but still indicate that no command has yet been sent.
@@ -19,6 +19,7 @@
 #include <cmath>
 
 #include "diff_drive_controller/odometry.hpp"
+#include "mobile_base_controllers_common/pose_covariance_propagation.hpp"
 
 namespace diff_drive_controller
 {
@@ -29,6 +30,9 @@ Odometry::Odometry(size_t velocity_rolling_window_size)
   heading_(0.0),
   linear_(0.0),
   angular_(0.0),
+  propagate_pose_covariance_(false),
+  wheel_variance_rate_(0.0),
+  pose_covariance_{},
   wheel_separation_(0.0),
   left_wheel_radius_(0.0),
   right_wheel_radius_(0.0),
@@ -36,7 +40,8 @@ Odometry::Odometry(size_t velocity_rolling_window_size)
   right_wheel_old_pos_(0.0),
   velocity_rolling_window_size_(velocity_rolling_window_size),
   linear_accumulator_(velocity_rolling_window_size),
-  angular_accumulator_(velocity_rolling_window_size)
+  angular_accumulator_(velocity_rolling_window_size),
+  empty_accumulator_(velocity_rolling_window_size)
 {
 }
 
@@ -85,6 +90,11 @@ bool Odometry::updateFromVelocity(double left_vel, double right_vel, const rclcp
   // Now there is a bug about scout angular velocity
   const double angular = (right_vel - left_vel) / wheel_separation_;
 
+  if (propagate_pose_covariance_)
+  {
+    propagatePoseCovariance(left_vel, right_vel);
+  }
+
   // Integrate odometry:
   integrateExact(linear, angular);
 
@@ -117,6 +127,17 @@ void Odometry::resetOdometry()
   x_ = 0.0;
   y_ = 0.0;
   heading_ = 0.0;
+  pose_covariance_.fill(0.0);
+  resetAccumulators();
+}
+
+void Odometry::setPose(
+  double x, double y, double heading, const std::array<double, 9> & pose_covariance)
+{
+  x_ = x;
+  y_ = y;
+  heading_ = heading;
+  pose_covariance_ = pose_covariance;
 }
 
 void Odometry::setWheelParams(
@@ -130,10 +151,17 @@ void Odometry::setWheelParams(
 void Odometry::setVelocityRollingWindowSize(size_t velocity_rolling_window_size)
 {
   velocity_rolling_window_size_ = velocity_rolling_window_size;
+  empty_accumulator_ = RollingMeanAccumulator(velocity_rolling_window_size_);
 
   resetAccumulators();
 }
 
+void Odometry::setPoseCovariancePropagation(bool enable, double wheel_variance_rate)
+{
+  propagate_pose_covariance_ = enable;
+  wheel_variance_rate_ = wheel_variance_rate;
+}
+
 void Odometry::integrateRungeKutta2(double linear, double angular)
 {
   const double direction = heading_ + angular * 0.5;
@@ -161,10 +189,31 @@ void Odometry::integrateExact(double linear, double angular)
   }
 }
 
+void Odometry::propagatePoseCovariance(double left_displacement, double right_displacement)
+{
+  // The displacement error of each wheel grows with the distance it travels. Mapped to the linear
+  // and angular displacement of the base, (l + r) / 2 and (r - l) / b, its covariance is:
+  const double left_variance = wheel_variance_rate_ * std::abs(left_displacement);
+  const double right_variance = wheel_variance_rate_ * std::abs(right_displacement);
+  const double linear_variance = 0.25 * (left_variance + right_variance);
+  const double linear_angular_covariance =
+    0.5 * (right_variance - left_variance) / wheel_separation_;
+  const double angular_variance =
+    (left_variance + right_variance) / (wheel_separation_ * wheel_separation_);
+
+  const double linear = 0.5 * (left_displacement + right_displacement);
+  const double angular = (right_displacement - left_displacement) / wheel_separation_;
+
+  mobile_base_controllers_common::propagate_planar_pose_covariance(
+    pose_covariance_, heading_, linear, angular, linear_variance, linear_angular_covariance,
+    angular_variance);
+}
+
 void Odometry::resetAccumulators()
 {
-  linear_accumulator_ = RollingMeanAccumulator(velocity_rolling_window_size_);
-  angular_accumulator_ = RollingMeanAccumulator(velocity_rolling_window_size_);
+  // copy assignment reuses the buffers of the same window size, so this does not allocate
+  linear_accumulator_ = empty_accumulator_;
+  angular_accumulator_ = empty_accumulator_;
 }
 
 }  // namespace diff_drive_controller
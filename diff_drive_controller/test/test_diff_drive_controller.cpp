@@ -26,6 +26,7 @@
 #include "lifecycle_msgs/msg/state.hpp"
 #include "rclcpp/executor.hpp"
 #include "rclcpp/executors.hpp"
+#include "tf2/LinearMath/Quaternion.hpp"
 
 using CallbackReturn = controller_interface::CallbackReturn;
 using hardware_interface::HW_IF_POSITION;
@@ -78,10 +79,35 @@ public:
     return realtime_odometry_publisher_;
   }
 
+  const diff_drive_controller::Odometry & getOdometry() const { return odometry_; }
+
+  const SteadyCommandCache & getInverseKinematicsCache() const { return ik_cache_; }
+
+  // Imitate the service and subscriber callbacks
+  void callResetOdometry() { reset_odometry(nullptr, nullptr, nullptr); }
+
+  void publishOdometryPose(
+    double x, double y, double heading, const std::string & frame_id = "odom")
+  {
+    auto msg = std::make_shared<geometry_msgs::msg::PoseWithCovarianceStamped>();
+    msg->header.frame_id = frame_id;
+    msg->pose.pose.position.x = x;
+    msg->pose.pose.position.y = y;
+    tf2::Quaternion orientation;
+    orientation.setRPY(0.0, 0.0, heading);
+    msg->pose.pose.orientation.x = orientation.x();
+    msg->pose.pose.orientation.y = orientation.y();
+    msg->pose.pose.orientation.z = orientation.z();
+    msg->pose.pose.orientation.w = orientation.w();
+    set_odometry_pose(msg);
+  }
+
   // Declare these tests as friends so we can access controller_->reference_interfaces_
   FRIEND_TEST(TestDiffDriveController, chainable_controller_unchained_mode);
   FRIEND_TEST(TestDiffDriveController, chainable_controller_chained_mode);
   FRIEND_TEST(TestDiffDriveController, deactivate_then_activate);
+  FRIEND_TEST(TestDiffDriveController, odometry_reset_is_applied_by_the_next_update);
+  FRIEND_TEST(TestDiffDriveController, inverse_kinematics_cache_skips_steady_commands);
 };
 
 class TestDiffDriveController : public ::testing::Test
@@ -1219,6 +1245,181 @@ TEST_F(TestDiffDriveController, command_with_zero_timestamp_is_accepted_with_war
   executor.cancel();
 }
 
+TEST_F(TestDiffDriveController, odometry_reset_is_applied_by_the_next_update)
+{
+  // open loop with zero references, so that the odometry does not move
+  ASSERT_EQ(
+    InitController(
+      left_wheel_names, right_wheel_names,
+      {rclcpp::Parameter("open_loop", rclcpp::ParameterValue(true))}),
+    controller_interface::return_type::OK);
+  ASSERT_TRUE(controller_->set_chained_mode(true));
+
+  auto state = controller_->configure();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  assignResourcesNoFeedback();
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+  controller_->reference_interfaces_[0] = 0.0;
+  controller_->reference_interfaces_[1] = 0.0;
+
+  controller_->publishOdometryPose(1.0, -2.0, 0.5);
+  // the callbacks only hand the request over
+  EXPECT_EQ(controller_->getOdometry().getX(), 0.0);
+
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_DOUBLE_EQ(controller_->getOdometry().getX(), 1.0);
+  EXPECT_DOUBLE_EQ(controller_->getOdometry().getY(), -2.0);
+  EXPECT_NEAR(controller_->getOdometry().getHeading(), 0.5, 1e-12);
+
+  // a pose in another frame is ignored
+  controller_->publishOdometryPose(3.0, 3.0, 0.0, "map");
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_DOUBLE_EQ(controller_->getOdometry().getX(), 1.0);
+
+  // the latest request replaces the one which was not applied yet
+  controller_->publishOdometryPose(2.0, 2.0, 1.0);
+  controller_->callResetOdometry();
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(controller_->getOdometry().getX(), 0.0);
+  EXPECT_EQ(controller_->getOdometry().getY(), 0.0);
+  EXPECT_EQ(controller_->getOdometry().getHeading(), 0.0);
+}
+
+TEST_F(TestDiffDriveController, inverse_kinematics_cache_skips_steady_commands)
+{
+  ASSERT_EQ(
+    InitController(
+      left_wheel_names, right_wheel_names,
+      {rclcpp::Parameter("wheel_separation", 0.4), rclcpp::Parameter("wheel_radius", 1.0),
+       rclcpp::Parameter("linear.x.max_acceleration", 2.0),
+       rclcpp::Parameter("inverse_kinematics_cache.enable", true)}),
+    controller_interface::return_type::OK);
+
+  ASSERT_TRUE(controller_->set_chained_mode(true));
+  auto state = controller_->configure();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  assignResourcesPosFeedback();
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  const auto & cache = controller_->getInverseKinematicsCache();
+  const auto update = [&]()
+  {
+    ASSERT_EQ(
+      controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.1)),
+      controller_interface::return_type::OK);
+  };
+
+  const double linear = 1.0;
+  controller_->reference_interfaces_[0] = linear;
+  controller_->reference_interfaces_[1] = 0.0;
+
+  // nothing is cached while the acceleration is limited
+  for (int i = 0; i < 4; ++i)
+  {
+    update();
+    EXPECT_LT(left_wheel_vel_cmd_.get_optional().value(), linear);
+  }
+  EXPECT_EQ(cache.hits(), 0u);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    update();
+  }
+  EXPECT_EQ(linear, left_wheel_vel_cmd_.get_optional().value());
+  EXPECT_EQ(linear, right_wheel_vel_cmd_.get_optional().value());
+  // the target is reached and stored within the next three updates, whatever the rounding
+  EXPECT_GE(cache.hits(), 7u);
+  EXPECT_EQ(cache.lookups(), 14u);
+
+  // a new reference is limited again
+  const auto hits = cache.hits();
+  controller_->reference_interfaces_[0] = 0.0;
+  controller_->reference_interfaces_[1] = 1.0;
+  update();
+  EXPECT_EQ(cache.hits(), hits);
+  EXPECT_GT(
+    right_wheel_vel_cmd_.get_optional().value(), left_wheel_vel_cmd_.get_optional().value());
+
+  state = controller_->get_node()->deactivate();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+}
+
+TEST(TestDiffDriveOdometry, pose_covariance_is_propagated_from_wheel_noise)
+{
+  constexpr double WHEEL_SEPARATION = 0.5;
+  constexpr double WHEEL_VARIANCE_RATE = 1e-3;
+  constexpr double STEP = 0.01;
+  constexpr int STEPS = 100;
+
+  diff_drive_controller::Odometry odometry;
+  odometry.setWheelParams(WHEEL_SEPARATION, 1.0, 1.0);
+  odometry.setPoseCovariancePropagation(true, WHEEL_VARIANCE_RATE);
+  odometry.init(rclcpp::Time(0, 0, RCL_ROS_TIME));
+
+  // drive straight ahead, each wheel travels STEP per update
+  for (int i = 1; i <= STEPS; ++i)
+  {
+    ASSERT_TRUE(odometry.update(
+      i * STEP, i * STEP, rclcpp::Time(0, static_cast<uint32_t>(i * 1e7), RCL_ROS_TIME)));
+  }
+  const auto & covariance = odometry.getPoseCovariance();
+  const double wheel_variance = STEPS * WHEEL_VARIANCE_RATE * STEP;
+  // the wheel errors average along the path and difference into the heading
+  EXPECT_NEAR(covariance[0], 0.5 * wheel_variance, 1e-12);
+  EXPECT_NEAR(covariance[8], 2.0 * wheel_variance / (WHEEL_SEPARATION * WHEEL_SEPARATION), 1e-12);
+  // the heading error turns into a lateral one
+  EXPECT_GT(covariance[4], 0.0);
+  EXPECT_GT(covariance[5], 0.0);
+  EXPECT_NEAR(covariance[1], 0.0, 1e-12);
+  EXPECT_NEAR(covariance[2], 0.0, 1e-12);
+  for (size_t row = 0; row < 3; ++row)
+  {
+    for (size_t col = 0; col < 3; ++col)
+    {
+      EXPECT_EQ(covariance[3 * row + col], covariance[3 * col + row]);
+    }
+  }
+
+  odometry.resetOdometry();
+  EXPECT_THAT(odometry.getPoseCovariance(), ::testing::Each(0.0));
+
+  // not propagated when disabled
+  odometry.setPoseCovariancePropagation(false, WHEEL_VARIANCE_RATE);
+  ASSERT_TRUE(odometry.update(
+    (STEPS + 1) * STEP, (STEPS + 1) * STEP, rclcpp::Time(1, 10000000, RCL_ROS_TIME)));
+  EXPECT_THAT(odometry.getPoseCovariance(), ::testing::Each(0.0));
+}
+
+TEST(TestDiffDriveOdometry, set_pose_replaces_the_pose_covariance)
+{
+  diff_drive_controller::Odometry odometry;
+  odometry.setWheelParams(0.5, 1.0, 1.0);
+  odometry.setPoseCovariancePropagation(true, 1e-3);
+  odometry.init(rclcpp::Time(0, 0, RCL_ROS_TIME));
+  ASSERT_TRUE(odometry.update(0.1, 0.2, rclcpp::Time(0, 10000000, RCL_ROS_TIME)));
+
+  const std::array<double, 9> pose_covariance{{0.1, 0.01, 0.0, 0.01, 0.2, 0.0, 0.0, 0.0, 0.05}};
+  odometry.setPose(1.0, -2.0, 0.5, pose_covariance);
+  EXPECT_EQ(odometry.getPoseCovariance(), pose_covariance);
+
+  // the covariance is propagated from the set one
+  ASSERT_TRUE(odometry.update(0.2, 0.3, rclcpp::Time(0, 20000000, RCL_ROS_TIME)));
+  EXPECT_GT(odometry.getPoseCovariance()[0], pose_covariance[0]);
+  EXPECT_GT(odometry.getPoseCovariance()[8], pose_covariance[8]);
+
+  // a pose without covariance resets it
+  odometry.setPose(0.0, 0.0, 0.0);
+  EXPECT_THAT(odometry.getPoseCovariance(), ::testing::Each(0.0));
+}
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -19,16 +19,21 @@
 #ifndef FORCE_TORQUE_SENSOR_BROADCASTER__FORCE_TORQUE_SENSOR_BROADCASTER_HPP_
 #define FORCE_TORQUE_SENSOR_BROADCASTER__FORCE_TORQUE_SENSOR_BROADCASTER_HPP_
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <vector>
 
 #include "controller_interface/chainable_controller_interface.hpp"
 // auto-generated by generate_parameter_library
 #include "force_torque_sensor_broadcaster/force_torque_sensor_broadcaster_parameters.hpp"
+#include "geometry_msgs/msg/wrench.hpp"
 #include "geometry_msgs/msg/wrench_stamped.hpp"
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
 #include "semantic_components/force_torque_sensor.hpp"
+#include "sensor_broadcasters_common/publish_policy.hpp"
+#include "std_srvs/srv/trigger.hpp"
 
 namespace force_torque_sensor_broadcaster
 {
@@ -60,8 +65,15 @@ public:
   std::vector<hardware_interface::StateInterface> on_export_state_interfaces() override;
 
 protected:
-  void apply_sensor_offset(const Params & params, geometry_msgs::msg::WrenchStamped & msg);
-  void apply_sensor_multiplier(const Params & params, geometry_msgs::msg::WrenchStamped & msg);
+  void apply_sensor_offset(const Params & params, geometry_msgs::msg::Wrench & wrench);
+  void apply_sensor_multiplier(const Params & params, geometry_msgs::msg::Wrench & wrench);
+  void apply_temperature_compensation(geometry_msgs::msg::Wrench & wrench);
+  /// Sample the wrench for a requested tare and add the current tare offset to it.
+  void apply_tare_offset(geometry_msgs::msg::Wrench & wrench);
+
+  void tare(
+    const std::shared_ptr<std_srvs::srv::Trigger::Request> request,
+    std::shared_ptr<std_srvs::srv::Trigger::Response> response);
 
   std::shared_ptr<ParamListener> param_listener_;
   Params params_;
@@ -71,6 +83,34 @@ protected:
   using StatePublisher = realtime_tools::RealtimePublisher<geometry_msgs::msg::WrenchStamped>;
   rclcpp::Publisher<geometry_msgs::msg::WrenchStamped>::SharedPtr sensor_state_publisher_;
   std::unique_ptr<StatePublisher> realtime_publisher_;
+
+  // Owned by the RT loop and refreshed every cycle, the exported state interfaces point here
+  geometry_msgs::msg::Wrench wrench_state_;
+
+  // Reduces the wrenches between two publications, chained controllers still get every sample
+  std::array<double, 6> wrench_sample_;
+  sensor_broadcasters_common::PublishPolicy publish_policy_;
+
+  // Tare, requested by the service and sampled in the RT loop. The offset is owned by the RT loop
+  // and replaced as a whole once all samples are averaged.
+  enum class TareState : uint8_t
+  {
+    IDLE,
+    REQUESTED,
+    SAMPLING,
+  };
+  std::atomic<TareState> tare_state_{TareState::IDLE};
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr tare_service_;
+  size_t tare_samples_ = 0;
+  size_t tare_sample_count_ = 0;
+  std::array<double, 6> tare_sum_;
+  std::array<double, 6> tare_offset_;
+
+  // Temperature compensation, temperature_coefficients_ is the 6 x (1 + k) block and
+  // temperature_inputs_ holds [1, T_1, ..., T_k] of the current cycle
+  std::vector<size_t> temperature_interface_indices_;
+  std::vector<double> temperature_coefficients_;
+  std::vector<double> temperature_inputs_;
 };
 
 }  // namespace force_torque_sensor_broadcaster
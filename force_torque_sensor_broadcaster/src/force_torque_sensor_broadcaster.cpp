@@ -18,7 +18,11 @@
 
 #include "force_torque_sensor_broadcaster/force_torque_sensor_broadcaster.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <stdexcept>
 #include <string>
 
 namespace force_torque_sensor_broadcaster
@@ -87,6 +91,38 @@ controller_interface::CallbackReturn ForceTorqueSensorBroadcaster::on_configure(
         torque_names.z));
   }
 
+  const auto & temperature_interfaces = params_.temperature_compensation.interfaces;
+  const auto & temperature_coefficients = params_.temperature_compensation.coefficients;
+  if (
+    (!temperature_interfaces.empty() || !temperature_coefficients.empty()) &&
+    temperature_coefficients.size() != 6 * (1 + temperature_interfaces.size()))
+  {
+    RCLCPP_ERROR(
+      get_node()->get_logger(),
+      "'temperature_compensation.coefficients' needs 6 x (1 + %zu) values for %zu temperature "
+      "interfaces, got %zu.",
+      temperature_interfaces.size(), temperature_interfaces.size(),
+      temperature_coefficients.size());
+    return controller_interface::CallbackReturn::ERROR;
+  }
+  temperature_coefficients_ = temperature_coefficients;
+  temperature_inputs_.assign(1 + temperature_interfaces.size(), 1.0);
+
+  tare_samples_ = static_cast<size_t>(params_.tare.samples);
+  tare_offset_.fill(0.0);
+  tare_state_ = TareState::IDLE;
+
+  try
+  {
+    publish_policy_.configure_from_params(
+      wrench_sample_.size(), static_cast<double>(get_update_rate()), params_.publish_policy);
+  }
+  catch (const std::invalid_argument & e)
+  {
+    RCLCPP_ERROR(get_node()->get_logger(), "Invalid publish policy: %s", e.what());
+    return controller_interface::CallbackReturn::ERROR;
+  }
+
   try
   {
     // register ft sensor data publisher
@@ -106,6 +142,11 @@ controller_interface::CallbackReturn ForceTorqueSensorBroadcaster::on_configure(
   realtime_publisher_->msg_.header.frame_id = params_.frame_id;
   realtime_publisher_->unlock();
 
+  tare_service_ = get_node()->create_service<std_srvs::srv::Trigger>(
+    "~/tare", std::bind(
+                &ForceTorqueSensorBroadcaster::tare, this, std::placeholders::_1,
+                std::placeholders::_2));
+
   RCLCPP_INFO(get_node()->get_logger(), "configure successful");
   return controller_interface::CallbackReturn::SUCCESS;
 }
@@ -124,6 +165,10 @@ ForceTorqueSensorBroadcaster::state_interface_configuration() const
   controller_interface::InterfaceConfiguration state_interfaces_config;
   state_interfaces_config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
   state_interfaces_config.names = force_torque_sensor_->get_state_interface_names();
+  for (const auto & name : params_.temperature_compensation.interfaces)
+  {
+    state_interfaces_config.names.push_back(name);
+  }
   return state_interfaces_config;
 }
 
@@ -131,6 +176,28 @@ controller_interface::CallbackReturn ForceTorqueSensorBroadcaster::on_activate(
   const rclcpp_lifecycle::State & /*previous_state*/)
 {
   force_torque_sensor_->assign_loaned_state_interfaces(state_interfaces_);
+  publish_policy_.reset();
+
+  temperature_interface_indices_.clear();
+  for (const auto & name : params_.temperature_compensation.interfaces)
+  {
+    const auto it = std::find_if(
+      state_interfaces_.begin(), state_interfaces_.end(),
+      [&name](const auto & state_interface) { return state_interface.get_name() == name; });
+    if (it == state_interfaces_.end())
+    {
+      RCLCPP_ERROR(
+        get_node()->get_logger(), "Temperature state interface '%s' is not available.",
+        name.c_str());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    temperature_interface_indices_.push_back(
+      static_cast<size_t>(std::distance(state_interfaces_.begin(), it)));
+  }
+
+  // a tare interrupted by the deactivation starts over
+  auto sampling = TareState::SAMPLING;
+  tare_state_.compare_exchange_strong(sampling, TareState::REQUESTED);
   return controller_interface::CallbackReturn::SUCCESS;
 }
 
@@ -148,12 +215,33 @@ controller_interface::return_type ForceTorqueSensorBroadcaster::update_and_write
   {
     params_ = param_listener_->get_params();
   }
+
+  // chained controllers read the wrench every cycle, independent of the publisher lock
+  force_torque_sensor_->get_values_as_message(wrench_state_);
+  this->apply_sensor_offset(params_, wrench_state_);
+  this->apply_temperature_compensation(wrench_state_);
+  this->apply_tare_offset(wrench_state_);
+  this->apply_sensor_multiplier(params_, wrench_state_);
+
+  wrench_sample_ = {
+    {wrench_state_.force.x, wrench_state_.force.y, wrench_state_.force.z, wrench_state_.torque.x,
+     wrench_state_.torque.y, wrench_state_.torque.z}};
+  if (!publish_policy_.add_sample(wrench_sample_))
+  {
+    return controller_interface::return_type::OK;
+  }
+
   if (realtime_publisher_ && realtime_publisher_->trylock())
   {
+    const auto & sample = publish_policy_.output();
+    auto & wrench = realtime_publisher_->msg_.wrench;
     realtime_publisher_->msg_.header.stamp = time;
-    force_torque_sensor_->get_values_as_message(realtime_publisher_->msg_.wrench);
-    this->apply_sensor_offset(params_, realtime_publisher_->msg_);
-    this->apply_sensor_multiplier(params_, realtime_publisher_->msg_);
+    wrench.force.x = sample[0];
+    wrench.force.y = sample[1];
+    wrench.force.z = sample[2];
+    wrench.torque.x = sample[3];
+    wrench.torque.y = sample[4];
+    wrench.torque.z = sample[5];
     realtime_publisher_->unlockAndPublish();
   }
 
@@ -201,61 +289,145 @@ ForceTorqueSensorBroadcaster::on_export_state_interfaces()
   {
     exported_state_interfaces.emplace_back(
       hardware_interface::StateInterface(
-        export_prefix, force_names[0], &realtime_publisher_->msg_.wrench.force.x));
+        export_prefix, force_names[0], &wrench_state_.force.x));
   }
   if (!force_names[1].empty())
   {
     exported_state_interfaces.emplace_back(
       hardware_interface::StateInterface(
-        export_prefix, force_names[1], &realtime_publisher_->msg_.wrench.force.y));
+        export_prefix, force_names[1], &wrench_state_.force.y));
   }
   if (!force_names[2].empty())
   {
     exported_state_interfaces.emplace_back(
       hardware_interface::StateInterface(
-        export_prefix, force_names[2], &realtime_publisher_->msg_.wrench.force.z));
+        export_prefix, force_names[2], &wrench_state_.force.z));
   }
   if (!torque_names[0].empty())
   {
     exported_state_interfaces.emplace_back(
       hardware_interface::StateInterface(
-        export_prefix, torque_names[0], &realtime_publisher_->msg_.wrench.torque.x));
+        export_prefix, torque_names[0], &wrench_state_.torque.x));
   }
   if (!torque_names[1].empty())
   {
     exported_state_interfaces.emplace_back(
       hardware_interface::StateInterface(
-        export_prefix, torque_names[1], &realtime_publisher_->msg_.wrench.torque.y));
+        export_prefix, torque_names[1], &wrench_state_.torque.y));
   }
   if (!torque_names[2].empty())
   {
     exported_state_interfaces.emplace_back(
       hardware_interface::StateInterface(
-        export_prefix, torque_names[2], &realtime_publisher_->msg_.wrench.torque.z));
+        export_prefix, torque_names[2], &wrench_state_.torque.z));
   }
   return exported_state_interfaces;
 }
 
 void ForceTorqueSensorBroadcaster::apply_sensor_offset(
-  const Params & params, geometry_msgs::msg::WrenchStamped & msg)
+  const Params & params, geometry_msgs::msg::Wrench & wrench)
 {
-  msg.wrench.force.x += params.offset.force.x;
-  msg.wrench.force.y += params.offset.force.y;
-  msg.wrench.force.z += params.offset.force.z;
-  msg.wrench.torque.x += params.offset.torque.x;
-  msg.wrench.torque.y += params.offset.torque.y;
-  msg.wrench.torque.z += params.offset.torque.z;
+  wrench.force.x += params.offset.force.x;
+  wrench.force.y += params.offset.force.y;
+  wrench.force.z += params.offset.force.z;
+  wrench.torque.x += params.offset.torque.x;
+  wrench.torque.y += params.offset.torque.y;
+  wrench.torque.z += params.offset.torque.z;
 }
 
 void ForceTorqueSensorBroadcaster::apply_sensor_multiplier(
-  const Params & params, geometry_msgs::msg::WrenchStamped & msg)
+  const Params & params, geometry_msgs::msg::Wrench & wrench)
+{
+  wrench.force.x *= params.multiplier.force.x;
+  wrench.force.y *= params.multiplier.force.y;
+  wrench.force.z *= params.multiplier.force.z;
+  wrench.torque.x *= params.multiplier.torque.x;
+  wrench.torque.y *= params.multiplier.torque.y;
+  wrench.torque.z *= params.multiplier.torque.z;
+}
+
+void ForceTorqueSensorBroadcaster::apply_temperature_compensation(
+  geometry_msgs::msg::Wrench & wrench)
+{
+  if (temperature_coefficients_.empty())
+  {
+    return;
+  }
+  for (size_t j = 0; j < temperature_interface_indices_.size(); ++j)
+  {
+    temperature_inputs_[j + 1] = state_interfaces_[temperature_interface_indices_[j]].get_value();
+  }
+
+  std::array<double, 6> drift;
+  const size_t columns = temperature_inputs_.size();
+  for (size_t axis = 0; axis < drift.size(); ++axis)
+  {
+    const double * row = temperature_coefficients_.data() + axis * columns;
+    drift[axis] = 0.0;
+    for (size_t j = 0; j < columns; ++j)
+    {
+      drift[axis] += row[j] * temperature_inputs_[j];
+    }
+  }
+  wrench.force.x -= drift[0];
+  wrench.force.y -= drift[1];
+  wrench.force.z -= drift[2];
+  wrench.torque.x -= drift[3];
+  wrench.torque.y -= drift[4];
+  wrench.torque.z -= drift[5];
+}
+
+void ForceTorqueSensorBroadcaster::apply_tare_offset(geometry_msgs::msg::Wrench & wrench)
+{
+  auto state = tare_state_.load();
+  if (state == TareState::REQUESTED)
+  {
+    tare_sum_.fill(0.0);
+    tare_sample_count_ = 0;
+    state = TareState::SAMPLING;
+    tare_state_ = state;
+  }
+  if (state == TareState::SAMPLING)
+  {
+    tare_sum_[0] += wrench.force.x;
+    tare_sum_[1] += wrench.force.y;
+    tare_sum_[2] += wrench.force.z;
+    tare_sum_[3] += wrench.torque.x;
+    tare_sum_[4] += wrench.torque.y;
+    tare_sum_[5] += wrench.torque.z;
+    if (++tare_sample_count_ >= tare_samples_)
+    {
+      // all axes switch to the new offset in the same cycle
+      for (size_t i = 0; i < tare_offset_.size(); ++i)
+      {
+        tare_offset_[i] = -tare_sum_[i] / static_cast<double>(tare_sample_count_);
+      }
+      tare_state_ = TareState::IDLE;
+    }
+  }
+
+  wrench.force.x += tare_offset_[0];
+  wrench.force.y += tare_offset_[1];
+  wrench.force.z += tare_offset_[2];
+  wrench.torque.x += tare_offset_[3];
+  wrench.torque.y += tare_offset_[4];
+  wrench.torque.z += tare_offset_[5];
+}
+
+void ForceTorqueSensorBroadcaster::tare(
+  const std::shared_ptr<std_srvs::srv::Trigger::Request> /*request*/,
+  std::shared_ptr<std_srvs::srv::Trigger::Response> response)
 {
-  msg.wrench.force.x *= params.multiplier.force.x;
-  msg.wrench.force.y *= params.multiplier.force.y;
-  msg.wrench.force.z *= params.multiplier.force.z;
-  msg.wrench.torque.x *= params.multiplier.torque.x;
-  msg.wrench.torque.y *= params.multiplier.torque.y;
-  msg.wrench.torque.z *= params.multiplier.torque.z;
+  auto idle = TareState::IDLE;
+  if (!tare_state_.compare_exchange_strong(idle, TareState::REQUESTED))
+  {
+    response->success = false;
+    response->message = "A tare is already in progress.";
+    return;
+  }
+  response->success = true;
+  response->message =
+    "Taring over the next " + std::to_string(tare_samples_) + " update cycles.";
 }
 }  // namespace force_torque_sensor_broadcaster
 
@@ -50,10 +50,10 @@ void ForceTorqueSensorBroadcasterTest::SetUp()
 
 void ForceTorqueSensorBroadcasterTest::TearDown() { fts_broadcaster_.reset(nullptr); }
 
-void ForceTorqueSensorBroadcasterTest::SetUpFTSBroadcaster()
+void ForceTorqueSensorBroadcasterTest::SetUpFTSBroadcaster(const std::string & controller_name)
 {
   const auto result = fts_broadcaster_->init(
-    "test_force_torque_sensor_broadcaster", "", 0, "",
+    controller_name, "", 0, "",
     fts_broadcaster_->define_custom_node_options());
   ASSERT_EQ(result, controller_interface::return_type::OK);
 
@@ -241,6 +241,37 @@ TEST_F(ForceTorqueSensorBroadcasterTest, SensorName_Update_Success)
     controller_interface::return_type::OK);
 }
 
+TEST_F(ForceTorqueSensorBroadcasterTest, SensorName_ExportedStateUpdatedWhilePublisherLocked)
+{
+  SetUpFTSBroadcaster();
+
+  // set the params 'sensor_name' and 'frame_id'
+  fts_broadcaster_->get_node()->set_parameter({"sensor_name", sensor_name_});
+  fts_broadcaster_->get_node()->set_parameter({"frame_id", frame_id_});
+  fts_broadcaster_->get_node()->set_parameter({"offset.force.x", 1.0});
+
+  ASSERT_EQ(fts_broadcaster_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(fts_broadcaster_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  const auto exported_state_interfaces = fts_broadcaster_->export_state_interfaces();
+  ASSERT_EQ(exported_state_interfaces.size(), 6u);
+
+  // simulate the publisher thread holding the message
+  fts_broadcaster_->realtime_publisher_->lock();
+  sensor_values_[0] = 10.0;
+  ASSERT_EQ(
+    fts_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+
+  // chained consumers see the new value, the locked message is left untouched
+  EXPECT_EQ(exported_state_interfaces[0]->get_value(), 11.0);
+  for (size_t i = 1; i < 6; ++i)
+  {
+    EXPECT_EQ(exported_state_interfaces[i]->get_value(), sensor_values_[i]);
+  }
+  EXPECT_NE(fts_broadcaster_->realtime_publisher_->msg_.wrench.force.x, 11.0);
+  fts_broadcaster_->realtime_publisher_->unlock();
+}
+
 TEST_F(ForceTorqueSensorBroadcasterTest, InterfaceNames_Success)
 {
   SetUpFTSBroadcaster();
@@ -499,6 +530,68 @@ TEST_F(ForceTorqueSensorBroadcasterTest, All_InterfaceNames_Publish_Success)
   }
 }
 
+TEST_F(ForceTorqueSensorBroadcasterTest, SensorName_TemperatureCompensation_WrongCoefficients)
+{
+  SetUpFTSBroadcaster("test_force_torque_sensor_broadcaster_wrong_coefficients");
+  fts_broadcaster_->get_node()->set_parameter({"sensor_name", sensor_name_});
+
+  ASSERT_EQ(fts_broadcaster_->on_configure(rclcpp_lifecycle::State()), NODE_ERROR);
+}
+
+TEST_F(ForceTorqueSensorBroadcasterTest, SensorName_TemperatureCompensation_And_Tare)
+{
+  SetUpFTSBroadcaster("test_force_torque_sensor_broadcaster_compensated");
+  fts_broadcaster_->get_node()->set_parameter({"sensor_name", sensor_name_});
+
+  ASSERT_EQ(fts_broadcaster_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  const auto state_if_conf = fts_broadcaster_->state_interface_configuration();
+  ASSERT_THAT(state_if_conf.names, SizeIs(7lu));
+  ASSERT_EQ(state_if_conf.names[6], sensor_name_ + "/temperature");
+
+  std::vector<LoanedStateInterface> state_ifs;
+  state_ifs.emplace_back(fts_force_x_);
+  state_ifs.emplace_back(fts_force_y_);
+  state_ifs.emplace_back(fts_force_z_);
+  state_ifs.emplace_back(fts_torque_x_);
+  state_ifs.emplace_back(fts_torque_y_);
+  state_ifs.emplace_back(fts_torque_z_);
+  state_ifs.emplace_back(fts_temperature_);
+  fts_broadcaster_->assign_interfaces({}, std::move(state_ifs));
+  ASSERT_EQ(fts_broadcaster_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  const auto exported_state_interfaces = fts_broadcaster_->export_state_interfaces();
+  ASSERT_EQ(exported_state_interfaces.size(), 6u);
+
+  // force.x drifts by 1.0 + 0.1 * T, torque.z by -0.2 * T
+  const std::array<double, 6> drift = {{1.0 + 0.1 * temperature_, 0.0, 0.0, 0.0, 0.0,
+                                        -0.2 * temperature_}};
+  fts_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01));
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_DOUBLE_EQ(exported_state_interfaces[i]->get_value(), sensor_values_[i] - drift[i]);
+  }
+
+  auto request = std::make_shared<std_srvs::srv::Trigger::Request>();
+  auto response = std::make_shared<std_srvs::srv::Trigger::Response>();
+  fts_broadcaster_->tare(request, response);
+  EXPECT_TRUE(response->success);
+  fts_broadcaster_->tare(request, response);
+  EXPECT_FALSE(response->success);
+
+  // the offset only changes once all samples are taken
+  fts_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01));
+  EXPECT_DOUBLE_EQ(exported_state_interfaces[0]->get_value(), sensor_values_[0] - drift[0]);
+  sensor_values_[0] += 2.0;
+  fts_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01));
+  EXPECT_DOUBLE_EQ(exported_state_interfaces[0]->get_value(), 1.0);
+  for (size_t i = 1; i < 6; ++i)
+  {
+    EXPECT_NEAR(exported_state_interfaces[i]->get_value(), 0.0, 1e-12);
+  }
+
+  fts_broadcaster_->tare(request, response);
+  EXPECT_TRUE(response->success);
+}
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleMock(&argc, argv);
@@ -39,6 +39,9 @@ class FriendForceTorqueSensorBroadcaster
   FRIEND_TEST(ForceTorqueSensorBroadcasterTest, SensorName_ActivateDeactivate_Success);
   FRIEND_TEST(ForceTorqueSensorBroadcasterTest, UpdateTest);
   FRIEND_TEST(ForceTorqueSensorBroadcasterTest, SensorStatePublishTest);
+  FRIEND_TEST(
+    ForceTorqueSensorBroadcasterTest, SensorName_ExportedStateUpdatedWhilePublisherLocked);
+  FRIEND_TEST(ForceTorqueSensorBroadcasterTest, SensorName_TemperatureCompensation_And_Tare);
 };
 
 class ForceTorqueSensorBroadcasterTest : public ::testing::Test
@@ -50,7 +53,8 @@ public:
   void SetUp();
   void TearDown();
 
-  void SetUpFTSBroadcaster();
+  void SetUpFTSBroadcaster(
+    const std::string & controller_name = "test_force_torque_sensor_broadcaster");
 
 protected:
   const std::string sensor_name_ = "fts_sensor";
@@ -63,6 +67,8 @@ protected:
   hardware_interface::StateInterface fts_torque_x_{sensor_name_, "torque.x", &sensor_values_[3]};
   hardware_interface::StateInterface fts_torque_y_{sensor_name_, "torque.y", &sensor_values_[4]};
   hardware_interface::StateInterface fts_torque_z_{sensor_name_, "torque.z", &sensor_values_[5]};
+  double temperature_ = 30.0;
+  hardware_interface::StateInterface fts_temperature_{sensor_name_, "temperature", &temperature_};
 
   std::unique_ptr<FriendForceTorqueSensorBroadcaster> fts_broadcaster_;
 
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "controller_interface/controller_interface.hpp"
+#include "hardware_interface/loaned_command_interface.hpp"
 #include "rclcpp/subscription.hpp"
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_buffer.hpp"
@@ -86,6 +87,20 @@ protected:
 
   std::vector<std::string> command_interface_types_;
 
+  /// Writes the commands to the command interfaces, sizes are checked by the caller
+  using ForwardCommandsFn = void (*)(
+    const std::vector<double> & commands,
+    std::vector<hardware_interface::LoanedCommandInterface> & command_interfaces);
+
+  /**
+   * Select the function forwarding the commands for the given number of interfaces. For common
+   * group sizes a version with a compile-time size is returned, so the copy loop is fully
+   * unrolled. For all other sizes the loop over the dynamic size is used.
+   */
+  static ForwardCommandsFn select_forward_commands(size_t n_interfaces);
+
+  ForwardCommandsFn forward_commands_;
+
   realtime_tools::RealtimeBuffer<std::shared_ptr<CmdType>> rt_command_ptr_;
   rclcpp::Subscription<CmdType>::SharedPtr joints_command_subscriber_;
 };
@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "controller_interface/helpers.hpp"
@@ -23,10 +24,57 @@
 #include "rclcpp/logging.hpp"
 #include "rclcpp/qos.hpp"
 
+namespace
+{
+using forward_command_controller::ForwardControllersBase;
+using hardware_interface::LoanedCommandInterface;
+
+template <size_t N>
+void forward_commands_fixed_size(
+  const std::vector<double> & commands, std::vector<LoanedCommandInterface> & command_interfaces)
+{
+  for (size_t index = 0; index < N; ++index)
+  {
+    command_interfaces[index].set_value(commands[index]);
+  }
+}
+
+void forward_commands_dynamic_size(
+  const std::vector<double> & commands, std::vector<LoanedCommandInterface> & command_interfaces)
+{
+  for (auto index = 0ul; index < command_interfaces.size(); ++index)
+  {
+    command_interfaces[index].set_value(commands[index]);
+  }
+}
+
+template <size_t... Sizes>
+auto select_forward_commands_impl(size_t n_interfaces, std::index_sequence<Sizes...>)
+{
+  auto forward_commands = &forward_commands_dynamic_size;
+  static_cast<void>(
+    ((n_interfaces == Sizes + 1 ? (forward_commands = &forward_commands_fixed_size<Sizes + 1>, true)
+                                : false) ||
+     ...));
+  return forward_commands;
+}
+
+// Group sizes up to 8 (grippers, arms with 6/7 joints, ...) get an unrolled loop
+constexpr size_t kMaxFixedGroupSize = 8;
+}  // namespace
+
 namespace forward_command_controller
 {
+ForwardControllersBase::ForwardCommandsFn ForwardControllersBase::select_forward_commands(
+  size_t n_interfaces)
+{
+  return select_forward_commands_impl(
+    n_interfaces, std::make_index_sequence<kMaxFixedGroupSize>{});
+}
+
 ForwardControllersBase::ForwardControllersBase()
 : controller_interface::ControllerInterface(),
+  forward_commands_(&forward_commands_dynamic_size),
   rt_command_ptr_(nullptr),
   joints_command_subscriber_(nullptr)
 {
@@ -56,6 +104,8 @@ controller_interface::CallbackReturn ForwardControllersBase::on_configure(
     return ret;
   }
 
+  forward_commands_ = select_forward_commands(command_interface_types_.size());
+
   joints_command_subscriber_ = get_node()->create_subscription<CmdType>(
     "~/commands", rclcpp::SystemDefaultsQoS(),
     [this](const CmdType::SharedPtr msg) { rt_command_ptr_.writeFromNonRT(msg); });
@@ -135,10 +185,7 @@ controller_interface::return_type ForwardControllersBase::update(
     return controller_interface::return_type::ERROR;
   }
 
-  for (auto index = 0ul; index < command_interfaces_.size(); ++index)
-  {
-    command_interfaces_[index].set_value((*joint_commands)->data[index]);
-  }
+  forward_commands_((*joint_commands)->data, command_interfaces_);
 
   return controller_interface::return_type::OK;
 }
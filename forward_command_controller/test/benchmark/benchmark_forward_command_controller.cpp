@@ -0,0 +1,120 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "forward_command_controller/forward_command_controller.hpp"
+#include "hardware_interface/handle.hpp"
+#include "hardware_interface/loaned_command_interface.hpp"
+#include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+namespace
+{
+class BenchmarkForwardCommandController
+: public forward_command_controller::ForwardCommandController
+{
+public:
+  void set_command(const std::shared_ptr<forward_command_controller::CmdType> & command)
+  {
+    rt_command_ptr_.writeFromNonRT(command);
+  }
+};
+
+// Updates an active controller with a command for the given number of joints. The joint group
+// position, velocity and effort controllers share this update and only differ by the interface
+// name, so each of them is covered by one instance of this benchmark.
+void BM_ForwardCommandControllerUpdate(benchmark::State & state, const std::string & interface_name)
+{
+  if (!rclcpp::ok())
+  {
+    rclcpp::init(0, nullptr);
+  }
+  const auto n_joints = static_cast<size_t>(state.range(0));
+
+  std::vector<std::string> joint_names;
+  std::vector<double> joint_commands(n_joints, 0.0);
+  std::vector<hardware_interface::CommandInterface> command_interfaces;
+  command_interfaces.reserve(n_joints);
+  for (size_t i = 0; i < n_joints; ++i)
+  {
+    joint_names.push_back("joint" + std::to_string(i));
+    command_interfaces.emplace_back(
+      joint_names.back(), interface_name, &joint_commands[i]);
+  }
+
+  auto controller = std::make_unique<BenchmarkForwardCommandController>();
+  if (
+    controller->init(
+      "benchmark_forward_command_controller", "", 0, "",
+      controller->define_custom_node_options()) != controller_interface::return_type::OK)
+  {
+    state.SkipWithError("init failed");
+    return;
+  }
+  controller->get_node()->set_parameter({"joints", joint_names});
+  controller->get_node()->set_parameter({"interface_name", interface_name});
+  std::vector<hardware_interface::LoanedCommandInterface> loaned_command_interfaces;
+  for (auto & command_interface : command_interfaces)
+  {
+    loaned_command_interfaces.emplace_back(command_interface);
+  }
+  controller->assign_interfaces(std::move(loaned_command_interfaces), {});
+  if (
+    controller->on_configure(rclcpp_lifecycle::State()) !=
+      controller_interface::CallbackReturn::SUCCESS ||
+    controller->on_activate(rclcpp_lifecycle::State()) !=
+      controller_interface::CallbackReturn::SUCCESS)
+  {
+    state.SkipWithError("configure or activate failed");
+    return;
+  }
+
+  auto command = std::make_shared<forward_command_controller::CmdType>();
+  command->data.assign(n_joints, 1.0);
+  controller->set_command(command);
+
+  const rclcpp::Time time(0, 0, RCL_ROS_TIME);
+  const rclcpp::Duration period = rclcpp::Duration::from_seconds(0.001);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(controller->update(time, period));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n_joints));
+}
+
+}  // namespace
+
+// 6 and 7 use the unrolled loops, 12 falls back to the dynamic one
+BENCHMARK_CAPTURE(BM_ForwardCommandControllerUpdate, position, hardware_interface::HW_IF_POSITION)
+  ->Arg(1)
+  ->Arg(6)
+  ->Arg(7)
+  ->Arg(12);
+BENCHMARK_CAPTURE(BM_ForwardCommandControllerUpdate, velocity, hardware_interface::HW_IF_VELOCITY)
+  ->Arg(1)
+  ->Arg(6)
+  ->Arg(7)
+  ->Arg(12);
+BENCHMARK_CAPTURE(BM_ForwardCommandControllerUpdate, effort, hardware_interface::HW_IF_EFFORT)
+  ->Arg(1)
+  ->Arg(6)
+  ->Arg(7)
+  ->Arg(12);
@@ -232,6 +232,20 @@ TEST_F(ForwardCommandControllerTest, CommandSuccessTest)
   ASSERT_EQ(joint_3_pos_cmd_.get_value(), 30.0);
 }
 
+TEST_F(ForwardCommandControllerTest, ForwardCommandsSizeSelection)
+{
+  using forward_command_controller::ForwardControllersBase;
+  // common group sizes get their own unrolled loop, all others share the dynamic one
+  const auto dynamic = ForwardControllersBase::select_forward_commands(0);
+  EXPECT_EQ(ForwardControllersBase::select_forward_commands(42), dynamic);
+  EXPECT_NE(ForwardControllersBase::select_forward_commands(3), dynamic);
+  EXPECT_NE(ForwardControllersBase::select_forward_commands(6), dynamic);
+  EXPECT_NE(ForwardControllersBase::select_forward_commands(7), dynamic);
+  EXPECT_NE(
+    ForwardControllersBase::select_forward_commands(6),
+    ForwardControllersBase::select_forward_commands(7));
+}
+
 TEST_F(ForwardCommandControllerTest, WrongCommandCheckTest)
 {
   SetUpController();
@@ -46,6 +46,7 @@ class FriendForwardCommandController : public forward_command_controller::Forwar
   FRIEND_TEST(ForwardCommandControllerTest, NoCommandCheckTest);
   FRIEND_TEST(ForwardCommandControllerTest, CommandCallbackTest);
   FRIEND_TEST(ForwardCommandControllerTest, ActivateDeactivateCommandsResetSuccess);
+  FRIEND_TEST(ForwardCommandControllerTest, ForwardCommandsSizeSelection);
 };
 
 class ForwardCommandControllerTest : public ::testing::Test
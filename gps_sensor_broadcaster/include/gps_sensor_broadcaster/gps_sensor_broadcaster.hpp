@@ -19,7 +19,10 @@
 #ifndef GPS_SENSOR_BROADCASTER__GPS_SENSOR_BROADCASTER_HPP_
 #define GPS_SENSOR_BROADCASTER__GPS_SENSOR_BROADCASTER_HPP_
 
+#include <array>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <variant>
 #include <vector>
@@ -29,6 +32,7 @@
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
 #include "semantic_components/gps_sensor.hpp"
+#include "sensor_broadcasters_common/publish_policy.hpp"
 #include "sensor_msgs/msg/nav_sat_fix.hpp"
 
 namespace gps_sensor_broadcaster
@@ -55,6 +59,8 @@ protected:
 
   void setup_covariance();
   callback_return_type setup_publisher();
+  /// Compare the current reading with the one of the previous update, true if it is a new fix.
+  bool fix_changed();
 
   GPSSensorVariant gps_sensor_;
   rclcpp::Publisher<sensor_msgs::msg::NavSatFix>::SharedPtr sensor_state_publisher_;
@@ -62,6 +68,20 @@ protected:
   std::shared_ptr<gps_sensor_broadcaster::ParamListener> param_listener_{};
   gps_sensor_broadcaster::Params params_;
   std::vector<std::string> state_names_;
+
+  // Latest fix and the publish policy reducing latitude, longitude and altitude between two
+  // publications
+  sensor_msgs::msg::NavSatFix gps_state_;
+  std::array<double, 3> gps_sample_;
+  sensor_broadcasters_common::PublishPolicy publish_policy_;
+
+  // New fix detection for publish_on_change
+  std::optional<size_t> fix_change_interface_index_;
+  double last_fix_marker_ = std::numeric_limits<double>::quiet_NaN();
+  std::array<double, 5> last_fix_;
+  bool fix_pending_ = false;
+  double min_publish_period_ = 0.0;
+  double last_publish_seconds_ = -std::numeric_limits<double>::infinity();
 };
 
 }  // namespace gps_sensor_broadcaster
@@ -17,7 +17,10 @@
  */
 
 #include "gps_sensor_broadcaster/gps_sensor_broadcaster.hpp"
+#include <cstring>
+#include <limits>
 #include <map>
+#include <stdexcept>
 
 namespace
 {
@@ -67,6 +70,31 @@ callback_return_type GPSSensorBroadcaster::on_configure(const rclcpp_lifecycle::
       [this](auto & sensor) { state_names_ = sensor.get_state_interface_names(); },
       [](std::monostate &) {}},
     gps_sensor_);
+  if (params_.publish_on_change && !params_.fix_change_interface.empty())
+  {
+    state_names_.push_back(params_.fix_change_interface);
+  }
+
+  try
+  {
+    if (params_.publish_on_change)
+    {
+      // every fix is published as it is, the rate only limits how often
+      publish_policy_.configure(gps_sample_.size(), 1);
+      min_publish_period_ =
+        params_.publish_policy.rate > 0.0 ? 1.0 / params_.publish_policy.rate : 0.0;
+    }
+    else
+    {
+      publish_policy_.configure_from_params(
+        gps_sample_.size(), static_cast<double>(get_update_rate()), params_.publish_policy);
+    }
+  }
+  catch (const std::invalid_argument & e)
+  {
+    RCLCPP_ERROR(get_node()->get_logger(), "Invalid publish policy: %s", e.what());
+    return callback_return_type::ERROR;
+  }
 
   return setup_publisher();
 }
@@ -134,6 +162,31 @@ callback_return_type GPSSensorBroadcaster::on_activate(const rclcpp_lifecycle::S
       [this](auto & sensor) { sensor.assign_loaned_state_interfaces(state_interfaces_); },
       [](std::monostate &) {}},
     gps_sensor_);
+  publish_policy_.reset();
+
+  fix_change_interface_index_.reset();
+  if (params_.publish_on_change && !params_.fix_change_interface.empty())
+  {
+    for (size_t i = 0; i < state_interfaces_.size(); ++i)
+    {
+      if (state_interfaces_[i].get_name() == params_.fix_change_interface)
+      {
+        fix_change_interface_index_ = i;
+      }
+    }
+    if (!fix_change_interface_index_)
+    {
+      RCLCPP_ERROR(
+        get_node()->get_logger(), "State interface '%s' for the fix detection is not available.",
+        params_.fix_change_interface.c_str());
+      return callback_return_type::ERROR;
+    }
+  }
+  // publish the current fix right away
+  last_fix_marker_ = std::numeric_limits<double>::quiet_NaN();
+  last_fix_.fill(std::numeric_limits<double>::quiet_NaN());
+  fix_pending_ = true;
+  last_publish_seconds_ = -std::numeric_limits<double>::infinity();
   return callback_return_type::SUCCESS;
 }
 
@@ -145,22 +198,63 @@ callback_return_type GPSSensorBroadcaster::on_deactivate(const rclcpp_lifecycle:
   return callback_return_type::SUCCESS;
 }
 
+bool GPSSensorBroadcaster::fix_changed()
+{
+  if (fix_change_interface_index_)
+  {
+    const double marker = state_interfaces_[*fix_change_interface_index_].get_value();
+    // compare the bits, a NaN reading is no new fix as long as it stays NaN
+    const bool changed = std::memcmp(&marker, &last_fix_marker_, sizeof(marker)) != 0;
+    last_fix_marker_ = marker;
+    return changed;
+  }
+
+  const std::array<double, 5> fix = {
+    {static_cast<double>(gps_state_.status.status), static_cast<double>(gps_state_.status.service),
+     gps_state_.latitude, gps_state_.longitude, gps_state_.altitude}};
+  const bool changed = std::memcmp(fix.data(), last_fix_.data(), sizeof(fix)) != 0;
+  last_fix_ = fix;
+  return changed;
+}
+
 controller_interface::return_type GPSSensorBroadcaster::update(
-  const rclcpp::Time &, const rclcpp::Duration &)
+  const rclcpp::Time & time, const rclcpp::Duration &)
 {
+  std::visit(
+    Visitor{
+      [this](auto & sensor) { sensor.get_values_as_message(gps_state_); },
+      [](std::monostate &) {}},
+    gps_sensor_);
+  gps_sample_ = {{gps_state_.latitude, gps_state_.longitude, gps_state_.altitude}};
+  bool publish = publish_policy_.add_sample(gps_sample_);
+  if (params_.publish_on_change)
+  {
+    // a fix that can not be published yet is kept pending until the rate limit allows it
+    fix_pending_ = fix_changed() || fix_pending_;
+    publish = fix_pending_ && time.seconds() - last_publish_seconds_ >= min_publish_period_;
+  }
+  if (!publish)
+  {
+    return controller_interface::return_type::OK;
+  }
+
   if (realtime_publisher_ && realtime_publisher_->trylock())
   {
-    realtime_publisher_->msg_.header.stamp = get_node()->now();
-    std::visit(
-      Visitor{
-        [this](auto & sensor)
-        {
-          sensor_msgs::msg::NavSatFix message;
-          sensor.get_values_as_message(realtime_publisher_->msg_);
-        },
-        [](std::monostate &) {}},
-      gps_sensor_);
+    const auto & sample = publish_policy_.output();
+    auto & msg = realtime_publisher_->msg_;
+    msg.header.stamp = time;
+    msg.status = gps_state_.status;
+    msg.latitude = sample[0];
+    msg.longitude = sample[1];
+    msg.altitude = sample[2];
+    if (params_.read_covariance_from_interface)
+    {
+      msg.position_covariance = gps_state_.position_covariance;
+    }
     realtime_publisher_->unlockAndPublish();
+
+    fix_pending_ = false;
+    last_publish_seconds_ = time.seconds();
   }
   return controller_interface::return_type::OK;
 }
@@ -16,6 +16,8 @@
  * Authors: Wiktor Bajor, Jakub Delicat
  */
 
+#include <cmath>
+#include <limits>
 #include <utility>
 
 #include <rclcpp/node.hpp>
@@ -246,3 +248,156 @@ TEST_F(
   ASSERT_THAT(gps_msg.position_covariance, ::testing::ElementsAreArray(expected_covariance));
   ASSERT_THAT(gps_msg.position_covariance_type, COVARIANCE_TYPE_DIAGONAL_KNOWN);
 }
+
+TEST_F(
+  GPSSensorBroadcasterTest, whenPublishOnChangeIsSetThenOnlyNewFixesShouldBePublishedRateLimited)
+{
+  const auto node_options = create_node_options_with_overriden_parameters(
+    {sensor_name_param_, frame_id_, {"publish_on_change", true}, {"publish_policy.rate", 1.0}});
+  const auto result = gps_broadcaster_->init(
+    "test_gps_sensor_broadcaster", ros2_control_test_assets::minimal_robot_urdf, 0, "",
+    node_options);
+  ASSERT_EQ(result, controller_interface::return_type::OK);
+  ASSERT_EQ(
+    gps_broadcaster_->on_configure(rclcpp_lifecycle::State()), callback_return_type::SUCCESS);
+  setup_gps_broadcaster();
+  ASSERT_EQ(
+    gps_broadcaster_->on_activate(rclcpp_lifecycle::State()), callback_return_type::SUCCESS);
+
+  rclcpp::Node test_subscription_node("test_subscription_node");
+  auto subscription = test_subscription_node.create_subscription<sensor_msgs::msg::NavSatFix>(
+    "/test_gps_sensor_broadcaster/gps/fix", 10,
+    [](const sensor_msgs::msg::NavSatFix::SharedPtr) {});
+  rclcpp::MessageInfo msg_info;
+  sensor_msgs::msg::NavSatFix gps_msg;
+  const auto no_message_within = [&subscription](std::chrono::milliseconds timeout)
+  {
+    rclcpp::WaitSet wait_set;
+    wait_set.add_subscription(subscription);
+    return wait_set.wait(timeout).kind() == rclcpp::WaitResultKind::Timeout;
+  };
+
+  // the current fix is published on activation, stamped with the control time
+  gps_broadcaster_->update(rclcpp::Time(0, 0), rclcpp::Duration::from_seconds(0.5));
+  wait_for(subscription);
+  ASSERT_TRUE(subscription->take(gps_msg, msg_info));
+  EXPECT_EQ(gps_msg.latitude, sensor_values_[2]);
+  EXPECT_EQ(rclcpp::Time(gps_msg.header.stamp).nanoseconds(), 0);
+
+  // a new fix within the rate limit is kept back
+  sensor_values_[2] = 5.0;
+  gps_broadcaster_->update(rclcpp::Time(0, 500000000), rclcpp::Duration::from_seconds(0.5));
+  EXPECT_TRUE(no_message_within(std::chrono::milliseconds(50)));
+
+  // and published once allowed, although it did not change since
+  gps_broadcaster_->update(rclcpp::Time(1, 0), rclcpp::Duration::from_seconds(0.5));
+  wait_for(subscription);
+  ASSERT_TRUE(subscription->take(gps_msg, msg_info));
+  EXPECT_EQ(gps_msg.latitude, 5.0);
+  EXPECT_EQ(rclcpp::Time(gps_msg.header.stamp).nanoseconds(), 1000000000);
+
+  // no new fix, nothing to publish
+  gps_broadcaster_->update(rclcpp::Time(2, 0), rclcpp::Duration::from_seconds(0.5));
+  EXPECT_TRUE(no_message_within(std::chrono::milliseconds(50)));
+}
+
+TEST_F(GPSSensorBroadcasterTest, whenPublishOnChangeIsSetThenAnUnchangedNaNFixShouldNotBePublished)
+{
+  // e.g. a receiver without altitude reports NaN
+  sensor_values_[4] = std::numeric_limits<double>::quiet_NaN();
+  const auto node_options = create_node_options_with_overriden_parameters(
+    {sensor_name_param_, frame_id_, {"publish_on_change", true}});
+  const auto result = gps_broadcaster_->init(
+    "test_gps_sensor_broadcaster", ros2_control_test_assets::minimal_robot_urdf, 0, "",
+    node_options);
+  ASSERT_EQ(result, controller_interface::return_type::OK);
+  ASSERT_EQ(
+    gps_broadcaster_->on_configure(rclcpp_lifecycle::State()), callback_return_type::SUCCESS);
+  setup_gps_broadcaster();
+  ASSERT_EQ(
+    gps_broadcaster_->on_activate(rclcpp_lifecycle::State()), callback_return_type::SUCCESS);
+
+  rclcpp::Node test_subscription_node("test_subscription_node");
+  auto subscription = test_subscription_node.create_subscription<sensor_msgs::msg::NavSatFix>(
+    "/test_gps_sensor_broadcaster/gps/fix", 10,
+    [](const sensor_msgs::msg::NavSatFix::SharedPtr) {});
+  rclcpp::MessageInfo msg_info;
+  sensor_msgs::msg::NavSatFix gps_msg;
+  const auto no_message_within = [&subscription](std::chrono::milliseconds timeout)
+  {
+    rclcpp::WaitSet wait_set;
+    wait_set.add_subscription(subscription);
+    return wait_set.wait(timeout).kind() == rclcpp::WaitResultKind::Timeout;
+  };
+
+  gps_broadcaster_->update(rclcpp::Time(0, 0), rclcpp::Duration::from_seconds(0.1));
+  wait_for(subscription);
+  ASSERT_TRUE(subscription->take(gps_msg, msg_info));
+  EXPECT_TRUE(std::isnan(gps_msg.altitude));
+
+  // the same fix with a NaN altitude is no new fix
+  gps_broadcaster_->update(rclcpp::Time(0, 100000000), rclcpp::Duration::from_seconds(0.1));
+  EXPECT_TRUE(no_message_within(std::chrono::milliseconds(50)));
+
+  sensor_values_[2] = 5.0;
+  gps_broadcaster_->update(rclcpp::Time(0, 200000000), rclcpp::Duration::from_seconds(0.1));
+  wait_for(subscription);
+  ASSERT_TRUE(subscription->take(gps_msg, msg_info));
+  EXPECT_EQ(gps_msg.latitude, 5.0);
+}
+
+TEST_F(GPSSensorBroadcasterTest, whenFixChangeInterfaceIsSetThenItShouldTriggerThePublication)
+{
+  double time_of_week = 100.0;
+  hardware_interface::StateInterface time_of_week_itf{sensor_name_, "time_of_week", &time_of_week};
+  const auto node_options = create_node_options_with_overriden_parameters(
+    {sensor_name_param_,
+     frame_id_,
+     {"publish_on_change", true},
+     {"fix_change_interface", sensor_name_ + "/time_of_week"}});
+  const auto result = gps_broadcaster_->init(
+    "test_gps_sensor_broadcaster", ros2_control_test_assets::minimal_robot_urdf, 0, "",
+    node_options);
+  ASSERT_EQ(result, controller_interface::return_type::OK);
+  ASSERT_EQ(
+    gps_broadcaster_->on_configure(rclcpp_lifecycle::State()), callback_return_type::SUCCESS);
+  ASSERT_THAT(
+    gps_broadcaster_->state_interface_configuration().names,
+    ::testing::Contains(sensor_name_ + "/time_of_week"));
+
+  std::vector<LoanedStateInterface> state_ifs;
+  state_ifs.emplace_back(gps_status_);
+  state_ifs.emplace_back(gps_service_);
+  state_ifs.emplace_back(gps_latitude_);
+  state_ifs.emplace_back(gps_longitude_);
+  state_ifs.emplace_back(gps_altitude_);
+  state_ifs.emplace_back(time_of_week_itf);
+  gps_broadcaster_->assign_interfaces({}, std::move(state_ifs));
+  ASSERT_EQ(
+    gps_broadcaster_->on_activate(rclcpp_lifecycle::State()), callback_return_type::SUCCESS);
+
+  rclcpp::Node test_subscription_node("test_subscription_node");
+  auto subscription = test_subscription_node.create_subscription<sensor_msgs::msg::NavSatFix>(
+    "/test_gps_sensor_broadcaster/gps/fix", 10,
+    [](const sensor_msgs::msg::NavSatFix::SharedPtr) {});
+  rclcpp::MessageInfo msg_info;
+  sensor_msgs::msg::NavSatFix gps_msg;
+
+  gps_broadcaster_->update(rclcpp::Time(0, 0), rclcpp::Duration::from_seconds(0.1));
+  wait_for(subscription);
+  ASSERT_TRUE(subscription->take(gps_msg, msg_info));
+
+  // the same position with a new time of week is a new fix, a new position without is not
+  time_of_week = 101.0;
+  gps_broadcaster_->update(rclcpp::Time(1, 0), rclcpp::Duration::from_seconds(0.1));
+  wait_for(subscription);
+  ASSERT_TRUE(subscription->take(gps_msg, msg_info));
+  EXPECT_EQ(rclcpp::Time(gps_msg.header.stamp).nanoseconds(), 1000000000);
+
+  sensor_values_[2] = 5.0;
+  gps_broadcaster_->update(rclcpp::Time(2, 0), rclcpp::Duration::from_seconds(0.1));
+  rclcpp::WaitSet wait_set;
+  wait_set.add_subscription(subscription);
+  EXPECT_EQ(
+    wait_set.wait(std::chrono::milliseconds(50)).kind(), rclcpp::WaitResultKind::Timeout);
+}
@@ -0,0 +1,86 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMU_SENSOR_BROADCASTER__IMU_FILTER_HPP_
+#define IMU_SENSOR_BROADCASTER__IMU_FILTER_HPP_
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace imu_sensor_broadcaster
+{
+enum class FilterType : uint8_t
+{
+  NONE,           ///< pass the readings through
+  LOW_PASS,       ///< first order low-pass of all readings
+  COMPLEMENTARY,  ///< orientation propagated with the angular velocity, corrected by the reading
+};
+
+/**
+ * \brief Filter for the IMU readings exported to chained controllers.
+ *
+ * A sample holds the orientation (x, y, z, w), the angular velocity and the linear acceleration.
+ * The angular velocity and the linear acceleration are low-pass filtered with the given cutoff
+ * frequency for both filter types. The low-pass filter blends the orientation towards the reading
+ * the same way, normalized again. The complementary filter first rotates the filtered orientation
+ * by the measured angular velocity and then blends it towards the reading, so it follows fast
+ * motions without lag and only smooths the noise of the orientation reading.
+ *
+ * The filter holds no dynamic memory, all functions are safe to use from the RT loop.
+ */
+class ImuFilter
+{
+public:
+  using Sample = std::array<double, 10>;
+
+  /**
+   * \brief Parse the filter type from its parameter value
+   * \param [in] name One of "none", "low_pass", "complementary"
+   * \throws std::invalid_argument for unknown names
+   */
+  static FilterType type_from_string(const std::string & name);
+
+  /**
+   * \brief Set the filter type and reset the filter
+   * \param [in] type Filter type
+   * \param [in] cutoff_frequency Cutoff frequency [Hz], must be > 0 unless type is NONE
+   * \throws std::invalid_argument for an invalid cutoff frequency
+   */
+  void configure(FilterType type, double cutoff_frequency);
+
+  /// Restart from the next sample.
+  void reset() { initialized_ = false; }
+
+  /**
+   * \brief Filter the sample of this update cycle
+   * \param [in] sample Reading of this cycle
+   * \param [in] dt Period since the last sample [s], the output is not changed for dt <= 0
+   * \return Filtered sample
+   */
+  const Sample & update(const Sample & sample, double dt);
+
+  const Sample & output() const { return output_; }
+  FilterType type() const { return type_; }
+
+private:
+  FilterType type_ = FilterType::NONE;
+  double cutoff_frequency_ = 0.0;
+  bool initialized_ = false;
+  Sample output_ = {{0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}};
+};
+
+}  // namespace imu_sensor_broadcaster
+
+#endif  // IMU_SENSOR_BROADCASTER__IMU_FILTER_HPP_
@@ -19,20 +19,26 @@
 #ifndef IMU_SENSOR_BROADCASTER__IMU_SENSOR_BROADCASTER_HPP_
 #define IMU_SENSOR_BROADCASTER__IMU_SENSOR_BROADCASTER_HPP_
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
 #include "semantic_components/imu_sensor.hpp"
+#include "sensor_broadcasters_common/publish_policy.hpp"
 #include "sensor_msgs/msg/imu.hpp"
+#include "std_msgs/msg/float64_multi_array.hpp"
 
-#include "controller_interface/controller_interface.hpp"
+#include "controller_interface/chainable_controller_interface.hpp"
+#include "imu_sensor_broadcaster/imu_filter.hpp"
 // auto-generated by generate_parameter_library
 #include "imu_sensor_broadcaster/imu_sensor_broadcaster_parameters.hpp"
 
 namespace imu_sensor_broadcaster
 {
-class IMUSensorBroadcaster : public controller_interface::ControllerInterface
+class IMUSensorBroadcaster : public controller_interface::ChainableControllerInterface
 {
 public:
   controller_interface::InterfaceConfiguration command_interface_configuration() const override;
@@ -49,10 +55,24 @@ public:
   controller_interface::CallbackReturn on_deactivate(
     const rclcpp_lifecycle::State & previous_state) override;
 
-  controller_interface::return_type update(
+  controller_interface::return_type update_and_write_commands(
     const rclcpp::Time & time, const rclcpp::Duration & period) override;
 
+  controller_interface::return_type update_reference_from_subscribers(
+    const rclcpp::Time & time, const rclcpp::Duration & period) override;
+
+  std::vector<hardware_interface::StateInterface> on_export_state_interfaces() override;
+
 protected:
+  /// Append the current sample to the batch queue, or count it as dropped if the queue is full.
+  void add_batch_sample(const rclcpp::Time & time);
+
+  /// Publish the oldest complete batch if the publisher is free, return true on success.
+  bool publish_batch();
+
+  /// Warn about samples dropped since the last report, runs outside of the realtime loop.
+  void report_dropped_samples();
+
   std::shared_ptr<ParamListener> param_listener_;
   Params params_;
 
@@ -61,6 +81,35 @@ protected:
   using StatePublisher = realtime_tools::RealtimePublisher<sensor_msgs::msg::Imu>;
   rclcpp::Publisher<sensor_msgs::msg::Imu>::SharedPtr sensor_state_publisher_;
   std::unique_ptr<StatePublisher> realtime_publisher_;
+
+  // Latest reading and the publish policy reducing the readings between two publications,
+  // sampled as orientation (x, y, z, w), angular velocity and linear acceleration
+  sensor_msgs::msg::Imu imu_state_;
+  std::array<double, 10> imu_sample_;
+  sensor_broadcasters_common::PublishPolicy publish_policy_;
+
+  // Filtered every cycle for chained controllers, the exported state interfaces point here
+  ImuFilter imu_filter_;
+  std::array<double, 10> imu_exported_;
+
+  // Lossless batches of all samples, see the batch.* parameters
+  using BatchPublisher = realtime_tools::RealtimePublisher<std_msgs::msg::Float64MultiArray>;
+  rclcpp::Publisher<std_msgs::msg::Float64MultiArray>::SharedPtr batch_publisher_;
+  std::unique_ptr<BatchPublisher> realtime_batch_publisher_;
+  // Ring of batch_queue_size_ batches stored back to back, each batch_size_ rows of
+  // BATCH_FIELDS values
+  static constexpr size_t BATCH_FIELDS = 12;
+  size_t batch_size_ = 0;
+  size_t batch_queue_size_ = 0;
+  std::vector<double> batch_queue_;
+  size_t batch_write_index_ = 0;
+  size_t batch_read_index_ = 0;
+  size_t batches_pending_ = 0;
+  size_t batch_samples_ = 0;
+  // Counted in update, reported from dropped_samples_timer_ to keep logging out of the RT loop
+  std::atomic<size_t> dropped_samples_{0};
+  size_t reported_dropped_samples_ = 0;
+  rclcpp::TimerBase::SharedPtr dropped_samples_timer_;
 };
 
 }  // namespace imu_sensor_broadcaster
@@ -0,0 +1,123 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "imu_sensor_broadcaster/imu_filter.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace imu_sensor_broadcaster
+{
+namespace
+{
+constexpr double PI = 3.14159265358979323846;
+
+/// Rotate the quaternion q (x, y, z, w) by the body rates omega over dt.
+void integrate_angular_velocity(double * q, const double * omega, double dt)
+{
+  const double rate = std::sqrt(omega[0] * omega[0] + omega[1] * omega[1] + omega[2] * omega[2]);
+  const double half_angle = 0.5 * rate * dt;
+  // sin(half_angle) / rate, with its limit dt / 2 for small rates
+  const double s = rate > 1e-12 ? std::sin(half_angle) / rate : 0.5 * dt;
+  const double dx = omega[0] * s;
+  const double dy = omega[1] * s;
+  const double dz = omega[2] * s;
+  const double dw = std::cos(half_angle);
+
+  const double x = q[0];
+  const double y = q[1];
+  const double z = q[2];
+  const double w = q[3];
+  q[0] = w * dx + x * dw + y * dz - z * dy;
+  q[1] = w * dy - x * dz + y * dw + z * dx;
+  q[2] = w * dz + x * dy - y * dx + z * dw;
+  q[3] = w * dw - x * dx - y * dy - z * dz;
+}
+
+/// Blend the quaternion q towards the target on the shorter path and normalize it again.
+void blend_orientation(double * q, const double * target, double alpha)
+{
+  const double dot = q[0] * target[0] + q[1] * target[1] + q[2] * target[2] + q[3] * target[3];
+  const double sign = dot < 0.0 ? -1.0 : 1.0;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    q[i] += alpha * (sign * target[i] - q[i]);
+  }
+  const double norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+  if (norm > 0.0)
+  {
+    for (size_t i = 0; i < 4; ++i)
+    {
+      q[i] /= norm;
+    }
+  }
+}
+}  // namespace
+
+FilterType ImuFilter::type_from_string(const std::string & name)
+{
+  if (name == "none")
+  {
+    return FilterType::NONE;
+  }
+  if (name == "low_pass")
+  {
+    return FilterType::LOW_PASS;
+  }
+  if (name == "complementary")
+  {
+    return FilterType::COMPLEMENTARY;
+  }
+  throw std::invalid_argument("Unknown IMU filter type '" + name + "'.");
+}
+
+void ImuFilter::configure(FilterType type, double cutoff_frequency)
+{
+  if (type != FilterType::NONE && !(cutoff_frequency > 0.0))
+  {
+    throw std::invalid_argument("Cutoff frequency of the IMU filter must be positive.");
+  }
+  type_ = type;
+  cutoff_frequency_ = cutoff_frequency;
+  reset();
+}
+
+const ImuFilter::Sample & ImuFilter::update(const Sample & sample, double dt)
+{
+  if (type_ == FilterType::NONE || !initialized_)
+  {
+    output_ = sample;
+    initialized_ = true;
+    return output_;
+  }
+  if (!(dt > 0.0))
+  {
+    return output_;
+  }
+
+  // discrete first order low-pass with the exact step response of the continuous one
+  const double alpha = 1.0 - std::exp(-2.0 * PI * cutoff_frequency_ * dt);
+  if (type_ == FilterType::COMPLEMENTARY)
+  {
+    integrate_angular_velocity(output_.data(), sample.data() + 4, dt);
+  }
+  blend_orientation(output_.data(), sample.data(), alpha);
+  for (size_t i = 4; i < output_.size(); ++i)
+  {
+    output_[i] += alpha * (sample[i] - output_[i]);
+  }
+  return output_;
+}
+
+}  // namespace imu_sensor_broadcaster
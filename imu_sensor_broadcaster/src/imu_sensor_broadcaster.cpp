@@ -18,7 +18,12 @@
 
 #include "imu_sensor_broadcaster/imu_sensor_broadcaster.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
 
 namespace imu_sensor_broadcaster
@@ -47,12 +52,52 @@ controller_interface::CallbackReturn IMUSensorBroadcaster::on_configure(
 
   imu_sensor_ = std::make_unique<semantic_components::IMUSensor>(
     semantic_components::IMUSensor(params_.sensor_name));
+  try
+  {
+    publish_policy_.configure_from_params(
+      imu_sample_.size(), static_cast<double>(get_update_rate()), params_.publish_policy);
+  }
+  catch (const std::invalid_argument & e)
+  {
+    RCLCPP_ERROR(get_node()->get_logger(), "Invalid publish policy: %s", e.what());
+    return CallbackReturn::ERROR;
+  }
+
+  try
+  {
+    imu_filter_.configure(
+      ImuFilter::type_from_string(params_.filter.type), params_.filter.cutoff_frequency);
+  }
+  catch (const std::invalid_argument & e)
+  {
+    RCLCPP_ERROR(get_node()->get_logger(), "Invalid filter: %s", e.what());
+    return CallbackReturn::ERROR;
+  }
+  imu_exported_.fill(std::numeric_limits<double>::quiet_NaN());
+
   try
   {
     // register ft sensor data publisher
     sensor_state_publisher_ =
       get_node()->create_publisher<sensor_msgs::msg::Imu>("~/imu", rclcpp::SystemDefaultsQoS());
     realtime_publisher_ = std::make_unique<StatePublisher>(sensor_state_publisher_);
+
+    batch_size_ = static_cast<size_t>(params_.batch.size);
+    batch_queue_size_ = static_cast<size_t>(params_.batch.queue_size);
+    // a configuration without batches does not advertise the topic or run the timer
+    batch_queue_.clear();
+    realtime_batch_publisher_.reset();
+    batch_publisher_.reset();
+    dropped_samples_timer_.reset();
+    if (batch_size_ > 0)
+    {
+      batch_publisher_ = get_node()->create_publisher<std_msgs::msg::Float64MultiArray>(
+        "~/imu_batch", rclcpp::SystemDefaultsQoS());
+      realtime_batch_publisher_ = std::make_unique<BatchPublisher>(batch_publisher_);
+      batch_queue_.assign(batch_queue_size_ * batch_size_ * BATCH_FIELDS, 0.0);
+      dropped_samples_timer_ = get_node()->create_wall_timer(
+        std::chrono::seconds(1), [this]() { report_dropped_samples(); });
+    }
   }
   catch (const std::exception & e)
   {
@@ -75,6 +120,21 @@ controller_interface::CallbackReturn IMUSensorBroadcaster::on_configure(
   }
   realtime_publisher_->unlock();
 
+  if (realtime_batch_publisher_)
+  {
+    realtime_batch_publisher_->lock();
+    auto & layout = realtime_batch_publisher_->msg_.layout;
+    layout.dim.resize(2);
+    layout.dim[0].label = "samples";
+    layout.dim[0].size = static_cast<uint32_t>(batch_size_);
+    layout.dim[0].stride = static_cast<uint32_t>(batch_size_ * BATCH_FIELDS);
+    layout.dim[1].label = "fields";
+    layout.dim[1].size = static_cast<uint32_t>(BATCH_FIELDS);
+    layout.dim[1].stride = static_cast<uint32_t>(BATCH_FIELDS);
+    realtime_batch_publisher_->msg_.data.assign(batch_size_ * BATCH_FIELDS, 0.0);
+    realtime_batch_publisher_->unlock();
+  }
+
   RCLCPP_DEBUG(get_node()->get_logger(), "configure successful");
   return CallbackReturn::SUCCESS;
 }
@@ -100,6 +160,14 @@ controller_interface::CallbackReturn IMUSensorBroadcaster::on_activate(
   const rclcpp_lifecycle::State & /*previous_state*/)
 {
   imu_sensor_->assign_loaned_state_interfaces(state_interfaces_);
+  publish_policy_.reset();
+  imu_filter_.reset();
+  batch_write_index_ = 0;
+  batch_read_index_ = 0;
+  batches_pending_ = 0;
+  batch_samples_ = 0;
+  dropped_samples_.store(0, std::memory_order_relaxed);
+  reported_dropped_samples_ = 0;
   return CallbackReturn::SUCCESS;
 }
 
@@ -110,22 +178,149 @@ controller_interface::CallbackReturn IMUSensorBroadcaster::on_deactivate(
   return CallbackReturn::SUCCESS;
 }
 
-controller_interface::return_type IMUSensorBroadcaster::update(
-  const rclcpp::Time & time, const rclcpp::Duration & /*period*/)
+controller_interface::return_type IMUSensorBroadcaster::update_reference_from_subscribers(
+  const rclcpp::Time & /*time*/, const rclcpp::Duration & /*period*/)
+{
+  return controller_interface::return_type::OK;
+}
+
+std::vector<hardware_interface::StateInterface>
+IMUSensorBroadcaster::on_export_state_interfaces()
 {
+  std::vector<hardware_interface::StateInterface> exported_state_interfaces;
+
+  // e.g. /imu_sensor/orientation.x -> <controller_name>/imu_sensor/orientation.x
+  const std::string export_prefix = std::string(get_node()->get_name()) + "/" + params_.sensor_name;
+  const auto names = imu_sensor_->get_state_interface_names();
+  for (size_t i = 0; i < names.size() && i < imu_exported_.size(); ++i)
+  {
+    exported_state_interfaces.emplace_back(
+      hardware_interface::StateInterface(
+        export_prefix, names[i].substr(names[i].find_last_of("/") + 1), &imu_exported_[i]));
+  }
+  return exported_state_interfaces;
+}
+
+controller_interface::return_type IMUSensorBroadcaster::update_and_write_commands(
+  const rclcpp::Time & time, const rclcpp::Duration & period)
+{
+  imu_sensor_->get_values_as_message(imu_state_);
+  imu_sample_ = {
+    {imu_state_.orientation.x, imu_state_.orientation.y, imu_state_.orientation.z,
+     imu_state_.orientation.w, imu_state_.angular_velocity.x, imu_state_.angular_velocity.y,
+     imu_state_.angular_velocity.z, imu_state_.linear_acceleration.x,
+     imu_state_.linear_acceleration.y, imu_state_.linear_acceleration.z}};
+  imu_exported_ = imu_filter_.update(imu_sample_, period.seconds());
+
+  if (realtime_batch_publisher_)
+  {
+    // make room first if the consumer fell behind, but publish at most one batch per cycle
+    const bool published = batches_pending_ == batch_queue_size_ && publish_batch();
+    add_batch_sample(time);
+    if (!published)
+    {
+      publish_batch();
+    }
+  }
+
+  if (!publish_policy_.add_sample(imu_sample_))
+  {
+    return controller_interface::return_type::OK;
+  }
+
   if (realtime_publisher_ && realtime_publisher_->trylock())
   {
-    realtime_publisher_->msg_.header.stamp = time;
-    imu_sensor_->get_values_as_message(realtime_publisher_->msg_);
+    const auto & sample = publish_policy_.output();
+    auto & msg = realtime_publisher_->msg_;
+    msg.header.stamp = time;
+    msg.angular_velocity.x = sample[4];
+    msg.angular_velocity.y = sample[5];
+    msg.angular_velocity.z = sample[6];
+    msg.linear_acceleration.x = sample[7];
+    msg.linear_acceleration.y = sample[8];
+    msg.linear_acceleration.z = sample[9];
+
+    using sensor_broadcasters_common::Reduction;
+    const auto reduction = publish_policy_.reduction();
+    const double norm = std::sqrt(
+      sample[0] * sample[0] + sample[1] * sample[1] + sample[2] * sample[2] +
+      sample[3] * sample[3]);
+    if ((reduction == Reduction::AVERAGE || reduction == Reduction::CIC) && norm > 0.0)
+    {
+      // the filtered quaternion has to be normalized again
+      msg.orientation.x = sample[0] / norm;
+      msg.orientation.y = sample[1] / norm;
+      msg.orientation.z = sample[2] / norm;
+      msg.orientation.w = sample[3] / norm;
+    }
+    else
+    {
+      // extrema of the quaternion components are no orientation, use the latest one
+      msg.orientation = imu_state_.orientation;
+    }
     realtime_publisher_->unlockAndPublish();
   }
 
   return controller_interface::return_type::OK;
 }
 
+void IMUSensorBroadcaster::add_batch_sample(const rclcpp::Time & time)
+{
+  if (batches_pending_ == batch_queue_size_)
+  {
+    dropped_samples_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  double * row =
+    batch_queue_.data() + (batch_write_index_ * batch_size_ + batch_samples_) * BATCH_FIELDS;
+  const int64_t nanoseconds = time.nanoseconds();
+  row[0] = static_cast<double>(nanoseconds / 1000000000);
+  row[1] = static_cast<double>(nanoseconds % 1000000000);
+  std::copy(imu_sample_.begin(), imu_sample_.end(), row + 2);
+
+  if (++batch_samples_ == batch_size_)
+  {
+    batch_samples_ = 0;
+    batch_write_index_ = (batch_write_index_ + 1) % batch_queue_size_;
+    ++batches_pending_;
+  }
+}
+
+bool IMUSensorBroadcaster::publish_batch()
+{
+  if (batches_pending_ == 0 || !realtime_batch_publisher_->trylock())
+  {
+    return false;
+  }
+
+  const auto batch = batch_queue_.begin() +
+                     static_cast<std::ptrdiff_t>(batch_read_index_ * batch_size_ * BATCH_FIELDS);
+  std::copy(
+    batch, batch + static_cast<std::ptrdiff_t>(batch_size_ * BATCH_FIELDS),
+    realtime_batch_publisher_->msg_.data.begin());
+  realtime_batch_publisher_->unlockAndPublish();
+
+  batch_read_index_ = (batch_read_index_ + 1) % batch_queue_size_;
+  --batches_pending_;
+  return true;
+}
+
+void IMUSensorBroadcaster::report_dropped_samples()
+{
+  const size_t dropped_samples = dropped_samples_.load(std::memory_order_relaxed);
+  if (dropped_samples != reported_dropped_samples_)
+  {
+    RCLCPP_WARN(
+      get_node()->get_logger(),
+      "Batch publisher can not keep up, dropped %zu IMU samples in total.", dropped_samples);
+    reported_dropped_samples_ = dropped_samples;
+  }
+}
+
 }  // namespace imu_sensor_broadcaster
 
 #include "pluginlib/class_list_macros.hpp"
 
 PLUGINLIB_EXPORT_CLASS(
-  imu_sensor_broadcaster::IMUSensorBroadcaster, controller_interface::ControllerInterface)
+  imu_sensor_broadcaster::IMUSensorBroadcaster, controller_interface::ChainableControllerInterface)
@@ -0,0 +1,149 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "imu_sensor_broadcaster/imu_filter.hpp"
+
+using imu_sensor_broadcaster::FilterType;
+using imu_sensor_broadcaster::ImuFilter;
+
+namespace
+{
+constexpr double dt = 0.001;
+constexpr double PI = 3.14159265358979323846;
+
+/// Rotation about z by angle, at rest with gravity on z.
+ImuFilter::Sample yaw_sample(double angle, double yaw_rate = 0.0)
+{
+  return {{0.0, 0.0, std::sin(0.5 * angle), std::cos(0.5 * angle), 0.0, 0.0, yaw_rate, 0.0, 0.0,
+           9.81}};
+}
+
+double yaw(const ImuFilter::Sample & sample) { return 2.0 * std::atan2(sample[2], sample[3]); }
+}  // namespace
+
+TEST(ImuFilterTest, testWrongParams)
+{
+  ImuFilter filter;
+  EXPECT_THROW(ImuFilter::type_from_string("kalman"), std::invalid_argument);
+  EXPECT_EQ(ImuFilter::type_from_string("low_pass"), FilterType::LOW_PASS);
+  EXPECT_THROW(filter.configure(FilterType::LOW_PASS, 0.0), std::invalid_argument);
+  EXPECT_THROW(filter.configure(FilterType::COMPLEMENTARY, NAN), std::invalid_argument);
+  EXPECT_NO_THROW(filter.configure(FilterType::NONE, 0.0));
+}
+
+TEST(ImuFilterTest, testNonePassesThrough)
+{
+  ImuFilter filter;
+  filter.configure(FilterType::NONE, 0.0);
+  filter.update(yaw_sample(0.0), dt);
+  const auto sample = yaw_sample(1.0, 2.0);
+  EXPECT_EQ(filter.update(sample, dt), sample);
+}
+
+TEST(ImuFilterTest, testLowPassStepResponse)
+{
+  ImuFilter filter;
+  filter.configure(FilterType::LOW_PASS, 10.0);
+
+  // the first sample initializes the filter
+  auto sample = yaw_sample(0.0);
+  EXPECT_EQ(filter.update(sample, dt), sample);
+
+  // after one time constant 1 / (2 pi f), 63% of a step are reached
+  sample[9] = 10.81;
+  const auto steps = static_cast<int>(std::round(1.0 / (2.0 * PI * 10.0) / dt));
+  for (int i = 0; i < steps; ++i)
+  {
+    filter.update(sample, dt);
+  }
+  EXPECT_NEAR(filter.output()[9] - 9.81, 1.0 - std::exp(-1.0), 0.01);
+
+  // orientations are blended and stay normalized
+  filter.reset();
+  filter.update(yaw_sample(0.0), dt);
+  for (int i = 0; i < 2000; ++i)
+  {
+    const auto & output = filter.update(yaw_sample(0.5), dt);
+    const double norm = std::sqrt(
+      output[0] * output[0] + output[1] * output[1] + output[2] * output[2] +
+      output[3] * output[3]);
+    ASSERT_NEAR(norm, 1.0, 1e-12);
+  }
+  EXPECT_NEAR(yaw(filter.output()), 0.5, 1e-6);
+}
+
+TEST(ImuFilterTest, testLowPassTakesShorterPath)
+{
+  ImuFilter filter;
+  filter.configure(FilterType::LOW_PASS, 10.0);
+  filter.update(yaw_sample(0.1), dt);
+  // the same orientation with the opposite sign must not be blended through zero
+  auto flipped = yaw_sample(0.1);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    flipped[i] = -flipped[i];
+  }
+  const auto & output = filter.update(flipped, dt);
+  EXPECT_NEAR(yaw(output), 0.1, 1e-12);
+}
+
+TEST(ImuFilterTest, testComplementaryFollowsRotationWithoutLag)
+{
+  const double yaw_rate = 1.0;
+  ImuFilter low_pass;
+  low_pass.configure(FilterType::LOW_PASS, 1.0);
+  ImuFilter complementary;
+  complementary.configure(FilterType::COMPLEMENTARY, 1.0);
+
+  double angle = 0.0;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const auto sample = yaw_sample(angle, yaw_rate);
+    low_pass.update(sample, dt);
+    complementary.update(sample, dt);
+    angle += yaw_rate * dt;
+  }
+  const double measured = angle - yaw_rate * dt;
+  // the low-pass lags by about rate / (2 pi f), the integrated rate keeps up
+  EXPECT_NEAR(measured - yaw(low_pass.output()), yaw_rate / (2.0 * PI), 0.02);
+  EXPECT_NEAR(yaw(complementary.output()), measured, 1e-3);
+}
+
+TEST(ImuFilterTest, testComplementaryCorrectsGyroBias)
+{
+  ImuFilter filter;
+  filter.configure(FilterType::COMPLEMENTARY, 1.0);
+  // the orientation reading does not move, the gyro reports a bias
+  for (int i = 0; i < 10000; ++i)
+  {
+    filter.update(yaw_sample(0.0, 0.01), dt);
+  }
+  // the drift is bounded to bias / (2 pi f) instead of growing with time
+  EXPECT_NEAR(yaw(filter.output()), 0.01 / (2.0 * PI), 1e-3);
+}
+
+TEST(ImuFilterTest, testInvalidPeriod)
+{
+  ImuFilter filter;
+  filter.configure(FilterType::LOW_PASS, 10.0);
+  const auto sample = yaw_sample(0.0);
+  filter.update(sample, dt);
+  EXPECT_EQ(filter.update(yaw_sample(1.0, 1.0), 0.0), sample);
+  EXPECT_EQ(filter.update(yaw_sample(1.0, 1.0), -dt), sample);
+}
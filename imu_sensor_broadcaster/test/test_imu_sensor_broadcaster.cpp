@@ -18,6 +18,7 @@
 
 #include "test_imu_sensor_broadcaster.hpp"
 
+#include <cmath>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -50,10 +51,10 @@ void IMUSensorBroadcasterTest::SetUp()
 
 void IMUSensorBroadcasterTest::TearDown() { imu_broadcaster_.reset(nullptr); }
 
-void IMUSensorBroadcasterTest::SetUpIMUBroadcaster()
+void IMUSensorBroadcasterTest::SetUpIMUBroadcaster(const std::string & name)
 {
-  const auto result = imu_broadcaster_->init(
-    "test_imu_sensor_broadcaster", "", 0, "", imu_broadcaster_->define_custom_node_options());
+  const auto result =
+    imu_broadcaster_->init(name, "", 0, "", imu_broadcaster_->define_custom_node_options());
   ASSERT_EQ(result, controller_interface::return_type::OK);
 
   std::vector<LoanedStateInterface> state_ifs;
@@ -213,6 +214,115 @@ TEST_F(IMUSensorBroadcasterTest, SensorName_Publish_Success)
   }
 }
 
+TEST_F(IMUSensorBroadcasterTest, BatchQueue_Lossless_And_DropCounter)
+{
+  // batches of 3 samples, 2 batches can be queued
+  SetUpIMUBroadcaster("test_imu_sensor_broadcaster_batch");
+  ASSERT_EQ(imu_broadcaster_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(imu_broadcaster_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_TRUE(imu_broadcaster_->realtime_batch_publisher_);
+  ASSERT_EQ(imu_broadcaster_->realtime_batch_publisher_->msg_.data.size(), 3u * 12u);
+
+  // the consumer is busy, two batches are queued and the 7th sample is dropped
+  imu_broadcaster_->realtime_batch_publisher_->lock();
+  for (int32_t i = 1; i <= 7; ++i)
+  {
+    sensor_values_[4] = static_cast<double>(i);
+    ASSERT_EQ(
+      imu_broadcaster_->update(rclcpp::Time(i, 5), rclcpp::Duration::from_seconds(0.01)),
+      controller_interface::return_type::OK);
+  }
+  EXPECT_EQ(imu_broadcaster_->batches_pending_, 2u);
+  EXPECT_EQ(imu_broadcaster_->dropped_samples_.load(), 1u);
+  EXPECT_EQ(imu_broadcaster_->reported_dropped_samples_, 0u);
+  ASSERT_TRUE(imu_broadcaster_->dropped_samples_timer_);
+  // the drop is reported from the timer, not from update
+  imu_broadcaster_->report_dropped_samples();
+  EXPECT_EQ(imu_broadcaster_->reported_dropped_samples_, 1u);
+  imu_broadcaster_->realtime_batch_publisher_->unlock();
+
+  // the oldest batch is published and frees the room for the next sample
+  sensor_values_[4] = 8.0;
+  ASSERT_EQ(
+    imu_broadcaster_->update(rclcpp::Time(8, 5), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(imu_broadcaster_->batches_pending_, 1u);
+  EXPECT_EQ(imu_broadcaster_->dropped_samples_.load(), 1u);
+
+  // wait for the publisher thread to release the message
+  imu_broadcaster_->realtime_batch_publisher_->lock();
+  const auto & data = imu_broadcaster_->realtime_batch_publisher_->msg_.data;
+  for (size_t row = 0; row < 3; ++row)
+  {
+    EXPECT_EQ(data[row * 12 + 0], static_cast<double>(row + 1));
+    EXPECT_EQ(data[row * 12 + 1], 5.0);
+    EXPECT_EQ(data[row * 12 + 2], sensor_values_[0]);
+    EXPECT_EQ(data[row * 12 + 6], static_cast<double>(row + 1));
+    EXPECT_EQ(data[row * 12 + 11], sensor_values_[9]);
+  }
+  imu_broadcaster_->realtime_batch_publisher_->unlock();
+}
+
+TEST_F(IMUSensorBroadcasterTest, SensorName_ExportedStateInterfaces)
+{
+  SetUpIMUBroadcaster();
+
+  ASSERT_EQ(imu_broadcaster_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(imu_broadcaster_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  const auto exported_state_interfaces = imu_broadcaster_->export_state_interfaces();
+  ASSERT_EQ(exported_state_interfaces.size(), 10u);
+
+  const std::string prefix = std::string(imu_broadcaster_->get_node()->get_name()) + "/" +
+                             sensor_name_;
+  const auto names = imu_broadcaster_->state_interface_configuration().names;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(exported_state_interfaces[i]->get_prefix_name(), prefix);
+    EXPECT_EQ(
+      exported_state_interfaces[i]->get_interface_name(),
+      names[i].substr(names[i].find_last_of("/") + 1));
+  }
+
+  // the readings of this cycle are available to chained controllers, unfiltered by default
+  ASSERT_EQ(
+    imu_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(exported_state_interfaces[i]->get_value(), sensor_values_[i]);
+  }
+}
+
+TEST_F(IMUSensorBroadcasterTest, SensorName_ExportedStateInterfaces_LowPass)
+{
+  SetUpIMUBroadcaster("test_imu_sensor_broadcaster_low_pass");
+
+  ASSERT_EQ(imu_broadcaster_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(imu_broadcaster_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  const auto exported_state_interfaces = imu_broadcaster_->export_state_interfaces();
+  ASSERT_EQ(exported_state_interfaces.size(), 10u);
+
+  // the first reading initializes the filter
+  ASSERT_EQ(
+    imu_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(exported_state_interfaces[9]->get_value(), sensor_values_[9]);
+
+  // a step of 1.0 is low-pass filtered with 10 Hz
+  const double previous = sensor_values_[9];
+  sensor_values_[9] += 1.0;
+  ASSERT_EQ(
+    imu_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_NEAR(
+    exported_state_interfaces[9]->get_value(),
+    previous + 1.0 - std::exp(-2.0 * M_PI * 10.0 * 0.01), 1e-12);
+  for (size_t i = 4; i < 9; ++i)
+  {
+    EXPECT_DOUBLE_EQ(exported_state_interfaces[i]->get_value(), sensor_values_[i]);
+  }
+}
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleMock(&argc, argv);
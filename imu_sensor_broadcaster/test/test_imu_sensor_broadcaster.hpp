@@ -38,6 +38,7 @@ class FriendIMUSensorBroadcaster : public imu_sensor_broadcaster::IMUSensorBroad
   FRIEND_TEST(IMUSensorBroadcasterTest, ActivateSuccess);
   FRIEND_TEST(IMUSensorBroadcasterTest, UpdateTest);
   FRIEND_TEST(IMUSensorBroadcasterTest, SensorStatePublishTest);
+  FRIEND_TEST(IMUSensorBroadcasterTest, BatchQueue_Lossless_And_DropCounter);
 };
 
 class IMUSensorBroadcasterTest : public ::testing::Test
@@ -49,7 +50,7 @@ public:
   void SetUp();
   void TearDown();
 
-  void SetUpIMUBroadcaster();
+  void SetUpIMUBroadcaster(const std::string & name = "test_imu_sensor_broadcaster");
 
 protected:
   const std::string sensor_name_ = "imu_sensor";
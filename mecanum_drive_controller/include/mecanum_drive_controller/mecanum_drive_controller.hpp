@@ -15,6 +15,7 @@
 #ifndef MECANUM_DRIVE_CONTROLLER__MECANUM_DRIVE_CONTROLLER_HPP_
 #define MECANUM_DRIVE_CONTROLLER__MECANUM_DRIVE_CONTROLLER_HPP_
 
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <memory>
@@ -24,17 +25,24 @@
 #include <vector>
 
 #include "control_msgs/msg/mecanum_drive_controller_state.hpp"
+#include "control_msgs/msg/multi_dof_state_stamped.hpp"
 #include "controller_interface/chainable_controller_interface.hpp"
+#include "geometry_msgs/msg/pose_with_covariance_stamped.hpp"
 #include "geometry_msgs/msg/twist_stamped.hpp"
+#include "mobile_base_controllers_common/inverse_kinematics_cache.hpp"
+#include "mobile_base_controllers_common/inverse_kinematics_cache_diagnostics.hpp"
+#include "mobile_base_controllers_common/odometry_reset_request.hpp"
 #include "nav_msgs/msg/odometry.hpp"
 #include "rclcpp_lifecycle/node_interfaces/lifecycle_node_interface.hpp"
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_buffer.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
+#include "std_srvs/srv/empty.hpp"
 #include "std_srvs/srv/set_bool.hpp"
 #include "tf2_msgs/msg/tf_message.hpp"
 
 #include "mecanum_drive_controller/mecanum_drive_controller_parameters.hpp"
+#include "mecanum_drive_controller/mecanum_kinematics.hpp"
 #include "mecanum_drive_controller/odometry.hpp"
 namespace mecanum_drive_controller
 {
@@ -77,6 +85,8 @@ public:
   using OdomStateMsg = nav_msgs::msg::Odometry;
   using TfStateMsg = tf2_msgs::msg::TFMessage;
   using ControllerStateMsg = control_msgs::msg::MecanumDriveControllerState;
+  using WheelResidualsMsg = control_msgs::msg::MultiDOFStateStamped;
+  using OdometryPoseMsg = geometry_msgs::msg::PoseWithCovarianceStamped;
 
 protected:
   std::shared_ptr<mecanum_drive_controller::ParamListener> param_listener_;
@@ -130,6 +140,10 @@ protected:
   rclcpp::Publisher<ControllerStateMsg>::SharedPtr controller_s_publisher_;
   std::unique_ptr<ControllerStatePublisher> controller_state_publisher_;
 
+  using WheelResidualsPublisher = realtime_tools::RealtimePublisher<WheelResidualsMsg>;
+  rclcpp::Publisher<WheelResidualsMsg>::SharedPtr wheel_residuals_s_publisher_;
+  std::unique_ptr<WheelResidualsPublisher> wheel_residuals_publisher_;
+
   // override methods from ChainableControllerInterface
   std::vector<hardware_interface::CommandInterface> on_export_reference_interfaces() override;
 
@@ -137,13 +151,34 @@ protected:
 
   Odometry odometry_;
 
+  MecanumKinematics kinematics_;
+  // Output of the inverse kinematics, sorted as in `WheelIndex` enum
+  std::vector<double> wheel_velocities_;
+  // Wheel velocities of the last reference, sorted as in `WheelIndex` enum
+  using InverseKinematicsCacheType = mobile_base_controllers_common::InverseKinematicsCache<
+    NR_REF_ITFS, std::array<double, NR_CMD_ITFS>>;
+  InverseKinematicsCacheType ik_cache_;
+  mobile_base_controllers_common::InverseKinematicsCacheDiagnostics ik_cache_diagnostics_;
+
+  // Frame of the published odometry, including the tf prefix
+  std::string odom_frame_id_;
+  rclcpp::Service<std_srvs::srv::Empty>::SharedPtr reset_odom_service_;
+  rclcpp::Subscription<OdometryPoseMsg>::SharedPtr set_odometry_pose_subscriber_ = nullptr;
+
+  // Odometry reset requested by the service or the set pose subscriber, applied by the next update
+  using OdometryResetRequest = mobile_base_controllers_common::OdometryResetRequest;
+  mobile_base_controllers_common::OdometryResetSlot odometry_reset_slot_;
+
+  void reset_odometry(
+    const std::shared_ptr<rmw_request_id_t> request_header,
+    const std::shared_ptr<std_srvs::srv::Empty::Request> req,
+    std::shared_ptr<std_srvs::srv::Empty::Response> res);
+  void set_odometry_pose(const std::shared_ptr<OdometryPoseMsg> msg);
+  void apply_odometry_reset_request();
+
 private:
   // callback for topic interface
   void reference_callback(const std::shared_ptr<ControllerReferenceMsg> msg);
-
-  double velocity_in_center_frame_linear_x_;   // [m/s]
-  double velocity_in_center_frame_linear_y_;   // [m/s]
-  double velocity_in_center_frame_angular_z_;  // [rad/s]
 };
 
 }  // namespace mecanum_drive_controller
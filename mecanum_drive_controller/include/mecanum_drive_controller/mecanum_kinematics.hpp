@@ -0,0 +1,136 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MECANUM_DRIVE_CONTROLLER__MECANUM_KINEMATICS_HPP_
+#define MECANUM_DRIVE_CONTROLLER__MECANUM_KINEMATICS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace mecanum_drive_controller
+{
+/**
+ * \brief Geometry of one mecanum or omni wheel, expressed in the center frame.
+ */
+struct WheelGeometry
+{
+  /// Position of the contact point [m]
+  double x = 0.0;
+  double y = 0.0;
+  /// Rolling direction of the wheel w.r.t. the x axis [rad]
+  double yaw = 0.0;
+  /// Angle between the roller axis and the rolling direction [rad], +-pi/4 for mecanum wheels
+  /// and 0 for omni wheels
+  double roller_angle = 0.0;
+  /// Wheel radius [m]
+  double radius = 0.0;
+};
+
+/**
+ * \brief Kinematics of a base with N mecanum or omni wheels, compiled into constant matrices.
+ *
+ * The twist [linear x, linear y, angular z] is the body twist of the base frame, which is offset
+ * by [x, y, theta] from the center frame the wheels are expressed in. A roller only lets its
+ * contact point slide perpendicular to the roller axis, so the wheel velocity is the velocity of
+ * the contact point projected on the roller axis, divided by r * cos(roller_angle).
+ *
+ * The geometry only changes on configure(), so the transformation between base and center frame
+ * is folded into the Nx3 inverse matrix and its 3xN least-squares pseudo-inverse for the forward
+ * kinematics there. Each cycle then only evaluates a dense matrix-vector product on preallocated
+ * storage.
+ *
+ * \note MecanumDriveController and its Odometry only use the four wheel configuration.
+ */
+class MecanumKinematics
+{
+public:
+  using Twist = std::array<double, 3>;
+
+  /// Row-major 3xN matrix, the order of the columns is the order of the wheels
+  using ForwardMatrix = std::array<std::vector<double>, 3>;
+
+  /**
+   * \brief Compile the kinematic matrices
+   * \param [in] wheels Geometry of the wheels in the center frame, at least three
+   * \param [in] base_frame_offset Offset [x, y, theta] of the base frame from the center frame
+   * \return false if the geometry does not determine the twist, the matrices are zero then
+   */
+  bool configure(
+    const std::vector<WheelGeometry> & wheels, const std::array<double, 3> & base_frame_offset);
+
+  /**
+   * \brief Compile the kinematic matrices of a standard four wheel mecanum base
+   *
+   * The wheels are sorted as front left, front right, rear right, rear left, like the
+   * `WheelIndex` of the controller, and their rollers form an X seen from above.
+   *
+   * \param [in] base_frame_offset Offset [x, y, theta] of the base frame from the center frame
+   * \param [in] sum_of_robot_center_projection_on_X_Y_axis lx + ly [m]
+   * \param [in] wheels_radius Wheels radius [m]
+   * \return false if the geometry does not determine the twist, the matrices are zero then
+   */
+  bool configure(
+    const std::array<double, 3> & base_frame_offset,
+    double sum_of_robot_center_projection_on_X_Y_axis, double wheels_radius);
+
+  /// Number of wheels of the configured geometry.
+  size_t size() const { return inverse_matrix_.size(); }
+
+  /**
+   * \brief Wheel velocities commanding the body twist of the base frame
+   * \param [in] twist Body twist of the base frame
+   * \param [out] wheel_velocities Wheel velocities [rad/s], must hold size() elements
+   */
+  void inverse(const Twist & twist, std::vector<double> & wheel_velocities) const
+  {
+    for (size_t i = 0; i < inverse_matrix_.size(); ++i)
+    {
+      wheel_velocities[i] = inverse_matrix_[i][0] * twist[0] + inverse_matrix_[i][1] * twist[1] +
+                            inverse_matrix_[i][2] * twist[2];
+    }
+  }
+
+  /**
+   * \brief Least-squares body twist of the base frame resulting from the wheel velocities
+   * \param [in] wheel_velocities Wheel velocities [rad/s], must hold size() elements
+   */
+  Twist forward(const std::vector<double> & wheel_velocities) const
+  {
+    Twist twist = {{0.0, 0.0, 0.0}};
+    for (size_t j = 0; j < inverse_matrix_.size(); ++j)
+    {
+      twist[0] += forward_matrix_[0][j] * wheel_velocities[j];
+      twist[1] += forward_matrix_[1][j] * wheel_velocities[j];
+      twist[2] += forward_matrix_[2][j] * wheel_velocities[j];
+    }
+    return twist;
+  }
+
+  const std::vector<std::array<double, 3>> & inverse_matrix() const { return inverse_matrix_; }
+  const ForwardMatrix & forward_matrix() const { return forward_matrix_; }
+
+private:
+  /// Compile the matrices from the inverse kinematics in the center frame, one row per wheel.
+  bool compile(
+    const std::vector<std::array<double, 3>> & center_to_wheels,
+    const std::array<double, 3> & base_frame_offset);
+
+  std::vector<std::array<double, 3>> inverse_matrix_;
+  ForwardMatrix forward_matrix_;
+};
+
+}  // namespace mecanum_drive_controller
+
+#endif  // MECANUM_DRIVE_CONTROLLER__MECANUM_KINEMATICS_HPP_
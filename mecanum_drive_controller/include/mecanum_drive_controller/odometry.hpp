@@ -15,7 +15,11 @@
 #ifndef MECANUM_DRIVE_CONTROLLER__ODOMETRY_HPP_
 #define MECANUM_DRIVE_CONTROLLER__ODOMETRY_HPP_
 
+#include <array>
+#include <vector>
+
 #include "geometry_msgs/msg/twist.hpp"
+#include "mecanum_drive_controller/mecanum_kinematics.hpp"
 #include "realtime_tools/realtime_buffer.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
 
@@ -28,6 +32,9 @@ namespace mecanum_drive_controller
 class Odometry
 {
 public:
+  // the kinematics support N wheels, the controller only provides the four named ones
+  static constexpr size_t NUM_WHEELS = 4;
+
   /// Integration function, used to integrate the odometry:
   typedef std::function<void(double, double, double)> IntegrationFunction;
 
@@ -47,10 +54,21 @@ public:
   /// \param wheel_front_right_vel  Wheel velocity [rad/s]
   /// \param time      Current time
   /// \return true if the odometry is actually updated
+  /// \note With slip rejection enabled, a NaN wheel velocity is ignored as long as three wheels
+  /// remain; otherwise all four velocities have to be valid.
   bool update(
     const double wheel_front_left_vel, const double wheel_rear_left_vel,
     const double wheel_rear_right_vel, const double wheel_front_right_vel, const double dt);
 
+  /// \brief Resets the pose to zero
+  void resetOdometry();
+
+  /// \brief Sets the pose, e.g., for relocalization
+  /// \param x  Position (x component) [m]
+  /// \param y  Position (y component) [m]
+  /// \param rz  Orientation (z component) [rad]
+  void setPose(const double x, const double y, const double rz);
+
   /// \return position (x component) [m]
   double getX() const { return position_x_in_base_frame_; }
   /// \return position (y component) [m]
@@ -80,7 +98,29 @@ public:
   void setWheelsParams(
     const double sum_of_robot_center_projection_on_X_Y_axis, const double wheels_radius);
 
+  /// \brief Sets the weighted least-squares estimation of the twist, which down-weights slipping
+  /// wheels using the redundant fourth wheel
+  /// \param enable  Enables the estimation, otherwise all wheels have the same weight
+  /// \param residual_threshold  Wheel velocity residual above which a wheel is down-weighted
+  /// [rad/s]
+  /// \param iterations  Number of reweighting iterations per update
+  void setSlipRejection(
+    const bool enable, const double residual_threshold, const size_t iterations);
+
+  /// \return residuals of the wheel velocities w.r.t. the estimated twist [rad/s], sorted as
+  /// front left, front right, rear right, rear left. NaN for a wheel without valid velocity.
+  const std::array<double, NUM_WHEELS> & getWheelResiduals() const { return wheel_residuals_; }
+  /// \return weights of the wheels in the last estimation, sorted as the residuals
+  const std::array<double, NUM_WHEELS> & getWheelWeights() const { return wheel_weights_; }
+
 private:
+  /// \brief Iteratively reweighted least-squares estimation of the body twist
+  /// \return false if less than three wheels are usable
+  bool estimateSlipRobustTwist(MecanumKinematics::Twist & twist);
+
+  /// \brief Weighted least-squares body twist of the wheel velocities
+  /// \return false if the weighted wheels do not determine the twist
+  bool solveWeighted(MecanumKinematics::Twist & twist) const;
   /// Current timestamp:
   rclcpp::Time timestamp_;
 
@@ -96,6 +136,20 @@ private:
   double velocity_in_base_frame_linear_y;   // [m/s]
   double velocity_in_base_frame_angular_z;  // [rad/s]
 
+  /// Forward kinematics compiled from the base frame offset and the wheels parameters
+  MecanumKinematics kinematics_;
+  /// Wheel velocities sorted for the kinematics, preallocated for update()
+  std::vector<double> wheel_velocities_;
+
+  /// Slip rejection
+  bool slip_rejection_enabled_;
+  double residual_threshold_;  // [rad/s]
+  size_t slip_rejection_iterations_;
+  /// Weights from the wheel velocities predicted by the last estimated twist
+  std::array<double, NUM_WHEELS> prediction_weights_;
+  std::array<double, NUM_WHEELS> wheel_weights_;
+  std::array<double, NUM_WHEELS> wheel_residuals_;
+
   /// Wheels kinematic parameters [m]:
   /// lx and ly represent the distance from the robot's center to the wheels
   /// projected on the x and y axis with origin at robots center respectively,
@@ -14,6 +14,7 @@
 
 #include "mecanum_drive_controller/mecanum_drive_controller.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
@@ -22,6 +23,7 @@
 #include "controller_interface/helpers.hpp"
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
 #include "lifecycle_msgs/msg/state.hpp"
+#include "tf2/LinearMath/Matrix3x3.hpp"
 #include "tf2/transform_datatypes.hpp"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 
@@ -112,11 +114,32 @@ controller_interface::CallbackReturn MecanumDriveController::on_configure(
     {params_.kinematics.base_frame_offset.x, params_.kinematics.base_frame_offset.y,
      params_.kinematics.base_frame_offset.theta}};
   odometry_.init(get_node()->now(), base_frame_offset);
+  // discard a request which was not applied yet
+  OdometryResetRequest discarded_request;
+  odometry_reset_slot_.read(discarded_request);
 
   // Set wheel params for the odometry computation
   odometry_.setWheelsParams(
     params_.kinematics.sum_of_robot_center_projection_on_X_Y_axis,
     params_.kinematics.wheels_radius);
+  odometry_.setSlipRejection(
+    params_.slip_rejection.enable, params_.slip_rejection.residual_threshold,
+    static_cast<size_t>(params_.slip_rejection.iterations));
+
+  // Compile the inverse kinematics, they only change with the parameters
+  if (!kinematics_.configure(
+        base_frame_offset, params_.kinematics.sum_of_robot_center_projection_on_X_Y_axis,
+        params_.kinematics.wheels_radius))
+  {
+    RCLCPP_ERROR(
+      get_node()->get_logger(),
+      "The kinematics parameters do not determine the twist of the base, 'wheels_radius' and "
+      "'sum_of_robot_center_projection_on_X_Y_axis' have to be non-zero.");
+    return controller_interface::CallbackReturn::ERROR;
+  }
+  wheel_velocities_.assign(kinematics_.size(), 0.0);
+  // computed with the previous kinematics
+  ik_cache_.invalidate();
 
   // topics QoS
   auto subscribers_qos = rclcpp::SystemDefaultsQoS();
@@ -166,12 +189,12 @@ controller_interface::CallbackReturn MecanumDriveController::on_configure(
     }
   }
 
-  const auto odom_frame_id = tf_prefix + params_.odom_frame_id;
+  odom_frame_id_ = tf_prefix + params_.odom_frame_id;
   const auto base_frame_id = tf_prefix + params_.base_frame_id;
 
   rt_odom_state_publisher_->lock();
   rt_odom_state_publisher_->msg_.header.stamp = get_node()->now();
-  rt_odom_state_publisher_->msg_.header.frame_id = odom_frame_id;
+  rt_odom_state_publisher_->msg_.header.frame_id = odom_frame_id_;
   rt_odom_state_publisher_->msg_.child_frame_id = base_frame_id;
   rt_odom_state_publisher_->msg_.pose.pose.position.z = 0;
 
@@ -203,7 +226,7 @@ controller_interface::CallbackReturn MecanumDriveController::on_configure(
   rt_tf_odom_state_publisher_->lock();
   rt_tf_odom_state_publisher_->msg_.transforms.resize(1);
   rt_tf_odom_state_publisher_->msg_.transforms[0].header.stamp = get_node()->now();
-  rt_tf_odom_state_publisher_->msg_.transforms[0].header.frame_id = odom_frame_id;
+  rt_tf_odom_state_publisher_->msg_.transforms[0].header.frame_id = odom_frame_id_;
   rt_tf_odom_state_publisher_->msg_.transforms[0].child_frame_id = base_frame_id;
   rt_tf_odom_state_publisher_->msg_.transforms[0].transform.translation.z = 0.0;
   rt_tf_odom_state_publisher_->unlock();
@@ -228,9 +251,62 @@ controller_interface::CallbackReturn MecanumDriveController::on_configure(
 
   controller_state_publisher_->lock();
   controller_state_publisher_->msg_.header.stamp = get_node()->now();
-  controller_state_publisher_->msg_.header.frame_id = odom_frame_id;
+  controller_state_publisher_->msg_.header.frame_id = odom_frame_id_;
   controller_state_publisher_->unlock();
 
+  try
+  {
+    // wheel residuals publisher, for slip detection
+    wheel_residuals_s_publisher_ = get_node()->create_publisher<WheelResidualsMsg>(
+      "~/wheel_residuals", rclcpp::SystemDefaultsQoS());
+    wheel_residuals_publisher_ =
+      std::make_unique<WheelResidualsPublisher>(wheel_residuals_s_publisher_);
+  }
+  catch (const std::exception & e)
+  {
+    fprintf(
+      stderr,
+      "Exception thrown during publisher creation at configure stage "
+      "with message : %s \n",
+      e.what());
+    return controller_interface::CallbackReturn::ERROR;
+  }
+
+  wheel_residuals_publisher_->lock();
+  wheel_residuals_publisher_->msg_.header.frame_id = base_frame_id;
+  wheel_residuals_publisher_->msg_.dof_states.resize(NR_STATE_ITFS);
+  for (size_t i = 0; i < NR_STATE_ITFS; ++i)
+  {
+    wheel_residuals_publisher_->msg_.dof_states[i].name = state_joint_names_[i];
+  }
+  wheel_residuals_publisher_->unlock();
+
+  if (params_.inverse_kinematics_cache.enable)
+  {
+    try
+    {
+      // inverse kinematics cache statistics publisher
+      ik_cache_diagnostics_.configure(get_node());
+    }
+    catch (const std::exception & e)
+    {
+      fprintf(
+        stderr,
+        "Exception thrown during publisher creation at configure stage "
+        "with message : %s \n",
+        e.what());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+  }
+
+  reset_odom_service_ = get_node()->create_service<std_srvs::srv::Empty>(
+    "~/reset_odometry", std::bind(
+                          &MecanumDriveController::reset_odometry, this, std::placeholders::_1,
+                          std::placeholders::_2, std::placeholders::_3));
+  set_odometry_pose_subscriber_ = get_node()->create_subscription<OdometryPoseMsg>(
+    "~/set_odometry_pose", rclcpp::SystemDefaultsQoS(),
+    std::bind(&MecanumDriveController::set_odometry_pose, this, std::placeholders::_1));
+
   RCLCPP_INFO(get_node()->get_logger(), "MecanumDriveController configured successfully");
 
   return controller_interface::CallbackReturn::SUCCESS;
@@ -319,6 +395,49 @@ MecanumDriveController::on_export_reference_interfaces()
   return reference_interfaces;
 }
 
+void MecanumDriveController::reset_odometry(
+  const std::shared_ptr<rmw_request_id_t> /*request_header*/,
+  const std::shared_ptr<std_srvs::srv::Empty::Request> /*req*/,
+  std::shared_ptr<std_srvs::srv::Empty::Response> /*res*/)
+{
+  odometry_reset_slot_.write(OdometryResetRequest{});
+  RCLCPP_INFO(get_node()->get_logger(), "Odometry reset requested");
+}
+
+void MecanumDriveController::set_odometry_pose(const std::shared_ptr<OdometryPoseMsg> msg)
+{
+  if (!msg->header.frame_id.empty() && msg->header.frame_id != odom_frame_id_)
+  {
+    RCLCPP_WARN(
+      get_node()->get_logger(), "Odometry pose ignored, it is in frame '%s' instead of '%s'",
+      msg->header.frame_id.c_str(), odom_frame_id_.c_str());
+    return;
+  }
+
+  tf2::Quaternion orientation;
+  tf2::fromMsg(msg->pose.pose.orientation, orientation);
+  double roll, pitch, yaw;
+  tf2::Matrix3x3(orientation).getRPY(roll, pitch, yaw);
+  odometry_reset_slot_.write({true, msg->pose.pose.position.x, msg->pose.pose.position.y, yaw});
+}
+
+void MecanumDriveController::apply_odometry_reset_request()
+{
+  OdometryResetRequest request;
+  if (!odometry_reset_slot_.read(request))
+  {
+    return;
+  }
+  if (request.set_pose)
+  {
+    odometry_.setPose(request.x, request.y, request.heading);
+  }
+  else
+  {
+    odometry_.resetOdometry();
+  }
+}
+
 bool MecanumDriveController::on_set_chained_mode(bool /*chained_mode*/) { return true; }
 
 controller_interface::CallbackReturn MecanumDriveController::on_activate(
@@ -326,6 +445,9 @@ controller_interface::CallbackReturn MecanumDriveController::on_activate(
 {
   // Set default value in command
   reset_controller_reference_msg(*(input_ref_.readFromRT()), get_node());
+  // discard a request which was not applied yet
+  OdometryResetRequest discarded_request;
+  odometry_reset_slot_.read(discarded_request);
 
   return controller_interface::CallbackReturn::SUCCESS;
 }
@@ -347,6 +469,7 @@ controller_interface::CallbackReturn MecanumDriveController::on_deactivate(
       "This means that you are maybe blocking the interface in your hardware for too long.");
     return controller_interface::CallbackReturn::FAILURE;
   }
+  ik_cache_.invalidate();
 
   return controller_interface::CallbackReturn::SUCCESS;
 }
@@ -398,20 +521,45 @@ controller_interface::return_type MecanumDriveController::update_reference_from_
 controller_interface::return_type MecanumDriveController::update_and_write_commands(
   const rclcpp::Time & time, const rclcpp::Duration & period)
 {
+  apply_odometry_reset_request();
+
   // FORWARD KINEMATICS (odometry).
   const double wheel_front_left_state_vel = state_interfaces_[FRONT_LEFT].get_value();
   const double wheel_front_right_state_vel = state_interfaces_[FRONT_RIGHT].get_value();
   const double wheel_rear_right_state_vel = state_interfaces_[REAR_RIGHT].get_value();
   const double wheel_rear_left_state_vel = state_interfaces_[REAR_LEFT].get_value();
 
+  // the slip rejection ignores single wheels without valid velocity
   if (
-    !std::isnan(wheel_front_left_state_vel) && !std::isnan(wheel_rear_left_state_vel) &&
-    !std::isnan(wheel_rear_right_state_vel) && !std::isnan(wheel_front_right_state_vel))
+    params_.slip_rejection.enable ||
+    (!std::isnan(wheel_front_left_state_vel) && !std::isnan(wheel_rear_left_state_vel) &&
+     !std::isnan(wheel_rear_right_state_vel) && !std::isnan(wheel_front_right_state_vel)))
   {
     // Estimate twist (using joint information) and integrate
-    odometry_.update(
+    const bool odometry_updated = odometry_.update(
       wheel_front_left_state_vel, wheel_rear_left_state_vel, wheel_rear_right_state_vel,
       wheel_front_right_state_vel, period.seconds());
+
+    if (odometry_updated && wheel_residuals_publisher_->trylock())
+    {
+      // reference: velocity fitted by the estimated twist, error: residual, output: weight
+      auto & wheel_residuals_msg = wheel_residuals_publisher_->msg_;
+      wheel_residuals_msg.header.stamp = time;
+      const auto & residuals = odometry_.getWheelResiduals();
+      const auto & weights = odometry_.getWheelWeights();
+      const std::array<double, NR_STATE_ITFS> wheel_state_velocities = {
+        {wheel_front_left_state_vel, wheel_front_right_state_vel, wheel_rear_right_state_vel,
+         wheel_rear_left_state_vel}};
+      for (size_t i = 0; i < NR_STATE_ITFS; ++i)
+      {
+        wheel_residuals_msg.dof_states[i].feedback = wheel_state_velocities[i];
+        wheel_residuals_msg.dof_states[i].reference = wheel_state_velocities[i] - residuals[i];
+        wheel_residuals_msg.dof_states[i].error = residuals[i];
+        wheel_residuals_msg.dof_states[i].time_step = period.seconds();
+        wheel_residuals_msg.dof_states[i].output = weights[i];
+      }
+      wheel_residuals_publisher_->unlockAndPublish();
+    }
   }
 
   // INVERSE KINEMATICS (move robot).
@@ -421,49 +569,31 @@ controller_interface::return_type MecanumDriveController::update_and_write_comma
     !std::isnan(reference_interfaces_[0]) && !std::isnan(reference_interfaces_[1]) &&
     !std::isnan(reference_interfaces_[2]))
   {
-    tf2::Quaternion quaternion;
-    quaternion.setRPY(0.0, 0.0, params_.kinematics.base_frame_offset.theta);
-    /// \note The variables meaning:
-    /// rotation_from_base_to_center: Rotation transformation matrix, to transform from
-    /// base frame to center frame
-    /// linear_trans_from_base_to_center: offset/linear transformation matrix, to
-    /// transform from base frame to center frame
-
-    tf2::Matrix3x3 rotation_from_base_to_center = tf2::Matrix3x3((quaternion));
-    tf2::Vector3 velocity_in_base_frame_w_r_t_center_frame_ =
-      rotation_from_base_to_center *
-      tf2::Vector3(reference_interfaces_[0], reference_interfaces_[1], 0.0);
-    tf2::Vector3 linear_trans_from_base_to_center = tf2::Vector3(
-      params_.kinematics.base_frame_offset.x, params_.kinematics.base_frame_offset.y, 0.0);
-
-    velocity_in_center_frame_linear_x_ =
-      velocity_in_base_frame_w_r_t_center_frame_.x() +
-      linear_trans_from_base_to_center.y() * reference_interfaces_[2];
-    velocity_in_center_frame_linear_y_ =
-      velocity_in_base_frame_w_r_t_center_frame_.y() -
-      linear_trans_from_base_to_center.x() * reference_interfaces_[2];
-    velocity_in_center_frame_angular_z_ = reference_interfaces_[2];
-
-    const double wheel_front_left_vel =
-      1.0 / params_.kinematics.wheels_radius *
-      (velocity_in_center_frame_linear_x_ - velocity_in_center_frame_linear_y_ -
-       params_.kinematics.sum_of_robot_center_projection_on_X_Y_axis *
-         velocity_in_center_frame_angular_z_);
-    const double wheel_front_right_vel =
-      1.0 / params_.kinematics.wheels_radius *
-      (velocity_in_center_frame_linear_x_ + velocity_in_center_frame_linear_y_ +
-       params_.kinematics.sum_of_robot_center_projection_on_X_Y_axis *
-         velocity_in_center_frame_angular_z_);
-    const double wheel_rear_right_vel =
-      1.0 / params_.kinematics.wheels_radius *
-      (velocity_in_center_frame_linear_x_ - velocity_in_center_frame_linear_y_ +
-       params_.kinematics.sum_of_robot_center_projection_on_X_Y_axis *
-         velocity_in_center_frame_angular_z_);
-    const double wheel_rear_left_vel =
-      1.0 / params_.kinematics.wheels_radius *
-      (velocity_in_center_frame_linear_x_ + velocity_in_center_frame_linear_y_ -
-       params_.kinematics.sum_of_robot_center_projection_on_X_Y_axis *
-         velocity_in_center_frame_angular_z_);
+    const InverseKinematicsCacheType::Key twist = {
+      {reference_interfaces_[0], reference_interfaces_[1], reference_interfaces_[2]}};
+    const auto * cached_wheel_velocities =
+      params_.inverse_kinematics_cache.enable ? ik_cache_.lookup(twist) : nullptr;
+    if (cached_wheel_velocities)
+    {
+      std::copy(
+        cached_wheel_velocities->begin(), cached_wheel_velocities->end(),
+        wheel_velocities_.begin());
+    }
+    else
+    {
+      // The offset of the base frame and the wheels parameters are folded into the matrix
+      kinematics_.inverse(twist, wheel_velocities_);
+      if (params_.inverse_kinematics_cache.enable)
+      {
+        ik_cache_.store(
+          twist, {{wheel_velocities_[FRONT_LEFT], wheel_velocities_[FRONT_RIGHT],
+                   wheel_velocities_[REAR_RIGHT], wheel_velocities_[REAR_LEFT]}});
+      }
+    }
+    const double wheel_front_left_vel = wheel_velocities_[FRONT_LEFT];
+    const double wheel_front_right_vel = wheel_velocities_[FRONT_RIGHT];
+    const double wheel_rear_right_vel = wheel_velocities_[REAR_RIGHT];
+    const double wheel_rear_left_vel = wheel_velocities_[REAR_LEFT];
 
     // Set wheels velocities - The joint names are sorted according to the order documented in the
     // header file!
@@ -539,6 +669,11 @@ controller_interface::return_type MecanumDriveController::update_and_write_comma
   reference_interfaces_[1] = std::numeric_limits<double>::quiet_NaN();
   reference_interfaces_[2] = std::numeric_limits<double>::quiet_NaN();
 
+  if (params_.inverse_kinematics_cache.enable)
+  {
+    ik_cache_diagnostics_.publish(time, ik_cache_.hits(), ik_cache_.lookups());
+  }
+
   return controller_interface::return_type::OK;
 }
 
@@ -0,0 +1,172 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mecanum_drive_controller/mecanum_kinematics.hpp"
+
+#include <cmath>
+
+namespace mecanum_drive_controller
+{
+namespace
+{
+using Matrix3 = std::array<std::array<double, 3>, 3>;
+
+// Relative threshold on the determinant of J^T J below which the twist is not determined
+constexpr double kSingularityThreshold = 1e-12;
+// Below this cosine of the roller angle the wheel does not constrain the twist
+constexpr double kMinRollerCosine = 1e-6;
+}  // namespace
+
+bool MecanumKinematics::configure(
+  const std::vector<WheelGeometry> & wheels, const std::array<double, 3> & base_frame_offset)
+{
+  std::vector<std::array<double, 3>> center_rows(wheels.size(), {{0.0, 0.0, 0.0}});
+  for (size_t i = 0; i < wheels.size(); ++i)
+  {
+    const auto & wheel = wheels[i];
+    const double roller_cosine = std::cos(wheel.roller_angle);
+    if (!(wheel.radius > 0.0) || std::abs(roller_cosine) < kMinRollerCosine)
+    {
+      // the zero matrix is singular, compile() leaves the matrices zero
+      center_rows.assign(wheels.size(), {{0.0, 0.0, 0.0}});
+      break;
+    }
+    // the velocity of the contact point projected on the roller axis, scaled to the rolling
+    // direction and divided by the radius
+    const double roller_axis_x = std::cos(wheel.yaw + wheel.roller_angle);
+    const double roller_axis_y = std::sin(wheel.yaw + wheel.roller_angle);
+    const double scale = 1.0 / (wheel.radius * roller_cosine);
+    center_rows[i] = {
+      {scale * roller_axis_x, scale * roller_axis_y,
+       scale * (wheel.x * roller_axis_y - wheel.y * roller_axis_x)}};
+  }
+  return compile(center_rows, base_frame_offset);
+}
+
+bool MecanumKinematics::configure(
+  const std::array<double, 3> & base_frame_offset,
+  double sum_of_robot_center_projection_on_X_Y_axis, double wheels_radius)
+{
+  const double l = sum_of_robot_center_projection_on_X_Y_axis;
+  const double r = wheels_radius;
+  if (!(r > 0.0))
+  {
+    return compile(std::vector<std::array<double, 3>>(4, {{0.0, 0.0, 0.0}}), base_frame_offset);
+  }
+  // the rollers at +-pi/4 written out, so that the matrix holds exactly +-1/r
+  return compile(
+    {{{{1.0 / r, -1.0 / r, -l / r}},
+      {{1.0 / r, 1.0 / r, l / r}},
+      {{1.0 / r, -1.0 / r, l / r}},
+      {{1.0 / r, 1.0 / r, -l / r}}}},
+    base_frame_offset);
+}
+
+bool MecanumKinematics::compile(
+  const std::vector<std::array<double, 3>> & center_to_wheels,
+  const std::array<double, 3> & base_frame_offset)
+{
+  const size_t n = center_to_wheels.size();
+  inverse_matrix_.assign(n, {{0.0, 0.0, 0.0}});
+  for (auto & row : forward_matrix_)
+  {
+    row.assign(n, 0.0);
+  }
+  if (n < 3)
+  {
+    return false;
+  }
+
+  const double x = base_frame_offset[0];
+  const double y = base_frame_offset[1];
+  const double c = std::cos(base_frame_offset[2]);
+  const double s = std::sin(base_frame_offset[2]);
+
+  // base frame twist -> center frame twist: rotate by theta, then the lever arm of the offset
+  const Matrix3 base_to_center = {{{{c, -s, y}}, {{s, c, -x}}, {{0.0, 0.0, 1.0}}}};
+  std::vector<std::array<double, 3>> inverse_matrix(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      inverse_matrix[i][j] = 0.0;
+      for (size_t k = 0; k < 3; ++k)
+      {
+        inverse_matrix[i][j] += center_to_wheels[i][k] * base_to_center[k][j];
+      }
+    }
+  }
+
+  // The forward kinematics are the least-squares solution (J^T J)^-1 J^T of the inverse ones.
+  // Computed for the center frame and then transformed, which keeps them exact for the square
+  // sign patterns of a standard mecanum base.
+  Matrix3 normal = {};
+  for (size_t i = 0; i < n; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      for (size_t k = 0; k < 3; ++k)
+      {
+        normal[j][k] += center_to_wheels[i][j] * center_to_wheels[i][k];
+      }
+    }
+  }
+  const Matrix3 adjugate = {
+    {{{normal[1][1] * normal[2][2] - normal[1][2] * normal[2][1],
+       normal[0][2] * normal[2][1] - normal[0][1] * normal[2][2],
+       normal[0][1] * normal[1][2] - normal[0][2] * normal[1][1]}},
+     {{normal[1][2] * normal[2][0] - normal[1][0] * normal[2][2],
+       normal[0][0] * normal[2][2] - normal[0][2] * normal[2][0],
+       normal[0][2] * normal[1][0] - normal[0][0] * normal[1][2]}},
+     {{normal[1][0] * normal[2][1] - normal[1][1] * normal[2][0],
+       normal[0][1] * normal[2][0] - normal[0][0] * normal[2][1],
+       normal[0][0] * normal[1][1] - normal[0][1] * normal[1][0]}}}};
+  const double determinant =
+    normal[0][0] * adjugate[0][0] + normal[0][1] * adjugate[1][0] + normal[0][2] * adjugate[2][0];
+  const double scale = normal[0][0] * normal[1][1] * normal[2][2];
+  if (!std::isfinite(determinant) || !(std::abs(determinant) > kSingularityThreshold * scale))
+  {
+    return false;
+  }
+
+  // center frame twist -> base frame twist, the inverse of base_to_center
+  const Matrix3 center_to_base = {
+    {{{c, s, s * x - c * y}}, {{-s, c, c * x + s * y}}, {{0.0, 0.0, 1.0}}}};
+  Matrix3 center_to_base_normal_inverse = {};
+  for (size_t i = 0; i < 3; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      for (size_t k = 0; k < 3; ++k)
+      {
+        center_to_base_normal_inverse[i][j] += center_to_base[i][k] * adjugate[k][j];
+      }
+      center_to_base_normal_inverse[i][j] /= determinant;
+    }
+  }
+  for (size_t i = 0; i < 3; ++i)
+  {
+    for (size_t j = 0; j < n; ++j)
+    {
+      for (size_t k = 0; k < 3; ++k)
+      {
+        forward_matrix_[i][j] += center_to_base_normal_inverse[i][k] * center_to_wheels[j][k];
+      }
+    }
+  }
+  inverse_matrix_ = inverse_matrix;
+  return true;
+}
+
+}  // namespace mecanum_drive_controller
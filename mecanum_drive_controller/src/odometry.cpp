@@ -14,19 +14,37 @@
 
 #include "mecanum_drive_controller/odometry.hpp"
 
-#include "tf2/transform_datatypes.hpp"
-#include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace mecanum_drive_controller
 {
+namespace
+{
+// Cauchy weight of a residual normalized by the threshold. It redescends, so that a slipping
+// wheel has almost no influence instead of the bounded one of a Huber weight.
+double cauchy_weight(const double normalized_residual)
+{
+  return 1.0 / (1.0 + normalized_residual * normalized_residual);
+}
+}  // namespace
+
 Odometry::Odometry()
 : timestamp_(0.0),
+  base_frame_offset_({{0.0, 0.0, 0.0}}),
   position_x_in_base_frame_(0.0),
   position_y_in_base_frame_(0.0),
   orientation_z_in_base_frame_(0.0),
   velocity_in_base_frame_linear_x(0.0),
   velocity_in_base_frame_linear_y(0.0),
   velocity_in_base_frame_angular_z(0.0),
+  wheel_velocities_(NUM_WHEELS, 0.0),
+  slip_rejection_enabled_(false),
+  residual_threshold_(1.0),
+  slip_rejection_iterations_(0),
+  prediction_weights_({{1.0, 1.0, 1.0, 1.0}}),
+  wheel_weights_({{1.0, 1.0, 1.0, 1.0}}),
+  wheel_residuals_({{0.0, 0.0, 0.0, 0.0}}),
   sum_of_robot_center_projection_on_X_Y_axis_(0.0),
   wheels_radius_(0.0)
 {
@@ -42,6 +60,18 @@ void Odometry::init(
   base_frame_offset_[0] = base_frame_offset[0];
   base_frame_offset_[1] = base_frame_offset[1];
   base_frame_offset_[2] = base_frame_offset[2];
+
+  kinematics_.configure(
+    base_frame_offset_, sum_of_robot_center_projection_on_X_Y_axis_, wheels_radius_);
+}
+
+void Odometry::resetOdometry() { setPose(0.0, 0.0, 0.0); }
+
+void Odometry::setPose(const double x, const double y, const double rz)
+{
+  position_x_in_base_frame_ = x;
+  position_y_in_base_frame_ = y;
+  orientation_z_in_base_frame_ = rz;
 }
 
 bool Odometry::update(
@@ -60,56 +90,48 @@ bool Odometry::update(
   ///       We prefer this way of doing as filtering introduces delay (which makes it difficult
   ///       to interpret and compare behavior curves).
 
-  /// \note The variables meaning:
-  /// angular_transformation_from_center_2_base: Rotation transformation matrix, to transform
-  /// from center frame to base frame
-  /// linear_transformation_from_center_2_base: offset/linear transformation matrix,
-  /// to transform from center frame to base frame
-
-  double velocity_in_center_frame_linear_x =
-    0.25 * wheels_radius_ *
-    (wheel_front_left_vel + wheel_rear_left_vel + wheel_rear_right_vel + wheel_front_right_vel);
-  double velocity_in_center_frame_linear_y =
-    0.25 * wheels_radius_ *
-    (-wheel_front_left_vel + wheel_rear_left_vel - wheel_rear_right_vel + wheel_front_right_vel);
-  double velocity_in_center_frame_angular_z =
-    0.25 * wheels_radius_ / sum_of_robot_center_projection_on_X_Y_axis_ *
-    (-wheel_front_left_vel - wheel_rear_left_vel + wheel_rear_right_vel + wheel_front_right_vel);
-
-  tf2::Quaternion orientation_R_c_b;
-  orientation_R_c_b.setRPY(0.0, 0.0, -base_frame_offset_[2]);
-
-  tf2::Matrix3x3 angular_transformation_from_center_2_base = tf2::Matrix3x3((orientation_R_c_b));
-  tf2::Vector3 velocity_in_center_frame_w_r_t_base_frame_ =
-    angular_transformation_from_center_2_base *
-    tf2::Vector3(velocity_in_center_frame_linear_x, velocity_in_center_frame_linear_y, 0.0);
-  tf2::Vector3 linear_transformation_from_center_2_base =
-    angular_transformation_from_center_2_base *
-    tf2::Vector3(-base_frame_offset_[0], -base_frame_offset_[1], 0.0);
-
-  velocity_in_base_frame_linear_x =
-    velocity_in_center_frame_w_r_t_base_frame_.x() +
-    linear_transformation_from_center_2_base.y() * velocity_in_center_frame_angular_z;
-  velocity_in_base_frame_linear_y =
-    velocity_in_center_frame_w_r_t_base_frame_.y() -
-    linear_transformation_from_center_2_base.x() * velocity_in_center_frame_angular_z;
-  velocity_in_base_frame_angular_z = velocity_in_center_frame_angular_z;
+  /// \note The kinematics transform the twist from the center frame to the base frame as well.
+  wheel_velocities_[0] = wheel_front_left_vel;
+  wheel_velocities_[1] = wheel_front_right_vel;
+  wheel_velocities_[2] = wheel_rear_right_vel;
+  wheel_velocities_[3] = wheel_rear_left_vel;
+  MecanumKinematics::Twist twist;
+  if (slip_rejection_enabled_)
+  {
+    if (!estimateSlipRobustTwist(twist)) return false;
+  }
+  else
+  {
+    twist = kinematics_.forward(wheel_velocities_);
+  }
+
+  // the residuals are not zero if the wheels are inconsistent, e.g. because of slip
+  const auto & inverse = kinematics_.inverse_matrix();
+  for (size_t i = 0; i < inverse.size(); ++i)
+  {
+    wheel_residuals_[i] = wheel_velocities_[i] - (inverse[i][0] * twist[0] +
+                                                  inverse[i][1] * twist[1] +
+                                                  inverse[i][2] * twist[2]);
+  }
+
+  velocity_in_base_frame_linear_x = twist[0];
+  velocity_in_base_frame_linear_y = twist[1];
+  velocity_in_base_frame_angular_z = twist[2];
 
   /// Integration.
   /// NOTE: the position is expressed in the odometry frame , unlike the twist which is
   ///       expressed in the body frame.
   orientation_z_in_base_frame_ += velocity_in_base_frame_angular_z * dt;
 
-  tf2::Quaternion orientation_R_b_odom;
-  orientation_R_b_odom.setRPY(0.0, 0.0, orientation_z_in_base_frame_);
-
-  tf2::Matrix3x3 angular_transformation_from_base_2_odom = tf2::Matrix3x3((orientation_R_b_odom));
-  tf2::Vector3 velocity_in_base_frame_w_r_t_odom_frame_ =
-    angular_transformation_from_base_2_odom *
-    tf2::Vector3(velocity_in_base_frame_linear_x, velocity_in_base_frame_linear_y, 0.0);
-
-  position_x_in_base_frame_ += velocity_in_base_frame_w_r_t_odom_frame_.x() * dt;
-  position_y_in_base_frame_ += velocity_in_base_frame_w_r_t_odom_frame_.y() * dt;
+  // rotate the body velocity with the new heading into the odometry frame
+  const double cos_heading = std::cos(orientation_z_in_base_frame_);
+  const double sin_heading = std::sin(orientation_z_in_base_frame_);
+  position_x_in_base_frame_ += (cos_heading * velocity_in_base_frame_linear_x -
+                                sin_heading * velocity_in_base_frame_linear_y) *
+                               dt;
+  position_y_in_base_frame_ += (sin_heading * velocity_in_base_frame_linear_x +
+                                cos_heading * velocity_in_base_frame_linear_y) *
+                               dt;
 
   return true;
 }
@@ -119,6 +141,100 @@ void Odometry::setWheelsParams(
 {
   sum_of_robot_center_projection_on_X_Y_axis_ = sum_of_robot_center_projection_on_X_Y_axis;
   wheels_radius_ = wheels_radius;
+
+  kinematics_.configure(
+    base_frame_offset_, sum_of_robot_center_projection_on_X_Y_axis_, wheels_radius_);
+}
+
+void Odometry::setSlipRejection(
+  const bool enable, const double residual_threshold, const size_t iterations)
+{
+  slip_rejection_enabled_ = enable;
+  residual_threshold_ = residual_threshold;
+  slip_rejection_iterations_ = iterations;
+  wheel_weights_.fill(1.0);
+}
+
+bool Odometry::estimateSlipRobustTwist(MecanumKinematics::Twist & twist)
+{
+  const auto & inverse = kinematics_.inverse_matrix();
+  if (inverse.size() != NUM_WHEELS) return false;
+
+  // A wheel whose velocity jumps away from the one predicted by the last twist is most likely
+  // slipping. This also decides which wheel to blame: with four wheels and three degrees of
+  // freedom, any single wheel explains the inconsistency equally well.
+  for (size_t i = 0; i < NUM_WHEELS; ++i)
+  {
+    if (!std::isfinite(wheel_velocities_[i]))
+    {
+      prediction_weights_[i] = 0.0;
+      continue;
+    }
+    const double predicted = inverse[i][0] * velocity_in_base_frame_linear_x +
+                             inverse[i][1] * velocity_in_base_frame_linear_y +
+                             inverse[i][2] * velocity_in_base_frame_angular_z;
+    prediction_weights_[i] =
+      cauchy_weight((wheel_velocities_[i] - predicted) / residual_threshold_);
+  }
+  wheel_weights_ = prediction_weights_;
+
+  if (!solveWeighted(twist)) return false;
+  for (size_t iteration = 0; iteration < slip_rejection_iterations_; ++iteration)
+  {
+    for (size_t i = 0; i < NUM_WHEELS; ++i)
+    {
+      if (prediction_weights_[i] == 0.0) continue;
+      const double residual = wheel_velocities_[i] - (inverse[i][0] * twist[0] +
+                                                      inverse[i][1] * twist[1] +
+                                                      inverse[i][2] * twist[2]);
+      wheel_weights_[i] =
+        std::min(prediction_weights_[i], cauchy_weight(residual / residual_threshold_));
+    }
+    if (!solveWeighted(twist)) return false;
+  }
+  return true;
+}
+
+bool Odometry::solveWeighted(MecanumKinematics::Twist & twist) const
+{
+  const auto & inverse = kinematics_.inverse_matrix();
+
+  // normal equations (J^T W J) twist = J^T W wheel_velocities
+  std::array<std::array<double, 3>, 3> normal = {};
+  std::array<double, 3> rhs = {{0.0, 0.0, 0.0}};
+  for (size_t i = 0; i < NUM_WHEELS; ++i)
+  {
+    if (wheel_weights_[i] == 0.0) continue;
+    for (size_t j = 0; j < 3; ++j)
+    {
+      const double weighted = wheel_weights_[i] * inverse[i][j];
+      rhs[j] += weighted * wheel_velocities_[i];
+      for (size_t k = 0; k < 3; ++k)
+      {
+        normal[j][k] += weighted * inverse[i][k];
+      }
+    }
+  }
+
+  // Cramer's rule, the matrix is 3x3
+  const double c00 = normal[1][1] * normal[2][2] - normal[1][2] * normal[2][1];
+  const double c01 = normal[1][2] * normal[2][0] - normal[1][0] * normal[2][2];
+  const double c02 = normal[1][0] * normal[2][1] - normal[1][1] * normal[2][0];
+  const double determinant = normal[0][0] * c00 + normal[0][1] * c01 + normal[0][2] * c02;
+  if (!(std::abs(determinant) > 1e-12 * normal[0][0] * normal[1][1] * normal[2][2]))
+  {
+    return false;
+  }
+  twist[0] = (rhs[0] * c00 + normal[0][1] * (rhs[2] * normal[1][2] - rhs[1] * normal[2][2]) +
+              normal[0][2] * (rhs[1] * normal[2][1] - rhs[2] * normal[1][1])) /
+             determinant;
+  twist[1] = (normal[0][0] * (rhs[1] * normal[2][2] - rhs[2] * normal[1][2]) + rhs[0] * c01 +
+              normal[0][2] * (rhs[2] * normal[1][0] - rhs[1] * normal[2][0])) /
+             determinant;
+  twist[2] = (normal[0][0] * (rhs[2] * normal[1][1] - rhs[1] * normal[2][1]) +
+              normal[0][1] * (rhs[1] * normal[2][0] - rhs[2] * normal[1][0]) + rhs[0] * c02) /
+             determinant;
+  return true;
 }
 
 }  // namespace mecanum_drive_controller
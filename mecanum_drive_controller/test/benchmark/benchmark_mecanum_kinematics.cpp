@@ -0,0 +1,197 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "mecanum_drive_controller/mecanum_kinematics.hpp"
+#include "mecanum_drive_controller/odometry.hpp"
+#include "tf2/LinearMath/Matrix3x3.hpp"
+#include "tf2/LinearMath/Quaternion.hpp"
+#include "tf2/LinearMath/Vector3.hpp"
+
+namespace
+{
+using mecanum_drive_controller::MecanumKinematics;
+
+const std::array<double, 3> kBaseFrameOffset = {{0.1, -0.05, 0.3}};
+constexpr double kSumOfRobotCenterProjection = 0.45;
+constexpr double kWheelsRadius = 0.05;
+
+// precomputed so that only the kinematics are measured
+template <size_t N>
+std::vector<std::array<double, N>> make_inputs()
+{
+  std::vector<std::array<double, N>> inputs(1024);
+  for (size_t i = 0; i < inputs.size(); ++i)
+  {
+    for (size_t c = 0; c < N; ++c)
+    {
+      inputs[i][c] = std::sin(0.001 * static_cast<double>(i) + static_cast<double>(c));
+    }
+  }
+  return inputs;
+}
+
+// The inverse kinematics as evaluated every cycle by the controller before they were compiled
+std::array<double, 4> legacy_inverse(const MecanumKinematics::Twist & twist)
+{
+  tf2::Quaternion quaternion;
+  quaternion.setRPY(0.0, 0.0, kBaseFrameOffset[2]);
+  tf2::Matrix3x3 rotation_from_base_to_center = tf2::Matrix3x3((quaternion));
+  tf2::Vector3 velocity_in_base_frame_w_r_t_center_frame =
+    rotation_from_base_to_center * tf2::Vector3(twist[0], twist[1], 0.0);
+  const double vx = velocity_in_base_frame_w_r_t_center_frame.x() + kBaseFrameOffset[1] * twist[2];
+  const double vy = velocity_in_base_frame_w_r_t_center_frame.y() - kBaseFrameOffset[0] * twist[2];
+  const double wz = twist[2];
+  const double l = kSumOfRobotCenterProjection;
+  return {
+    {1.0 / kWheelsRadius * (vx - vy - l * wz), 1.0 / kWheelsRadius * (vx + vy + l * wz),
+     1.0 / kWheelsRadius * (vx - vy + l * wz), 1.0 / kWheelsRadius * (vx + vy - l * wz)}};
+}
+
+// The forward kinematics as evaluated every cycle by the odometry before they were compiled
+MecanumKinematics::Twist legacy_forward(const std::array<double, 4> & w)
+{
+  const double vx = 0.25 * kWheelsRadius * (w[0] + w[3] + w[2] + w[1]);
+  const double vy = 0.25 * kWheelsRadius * (-w[0] + w[3] - w[2] + w[1]);
+  const double wz =
+    0.25 * kWheelsRadius / kSumOfRobotCenterProjection * (-w[0] - w[3] + w[2] + w[1]);
+
+  tf2::Quaternion orientation_R_c_b;
+  orientation_R_c_b.setRPY(0.0, 0.0, -kBaseFrameOffset[2]);
+  tf2::Matrix3x3 angular_transformation_from_center_2_base = tf2::Matrix3x3((orientation_R_c_b));
+  tf2::Vector3 velocity_in_center_frame_w_r_t_base_frame =
+    angular_transformation_from_center_2_base * tf2::Vector3(vx, vy, 0.0);
+  tf2::Vector3 linear_transformation_from_center_2_base =
+    angular_transformation_from_center_2_base *
+    tf2::Vector3(-kBaseFrameOffset[0], -kBaseFrameOffset[1], 0.0);
+  return {
+    {velocity_in_center_frame_w_r_t_base_frame.x() +
+       linear_transformation_from_center_2_base.y() * wz,
+     velocity_in_center_frame_w_r_t_base_frame.y() -
+       linear_transformation_from_center_2_base.x() * wz,
+     wz}};
+}
+
+void BM_LegacyInverseKinematics(benchmark::State & state)
+{
+  const auto twists = make_inputs<3>();
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(legacy_inverse(twists[i]));
+    i = (i + 1) % twists.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LegacyInverseKinematics);
+
+void BM_InverseKinematics(benchmark::State & state)
+{
+  MecanumKinematics kinematics;
+  kinematics.configure(kBaseFrameOffset, kSumOfRobotCenterProjection, kWheelsRadius);
+  const auto twists = make_inputs<3>();
+  std::vector<double> wheel_velocities(kinematics.size());
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    kinematics.inverse(twists[i], wheel_velocities);
+    benchmark::DoNotOptimize(wheel_velocities.data());
+    benchmark::ClobberMemory();
+    i = (i + 1) % twists.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InverseKinematics);
+
+void BM_LegacyForwardKinematics(benchmark::State & state)
+{
+  const auto wheels = make_inputs<4>();
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(legacy_forward(wheels[i]));
+    i = (i + 1) % wheels.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LegacyForwardKinematics);
+
+void BM_ForwardKinematics(benchmark::State & state)
+{
+  MecanumKinematics kinematics;
+  kinematics.configure(kBaseFrameOffset, kSumOfRobotCenterProjection, kWheelsRadius);
+  const auto inputs = make_inputs<4>();
+  std::vector<std::vector<double>> wheels(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i)
+  {
+    wheels[i].assign(inputs[i].begin(), inputs[i].end());
+  }
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(kinematics.forward(wheels[i]));
+    i = (i + 1) % wheels.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ForwardKinematics);
+
+// Inverse and forward kinematics of a six wheel base, the number of wheels of the matrices is
+// only known at runtime
+void BM_SixWheelKinematics(benchmark::State & state)
+{
+  const double r = kWheelsRadius;
+  const std::vector<mecanum_drive_controller::WheelGeometry> geometry = {
+    {0.4, 0.25, 0.0, -M_PI_4, r}, {0.4, -0.25, 0.0, M_PI_4, r},  {0.0, -0.25, 0.0, -M_PI_4, r},
+    {-0.4, -0.25, 0.0, M_PI_4, r}, {-0.4, 0.25, 0.0, -M_PI_4, r}, {0.0, 0.25, 0.0, M_PI_4, r}};
+  MecanumKinematics kinematics;
+  kinematics.configure(geometry, kBaseFrameOffset);
+  const auto twists = make_inputs<3>();
+  std::vector<double> wheel_velocities(kinematics.size());
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    kinematics.inverse(twists[i], wheel_velocities);
+    benchmark::DoNotOptimize(kinematics.forward(wheel_velocities));
+    i = (i + 1) % twists.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SixWheelKinematics);
+
+// Forward kinematics and heading integration, as done by the controller every cycle
+void BM_OdometryUpdate(benchmark::State & state)
+{
+  mecanum_drive_controller::Odometry odometry;
+  odometry.init(rclcpp::Time(0), kBaseFrameOffset);
+  odometry.setWheelsParams(kSumOfRobotCenterProjection, kWheelsRadius);
+  const auto wheels = make_inputs<4>();
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    const auto & w = wheels[i];
+    benchmark::DoNotOptimize(odometry.update(w[0], w[3], w[2], w[1], 0.001));
+    i = (i + 1) % wheels.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OdometryUpdate);
+}  // namespace
+
+BENCHMARK_MAIN();
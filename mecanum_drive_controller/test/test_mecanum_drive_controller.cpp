@@ -21,6 +21,8 @@
 #include <vector>
 
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "tf2/LinearMath/Quaternion.hpp"
+#include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 
 using mecanum_drive_controller::NR_CMD_ITFS;
 using mecanum_drive_controller::NR_REF_ITFS;
@@ -808,6 +810,106 @@ TEST_F(MecanumDriveControllerTest, SideToSideAndRotationOdometryTest)
   EXPECT_LT(std::abs(controller_->odometry_.getRz()), M_PI);
 }
 
+TEST_F(MecanumDriveControllerTest, odometry_reset_is_applied_by_the_next_update)
+{
+  SetUpController();
+
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  // standing wheels, so that the odometry does not move
+  joint_state_values_.fill(0.0);
+
+  auto pose_msg = [](double x, double y, double rz, const std::string & frame_id)
+  {
+    auto msg = std::make_shared<geometry_msgs::msg::PoseWithCovarianceStamped>();
+    msg->header.frame_id = frame_id;
+    msg->pose.pose.position.x = x;
+    msg->pose.pose.position.y = y;
+    tf2::Quaternion orientation;
+    orientation.setRPY(0.0, 0.0, rz);
+    msg->pose.pose.orientation = tf2::toMsg(orientation);
+    return msg;
+  };
+
+  controller_->set_odometry_pose(pose_msg(1.0, -2.0, 0.5, "odom"));
+  // the callbacks only hand the request over
+  EXPECT_EQ(controller_->odometry_.getX(), 0.0);
+
+  ASSERT_EQ(
+    controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_DOUBLE_EQ(controller_->odometry_.getX(), 1.0);
+  EXPECT_DOUBLE_EQ(controller_->odometry_.getY(), -2.0);
+  EXPECT_NEAR(controller_->odometry_.getRz(), 0.5, 1e-12);
+
+  // a pose in another frame is ignored
+  controller_->set_odometry_pose(pose_msg(3.0, 3.0, 0.0, "map"));
+  ASSERT_EQ(
+    controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_DOUBLE_EQ(controller_->odometry_.getX(), 1.0);
+
+  // the latest request replaces the one which was not applied yet
+  controller_->set_odometry_pose(pose_msg(2.0, 2.0, 1.0, "odom"));
+  controller_->reset_odometry(nullptr, nullptr, nullptr);
+  ASSERT_EQ(
+    controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(controller_->odometry_.getX(), 0.0);
+  EXPECT_EQ(controller_->odometry_.getY(), 0.0);
+  EXPECT_EQ(controller_->odometry_.getRz(), 0.0);
+
+  // a request which was not applied before the deactivation is discarded
+  controller_->set_odometry_pose(pose_msg(2.0, 2.0, 1.0, "odom"));
+  ASSERT_EQ(controller_->on_deactivate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(
+    controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(controller_->odometry_.getX(), 0.0);
+}
+
+TEST_F(MecanumDriveControllerTest, inverse_kinematics_cache_skips_steady_reference)
+{
+  rclcpp::NodeOptions node_options;
+  node_options.parameter_overrides({{"inverse_kinematics_cache.enable", true}});
+  SetUpController("test_mecanum_drive_controller", node_options);
+
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  controller_->set_chained_mode(true);
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+
+  // imitate a preceding controller setting the same reference in each cycle
+  auto update = [this](double linear_x, double linear_y, double angular_z)
+  {
+    controller_->reference_interfaces_[0] = linear_x;
+    controller_->reference_interfaces_[1] = linear_y;
+    controller_->reference_interfaces_[2] = angular_z;
+    ASSERT_EQ(
+      controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
+      controller_interface::return_type::OK);
+  };
+
+  update(1.0, 0.5, 0.2);
+  const std::vector<double> computed_commands(
+    joint_command_values_.begin(), joint_command_values_.end());
+  for (int i = 0; i < 5; ++i)
+  {
+    update(1.0, 0.5, 0.2);
+    for (size_t j = 0; j < computed_commands.size(); ++j)
+    {
+      EXPECT_EQ(joint_command_values_[j], computed_commands[j]);
+    }
+  }
+  EXPECT_EQ(controller_->ik_cache_.hits(), 5u);
+  EXPECT_EQ(controller_->ik_cache_.lookups(), 6u);
+
+  // a changed reference is computed again
+  update(1.0, 0.5, -0.2);
+  EXPECT_EQ(controller_->ik_cache_.hits(), 5u);
+  EXPECT_NE(joint_command_values_[controller_->get_front_left_wheel_index()], computed_commands[0]);
+}
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -83,6 +83,8 @@ class TestableMecanumDriveController : public mecanum_drive_controller::MecanumD
     MecanumDriveControllerTest,
     when_ref_timeout_zero_for_reference_callback_expect_reference_msg_being_used_only_once);
   FRIEND_TEST(MecanumDriveControllerTest, SideToSideAndRotationOdometryTest);
+  FRIEND_TEST(MecanumDriveControllerTest, odometry_reset_is_applied_by_the_next_update);
+  FRIEND_TEST(MecanumDriveControllerTest, inverse_kinematics_cache_skips_steady_reference);
 
 public:
   controller_interface::CallbackReturn on_configure(
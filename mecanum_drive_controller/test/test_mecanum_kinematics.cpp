@@ -0,0 +1,328 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "mecanum_drive_controller/mecanum_kinematics.hpp"
+#include "mecanum_drive_controller/odometry.hpp"
+#include "rclcpp/time.hpp"
+
+using mecanum_drive_controller::MecanumKinematics;
+using mecanum_drive_controller::Odometry;
+using mecanum_drive_controller::WheelGeometry;
+
+namespace
+{
+constexpr double kTolerance = 1e-12;
+
+struct Geometry
+{
+  std::array<double, 3> base_frame_offset;
+  double sum_of_robot_center_projection_on_X_Y_axis;
+  double wheels_radius;
+};
+
+// The kinematics as evaluated every cycle before they were compiled into matrices, the wheel
+// velocities are sorted as front left, front right, rear right, rear left.
+std::vector<double> legacy_inverse(const Geometry & g, const MecanumKinematics::Twist & twist)
+{
+  const double c = std::cos(g.base_frame_offset[2]);
+  const double s = std::sin(g.base_frame_offset[2]);
+  const double vx = c * twist[0] - s * twist[1] + g.base_frame_offset[1] * twist[2];
+  const double vy = s * twist[0] + c * twist[1] - g.base_frame_offset[0] * twist[2];
+  const double wz = twist[2];
+  const double l = g.sum_of_robot_center_projection_on_X_Y_axis;
+  const double r = g.wheels_radius;
+  return {
+    1.0 / r * (vx - vy - l * wz), 1.0 / r * (vx + vy + l * wz), 1.0 / r * (vx - vy + l * wz),
+    1.0 / r * (vx + vy - l * wz)};
+}
+
+MecanumKinematics::Twist legacy_forward(const Geometry & g, const std::vector<double> & w)
+{
+  const double r = g.wheels_radius;
+  const double l = g.sum_of_robot_center_projection_on_X_Y_axis;
+  const double vx = 0.25 * r * (w[0] + w[3] + w[2] + w[1]);
+  const double vy = 0.25 * r * (-w[0] + w[3] - w[2] + w[1]);
+  const double wz = 0.25 * r / l * (-w[0] - w[3] + w[2] + w[1]);
+  // rotation by -theta, from center to base frame
+  const double c = std::cos(-g.base_frame_offset[2]);
+  const double s = std::sin(-g.base_frame_offset[2]);
+  const double offset_x = c * -g.base_frame_offset[0] - s * -g.base_frame_offset[1];
+  const double offset_y = s * -g.base_frame_offset[0] + c * -g.base_frame_offset[1];
+  return {{c * vx - s * vy + offset_y * wz, s * vx + c * vy - offset_x * wz, wz}};
+}
+
+// The four wheels of the legacy geometry, with lx = ly
+std::vector<WheelGeometry> four_wheel_geometry(const Geometry & g)
+{
+  const double half = 0.5 * g.sum_of_robot_center_projection_on_X_Y_axis;
+  const double r = g.wheels_radius;
+  return {
+    {half, half, 0.0, -M_PI_4, r},
+    {half, -half, 0.0, M_PI_4, r},
+    {-half, -half, 0.0, -M_PI_4, r},
+    {-half, half, 0.0, M_PI_4, r}};
+}
+
+class RandomInputs
+{
+protected:
+  std::mt19937 generator_{42};
+  std::uniform_real_distribution<double> distribution_{-5.0, 5.0};
+
+  double random() { return distribution_(generator_); }
+};
+
+class MecanumKinematicsTest : public ::testing::TestWithParam<Geometry>, public RandomInputs
+{
+};
+
+class NWheelKinematicsTest : public ::testing::Test, public RandomInputs
+{
+};
+}  // namespace
+
+TEST_P(MecanumKinematicsTest, inverse_matches_legacy_formulas)
+{
+  const auto & g = GetParam();
+  MecanumKinematics kinematics;
+  ASSERT_TRUE(kinematics.configure(
+    g.base_frame_offset, g.sum_of_robot_center_projection_on_X_Y_axis, g.wheels_radius));
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    const MecanumKinematics::Twist twist = {{random(), random(), random()}};
+    const auto expected = legacy_inverse(g, twist);
+    std::vector<double> actual(kinematics.size());
+    kinematics.inverse(twist, actual);
+    for (size_t j = 0; j < actual.size(); ++j)
+    {
+      EXPECT_NEAR(actual[j], expected[j], kTolerance * (1.0 + std::abs(expected[j])));
+    }
+  }
+}
+
+TEST_P(MecanumKinematicsTest, forward_matches_legacy_formulas)
+{
+  const auto & g = GetParam();
+  MecanumKinematics kinematics;
+  ASSERT_TRUE(kinematics.configure(
+    g.base_frame_offset, g.sum_of_robot_center_projection_on_X_Y_axis, g.wheels_radius));
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    const std::vector<double> wheels = {random(), random(), random(), random()};
+    const auto expected = legacy_forward(g, wheels);
+    const auto actual = kinematics.forward(wheels);
+    for (size_t j = 0; j < actual.size(); ++j)
+    {
+      EXPECT_NEAR(actual[j], expected[j], kTolerance * (1.0 + std::abs(expected[j])));
+    }
+  }
+}
+
+TEST_P(MecanumKinematicsTest, forward_inverts_inverse)
+{
+  const auto & g = GetParam();
+  MecanumKinematics kinematics;
+  ASSERT_TRUE(kinematics.configure(
+    g.base_frame_offset, g.sum_of_robot_center_projection_on_X_Y_axis, g.wheels_radius));
+
+  for (int i = 0; i < 100; ++i)
+  {
+    const MecanumKinematics::Twist twist = {{random(), random(), random()}};
+    std::vector<double> wheels(kinematics.size());
+    kinematics.inverse(twist, wheels);
+    const auto actual = kinematics.forward(wheels);
+    for (size_t j = 0; j < actual.size(); ++j)
+    {
+      EXPECT_NEAR(actual[j], twist[j], kTolerance * 10.0);
+    }
+  }
+}
+
+TEST_P(MecanumKinematicsTest, wheel_geometry_matches_four_wheel_parameters)
+{
+  const auto & g = GetParam();
+  MecanumKinematics expected;
+  ASSERT_TRUE(expected.configure(
+    g.base_frame_offset, g.sum_of_robot_center_projection_on_X_Y_axis, g.wheels_radius));
+  MecanumKinematics actual;
+  ASSERT_TRUE(actual.configure(four_wheel_geometry(g), g.base_frame_offset));
+
+  ASSERT_EQ(actual.size(), 4u);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      const double inverse = expected.inverse_matrix()[i][j];
+      EXPECT_NEAR(actual.inverse_matrix()[i][j], inverse, kTolerance * (1.0 + std::abs(inverse)));
+      const double forward = expected.forward_matrix()[j][i];
+      EXPECT_NEAR(actual.forward_matrix()[j][i], forward, kTolerance * (1.0 + std::abs(forward)));
+    }
+  }
+}
+
+TEST_P(MecanumKinematicsTest, odometry_matches_legacy_integration)
+{
+  const auto & g = GetParam();
+  Odometry odometry;
+  odometry.init(rclcpp::Time(0), g.base_frame_offset);
+  odometry.setWheelsParams(g.sum_of_robot_center_projection_on_X_Y_axis, g.wheels_radius);
+
+  double x = 0.0;
+  double y = 0.0;
+  double heading = 0.0;
+  const double dt = 0.01;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const std::vector<double> wheels = {random(), random(), random(), random()};
+    ASSERT_TRUE(odometry.update(wheels[0], wheels[3], wheels[2], wheels[1], dt));
+
+    const auto twist = legacy_forward(g, wheels);
+    heading += twist[2] * dt;
+    x += (std::cos(heading) * twist[0] - std::sin(heading) * twist[1]) * dt;
+    y += (std::sin(heading) * twist[0] + std::cos(heading) * twist[1]) * dt;
+
+    EXPECT_NEAR(odometry.getVx(), twist[0], kTolerance * (1.0 + std::abs(twist[0])));
+    EXPECT_NEAR(odometry.getVy(), twist[1], kTolerance * (1.0 + std::abs(twist[1])));
+    EXPECT_NEAR(odometry.getWz(), twist[2], kTolerance * (1.0 + std::abs(twist[2])));
+  }
+  // the rounding errors of the twist accumulate over the integration
+  EXPECT_NEAR(odometry.getRz(), heading, 1e-9);
+  EXPECT_NEAR(odometry.getX(), x, 1e-9);
+  EXPECT_NEAR(odometry.getY(), y, 1e-9);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  MecanumGeometries, MecanumKinematicsTest,
+  ::testing::Values(
+    // the geometry of the controller tests
+    Geometry{{{0.0, 0.0, 0.0}}, 1.0, 0.5},
+    Geometry{{{0.1, -0.2, 0.0}}, 0.45, 0.05},
+    Geometry{{{-0.3, 0.25, 0.7}}, 0.6, 0.075},
+    Geometry{{{0.0, 0.0, -2.5}}, 0.35, 0.1}));
+
+TEST_F(NWheelKinematicsTest, three_wheel_omni_base)
+{
+  // wheels on a circle of radius 0.2 at 90, 210 and 330 deg, rolling tangentially
+  const double distance = 0.2;
+  const double radius = 0.04;
+  const std::array<double, 3> angles = {{M_PI / 2.0, 7.0 * M_PI / 6.0, 11.0 * M_PI / 6.0}};
+  std::vector<WheelGeometry> wheels;
+  for (const double angle : angles)
+  {
+    wheels.push_back(
+      {distance * std::cos(angle), distance * std::sin(angle), angle + M_PI / 2.0, 0.0, radius});
+  }
+  MecanumKinematics kinematics;
+  ASSERT_TRUE(kinematics.configure(wheels, {{0.0, 0.0, 0.0}}));
+  ASSERT_EQ(kinematics.size(), 3u);
+
+  std::vector<double> wheel_velocities(3);
+  for (int i = 0; i < 100; ++i)
+  {
+    const MecanumKinematics::Twist twist = {{random(), random(), random()}};
+    kinematics.inverse(twist, wheel_velocities);
+    for (size_t j = 0; j < angles.size(); ++j)
+    {
+      const double expected =
+        (-std::sin(angles[j]) * twist[0] + std::cos(angles[j]) * twist[1] + distance * twist[2]) /
+        radius;
+      EXPECT_NEAR(wheel_velocities[j], expected, 1e-10);
+    }
+    const auto actual = kinematics.forward(wheel_velocities);
+    for (size_t j = 0; j < actual.size(); ++j)
+    {
+      EXPECT_NEAR(actual[j], twist[j], 1e-10);
+    }
+  }
+}
+
+TEST_F(NWheelKinematicsTest, six_wheel_mecanum_base_is_least_squares)
+{
+  const double r = 0.05;
+  const std::vector<WheelGeometry> wheels = {
+    {0.4, 0.25, 0.0, -M_PI_4, r}, {0.4, -0.25, 0.0, M_PI_4, r},  {0.0, -0.25, 0.0, -M_PI_4, r},
+    {-0.4, -0.25, 0.0, M_PI_4, r}, {-0.4, 0.25, 0.0, -M_PI_4, r}, {0.0, 0.25, 0.0, M_PI_4, r}};
+  MecanumKinematics kinematics;
+  ASSERT_TRUE(kinematics.configure(wheels, {{0.1, 0.05, 0.2}}));
+  ASSERT_EQ(kinematics.size(), 6u);
+
+  std::vector<double> wheel_velocities(6);
+  for (int i = 0; i < 100; ++i)
+  {
+    const MecanumKinematics::Twist twist = {{random(), random(), random()}};
+    kinematics.inverse(twist, wheel_velocities);
+    auto actual = kinematics.forward(wheel_velocities);
+    for (size_t j = 0; j < actual.size(); ++j)
+    {
+      EXPECT_NEAR(actual[j], twist[j], 1e-10);
+    }
+
+    // with inconsistent wheels the residual is orthogonal to the columns of the inverse matrix
+    for (auto & velocity : wheel_velocities)
+    {
+      velocity += random();
+    }
+    actual = kinematics.forward(wheel_velocities);
+    std::vector<double> fitted(6);
+    kinematics.inverse(actual, fitted);
+    for (size_t j = 0; j < 3; ++j)
+    {
+      double projection = 0.0;
+      for (size_t k = 0; k < wheels.size(); ++k)
+      {
+        projection += kinematics.inverse_matrix()[k][j] * (wheel_velocities[k] - fitted[k]);
+      }
+      EXPECT_NEAR(projection, 0.0, 1e-9);
+    }
+  }
+}
+
+TEST_F(NWheelKinematicsTest, undetermined_geometry_is_rejected)
+{
+  MecanumKinematics kinematics;
+  const std::array<double, 3> offset = {{0.0, 0.0, 0.0}};
+
+  // all omni wheels rolling in x cannot observe y
+  EXPECT_FALSE(kinematics.configure(
+    {{0.2, 0.2, 0.0, 0.0, 0.05}, {-0.2, 0.2, 0.0, 0.0, 0.05}, {0.0, -0.2, 0.0, 0.0, 0.05}},
+    offset));
+  // rollers along the wheel axle
+  EXPECT_FALSE(kinematics.configure(
+    {{0.2, 0.2, 0.0, M_PI / 2.0, 0.05},
+     {-0.2, 0.2, M_PI / 2.0, 0.0, 0.05},
+     {0.0, -0.2, 0.0, 0.0, 0.05}},
+    offset));
+  // two wheels
+  EXPECT_FALSE(
+    kinematics.configure({{0.2, 0.2, 0.0, 0.0, 0.05}, {-0.2, 0.2, 1.0, 0.0, 0.05}}, offset));
+  // zero radius or zero lx + ly
+  EXPECT_FALSE(kinematics.configure(offset, 0.45, 0.0));
+  EXPECT_FALSE(kinematics.configure(offset, 0.0, 0.05));
+
+  // the matrices are zero then
+  ASSERT_EQ(kinematics.size(), 4u);
+  std::vector<double> wheel_velocities(4, 1.0);
+  kinematics.inverse({{1.0, 2.0, 3.0}}, wheel_velocities);
+  EXPECT_THAT(wheel_velocities, ::testing::Each(0.0));
+  EXPECT_THAT(kinematics.forward({1.0, 2.0, 3.0, 4.0}), ::testing::Each(0.0));
+}
@@ -0,0 +1,176 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "mecanum_drive_controller/mecanum_kinematics.hpp"
+#include "mecanum_drive_controller/odometry.hpp"
+#include "rclcpp/time.hpp"
+
+using mecanum_drive_controller::MecanumKinematics;
+using mecanum_drive_controller::Odometry;
+
+namespace
+{
+const std::array<double, 3> kBaseFrameOffset = {{0.1, -0.05, 0.3}};
+constexpr double kSumOfRobotCenterProjection = 0.45;
+constexpr double kWheelsRadius = 0.05;
+constexpr double kDt = 0.01;
+
+class OdometryTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    odometry_.init(rclcpp::Time(0), kBaseFrameOffset);
+    odometry_.setWheelsParams(kSumOfRobotCenterProjection, kWheelsRadius);
+    ASSERT_TRUE(
+      kinematics_.configure(kBaseFrameOffset, kSumOfRobotCenterProjection, kWheelsRadius));
+  }
+
+  // wheel velocities sorted as front left, front right, rear right, rear left
+  std::vector<double> wheels_of(const MecanumKinematics::Twist & twist) const
+  {
+    std::vector<double> wheels(4);
+    kinematics_.inverse(twist, wheels);
+    return wheels;
+  }
+
+  bool update(const std::vector<double> & wheels)
+  {
+    return odometry_.update(wheels[0], wheels[3], wheels[2], wheels[1], kDt);
+  }
+
+  double twist_error(const MecanumKinematics::Twist & twist) const
+  {
+    return std::hypot(
+      odometry_.getVx() - twist[0], odometry_.getVy() - twist[1], odometry_.getWz() - twist[2]);
+  }
+
+  Odometry odometry_;
+  MecanumKinematics kinematics_;
+  const MecanumKinematics::Twist twist_ = {{0.8, -0.3, 0.5}};
+};
+}  // namespace
+
+TEST_F(OdometryTest, consistent_wheels_have_zero_residuals)
+{
+  odometry_.setSlipRejection(true, 1.0, 2);
+  const auto wheels = wheels_of(twist_);
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(update(wheels));
+    EXPECT_NEAR(twist_error(twist_), 0.0, 1e-12);
+    EXPECT_THAT(
+      odometry_.getWheelResiduals(), ::testing::Each(::testing::DoubleNear(0.0, 1e-10)));
+  }
+  // steady wheels match their prediction
+  EXPECT_THAT(odometry_.getWheelWeights(), ::testing::Each(1.0));
+}
+
+TEST_F(OdometryTest, slip_rejection_down_weights_slipping_wheel)
+{
+  Odometry least_squares = odometry_;
+  odometry_.setSlipRejection(true, 1.0, 2);
+
+  auto wheels = wheels_of(twist_);
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(update(wheels));
+    ASSERT_TRUE(least_squares.update(wheels[0], wheels[3], wheels[2], wheels[1], kDt));
+  }
+
+  // the rear right wheel spins up
+  wheels[2] += 20.0;
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(update(wheels));
+    ASSERT_TRUE(least_squares.update(wheels[0], wheels[3], wheels[2], wheels[1], kDt));
+
+    const double least_squares_error = std::hypot(
+      least_squares.getVx() - twist_[0], least_squares.getVy() - twist_[1],
+      least_squares.getWz() - twist_[2]);
+    EXPECT_LT(twist_error(twist_), 0.05 * least_squares_error);
+
+    const auto & weights = odometry_.getWheelWeights();
+    EXPECT_LT(weights[2], 0.01);
+    EXPECT_GT(weights[0], 0.9);
+    EXPECT_GT(weights[1], 0.9);
+    EXPECT_GT(weights[3], 0.9);
+
+    // the inconsistency is attributed to the slipping wheel
+    const auto & residuals = odometry_.getWheelResiduals();
+    EXPECT_GT(std::abs(residuals[2]), 10.0);
+    EXPECT_LT(std::abs(residuals[0]), 0.1 * std::abs(residuals[2]));
+  }
+  // the plain least-squares estimate spreads the slip over all wheels
+  const auto & residuals = least_squares.getWheelResiduals();
+  EXPECT_NEAR(std::abs(residuals[0]), std::abs(residuals[2]), 1e-9);
+}
+
+TEST_F(OdometryTest, slip_rejection_ignores_nan_wheel)
+{
+  odometry_.setSlipRejection(true, 1.0, 2);
+  auto wheels = wheels_of(twist_);
+  wheels[1] = std::numeric_limits<double>::quiet_NaN();
+
+  ASSERT_TRUE(update(wheels));
+  EXPECT_NEAR(twist_error(twist_), 0.0, 1e-12);
+  EXPECT_TRUE(std::isnan(odometry_.getWheelResiduals()[1]));
+  EXPECT_EQ(odometry_.getWheelWeights()[1], 0.0);
+
+  // three wheels are needed
+  const double x = odometry_.getX();
+  wheels[3] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(update(wheels));
+  EXPECT_EQ(odometry_.getX(), x);
+}
+
+TEST_F(OdometryTest, disabled_slip_rejection_is_plain_least_squares)
+{
+  auto wheels = wheels_of(twist_);
+  wheels[2] += 20.0;
+  ASSERT_TRUE(update(wheels));
+
+  const auto expected = kinematics_.forward(wheels);
+  EXPECT_NEAR(twist_error(expected), 0.0, 1e-12);
+  EXPECT_THAT(odometry_.getWheelWeights(), ::testing::Each(1.0));
+  // the residual of a single inconsistent wheel is spread equally over the four wheels
+  for (const double residual : odometry_.getWheelResiduals())
+  {
+    EXPECT_NEAR(std::abs(residual), 5.0, 1e-9);
+  }
+}
+
+TEST_F(OdometryTest, set_pose_and_reset)
+{
+  odometry_.setPose(1.0, -2.0, M_PI_2);
+  // a pure forward motion in the base frame moves along y in the odometry frame
+  ASSERT_TRUE(update(wheels_of({{1.0, 0.0, 0.0}})));
+  EXPECT_NEAR(odometry_.getX(), 1.0, 1e-12);
+  EXPECT_NEAR(odometry_.getY(), -2.0 + kDt, 1e-12);
+  EXPECT_NEAR(odometry_.getRz(), M_PI_2, 1e-12);
+
+  odometry_.resetOdometry();
+  EXPECT_EQ(odometry_.getX(), 0.0);
+  EXPECT_EQ(odometry_.getY(), 0.0);
+  EXPECT_EQ(odometry_.getRz(), 0.0);
+  // the twist is not filtered, so it is kept
+  EXPECT_NEAR(odometry_.getVx(), 1.0, 1e-12);
+}
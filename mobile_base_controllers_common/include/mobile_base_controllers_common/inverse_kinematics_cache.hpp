@@ -0,0 +1,83 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOBILE_BASE_CONTROLLERS_COMMON__INVERSE_KINEMATICS_CACHE_HPP_
+#define MOBILE_BASE_CONTROLLERS_COMMON__INVERSE_KINEMATICS_CACHE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace mobile_base_controllers_common
+{
+/**
+ * \brief Memoizes the result of the inverse kinematics for the last steady inputs.
+ *
+ * The key holds all inputs the result depends on, i.e., the reference and the measured state.
+ * Keys are compared bitwise, so that a hit returns exactly what the computation would return.
+ * The hits and lookups are counted for InverseKinematicsCacheDiagnostics.
+ *
+ * \tparam N Number of inputs
+ * \tparam Value Result of the inverse kinematics
+ */
+template <std::size_t N, typename Value>
+class InverseKinematicsCache
+{
+public:
+  using Key = std::array<double, N>;
+
+  /**
+   * \brief Look the key up, counted for the hit rate
+   * \return The stored value if the key is bitwise equal to the stored one, nullptr otherwise
+   */
+  const Value * lookup(const Key & key)
+  {
+    ++lookups_;
+    if (!valid_ || std::memcmp(key.data(), key_.data(), sizeof(Key)) != 0)
+    {
+      return nullptr;
+    }
+    ++hits_;
+    return &value_;
+  }
+
+  /// Store the value of a key, replacing the previous one.
+  void store(const Key & key, const Value & value)
+  {
+    key_ = key;
+    value_ = value;
+    valid_ = true;
+  }
+
+  /// Drop the stored value, e.g., when the state it was computed from is reset.
+  void invalidate() { valid_ = false; }
+
+  /// Number of hits since construction
+  uint64_t hits() const { return hits_; }
+  /// Number of lookups since construction
+  uint64_t lookups() const { return lookups_; }
+
+private:
+  Key key_{};
+  Value value_{};
+  bool valid_ = false;
+
+  uint64_t hits_ = 0;
+  uint64_t lookups_ = 0;
+};
+
+}  // namespace mobile_base_controllers_common
+
+#endif  // MOBILE_BASE_CONTROLLERS_COMMON__INVERSE_KINEMATICS_CACHE_HPP_
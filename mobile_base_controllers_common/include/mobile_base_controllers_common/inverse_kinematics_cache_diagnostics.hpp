@@ -0,0 +1,67 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOBILE_BASE_CONTROLLERS_COMMON__INVERSE_KINEMATICS_CACHE_DIAGNOSTICS_HPP_
+#define MOBILE_BASE_CONTROLLERS_COMMON__INVERSE_KINEMATICS_CACHE_DIAGNOSTICS_HPP_
+
+#include <cstdint>
+#include <memory>
+
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"
+#include "rclcpp/publisher.hpp"
+#include "rclcpp/time.hpp"
+#include "rclcpp_lifecycle/lifecycle_node.hpp"
+#include "realtime_tools/realtime_publisher.hpp"
+
+namespace mobile_base_controllers_common
+{
+/**
+ * \brief Publishes the statistics of an InverseKinematicsCache on /diagnostics.
+ *
+ * The status holds the hit rate since the last message and the total hits and lookups. It is
+ * published through a realtime publisher at most once per second, and skipped while the publisher
+ * is busy.
+ */
+class InverseKinematicsCacheDiagnostics
+{
+public:
+  /**
+   * \brief Create the publisher and reserve the status, so that publish() does not allocate
+   * \param node Node of the controller, its name prefixes the status name
+   */
+  void configure(const std::shared_ptr<rclcpp_lifecycle::LifecycleNode> & node);
+
+  /**
+   * \brief Publish the statistics if the last message is at least one period old, from the update
+   * \param time Time of the update
+   * \param hits Number of hits since construction of the cache
+   * \param lookups Number of lookups since construction of the cache
+   */
+  void publish(const rclcpp::Time & time, uint64_t hits, uint64_t lookups);
+
+private:
+  using DiagnosticsMsg = diagnostic_msgs::msg::DiagnosticArray;
+  using DiagnosticsPublisher = realtime_tools::RealtimePublisher<DiagnosticsMsg>;
+
+  rclcpp::Publisher<DiagnosticsMsg>::SharedPtr diagnostics_s_publisher_;
+  std::unique_ptr<DiagnosticsPublisher> diagnostics_publisher_;
+  int64_t stamp_nanoseconds_ = 0;
+  // totals at the last message
+  uint64_t reported_hits_ = 0;
+  uint64_t reported_lookups_ = 0;
+};
+
+}  // namespace mobile_base_controllers_common
+
+#endif  // MOBILE_BASE_CONTROLLERS_COMMON__INVERSE_KINEMATICS_CACHE_DIAGNOSTICS_HPP_
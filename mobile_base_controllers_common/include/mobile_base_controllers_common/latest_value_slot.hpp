@@ -0,0 +1,91 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOBILE_BASE_CONTROLLERS_COMMON__LATEST_VALUE_SLOT_HPP_
+#define MOBILE_BASE_CONTROLLERS_COMMON__LATEST_VALUE_SLOT_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace mobile_base_controllers_common
+{
+/**
+ * \brief Wait-free slot passing the latest value from one writer thread to one reader thread.
+ *
+ * Triple buffer: the writer fills its own buffer and publishes it by exchanging it with the shared
+ * middle buffer, the reader swaps its buffer with the middle one only if a new value was published
+ * since. Neither side blocks or retries, older values are overwritten.
+ *
+ * \tparam T Trivially copyable value, so that reading and writing never allocate
+ */
+template <typename T>
+class LatestValueSlot
+{
+  static_assert(std::is_trivially_copyable_v<T>, "LatestValueSlot requires a trivially copyable T");
+
+public:
+  explicit LatestValueSlot(const T & initial_value = T{}) { reset(initial_value); }
+
+  /// Publish a value, only called by the writer thread.
+  void write(const T & value)
+  {
+    buffers_[write_index_] = value;
+    const auto previous = middle_.exchange(
+      static_cast<uint8_t>(write_index_ | NEW_VALUE_FLAG), std::memory_order_acq_rel);
+    write_index_ = previous & INDEX_MASK;
+  }
+
+  /**
+   * \brief Get the latest published value, only called by the reader thread
+   * \param [out] value Latest value, the initial one if none was published yet
+   * \return true if the value was published since the last read
+   */
+  bool read(T & value)
+  {
+    const bool new_value = (middle_.load(std::memory_order_relaxed) & NEW_VALUE_FLAG) != 0;
+    if (new_value)
+    {
+      read_index_ = middle_.exchange(read_index_, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+    value = buffers_[read_index_];
+    return new_value;
+  }
+
+  /// Set all buffers to a value, neither the writer nor the reader may access the slot meanwhile.
+  void reset(const T & value)
+  {
+    buffers_.fill(value);
+    write_index_ = 0;
+    middle_.store(1, std::memory_order_release);
+    read_index_ = 2;
+  }
+
+private:
+  static constexpr uint8_t INDEX_MASK = 0x3;
+  static constexpr uint8_t NEW_VALUE_FLAG = 0x4;
+
+  std::array<T, 3> buffers_;
+  // owned by the writer
+  uint8_t write_index_;
+  // index of the shared buffer, with NEW_VALUE_FLAG if it was not read yet
+  std::atomic<uint8_t> middle_;
+  // owned by the reader
+  uint8_t read_index_;
+};
+
+}  // namespace mobile_base_controllers_common
+
+#endif  // MOBILE_BASE_CONTROLLERS_COMMON__LATEST_VALUE_SLOT_HPP_
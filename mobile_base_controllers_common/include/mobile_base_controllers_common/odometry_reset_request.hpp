@@ -0,0 +1,83 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOBILE_BASE_CONTROLLERS_COMMON__ODOMETRY_RESET_REQUEST_HPP_
+#define MOBILE_BASE_CONTROLLERS_COMMON__ODOMETRY_RESET_REQUEST_HPP_
+
+#include <array>
+#include <cstddef>
+
+#include "mobile_base_controllers_common/latest_value_slot.hpp"
+
+namespace mobile_base_controllers_common
+{
+/// Odometry reset requested by the reset service or the set pose subscriber.
+struct OdometryResetRequest
+{
+  bool set_pose = false;  // otherwise the odometry is reset to zero
+  double x = 0.0;         // [m]
+  double y = 0.0;         // [m]
+  double heading = 0.0;   // [rad]
+  // Row-major covariance of x, y and heading, the odometry continues to propagate it
+  std::array<double, 9> pose_covariance{};
+};
+
+/**
+ * \brief Extracts the covariance of x, y and heading from the row-major 6x6 covariance of a
+ * geometry_msgs/PoseWithCovariance, ordered as x, y, z, roll, pitch and yaw.
+ */
+inline std::array<double, 9> planar_pose_covariance(const std::array<double, 36> & covariance)
+{
+  constexpr std::array<std::size_t, 3> indices{{0, 1, 5}};
+  std::array<double, 9> planar_covariance{};
+  for (std::size_t row = 0; row < indices.size(); ++row)
+  {
+    for (std::size_t col = 0; col < indices.size(); ++col)
+    {
+      planar_covariance[3 * row + col] = covariance[6 * indices[row] + indices[col]];
+    }
+  }
+  return planar_covariance;
+}
+
+/**
+ * \brief Writes the covariance of x, y and heading into the row-major 6x6 covariance of a
+ * geometry_msgs/PoseWithCovariance, the reverse of planar_pose_covariance().
+ *
+ * The other entries are left unchanged.
+ */
+inline void set_planar_pose_covariance(
+  const std::array<double, 9> & planar_covariance, std::array<double, 36> & covariance)
+{
+  constexpr std::array<std::size_t, 3> indices{{0, 1, 5}};
+  for (std::size_t row = 0; row < indices.size(); ++row)
+  {
+    for (std::size_t col = 0; col < indices.size(); ++col)
+    {
+      covariance[6 * indices[row] + indices[col]] = planar_covariance[3 * row + col];
+    }
+  }
+}
+
+/**
+ * \brief Hands the latest odometry reset request from the callbacks over to the update.
+ *
+ * The service and the subscriber share the default callback group of the controller node, so they
+ * never write concurrently. A request overwrites a previous one which was not applied yet.
+ */
+using OdometryResetSlot = LatestValueSlot<OdometryResetRequest>;
+
+}  // namespace mobile_base_controllers_common
+
+#endif  // MOBILE_BASE_CONTROLLERS_COMMON__ODOMETRY_RESET_REQUEST_HPP_
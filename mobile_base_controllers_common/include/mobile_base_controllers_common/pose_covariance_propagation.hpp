@@ -0,0 +1,43 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOBILE_BASE_CONTROLLERS_COMMON__POSE_COVARIANCE_PROPAGATION_HPP_
+#define MOBILE_BASE_CONTROLLERS_COMMON__POSE_COVARIANCE_PROPAGATION_HPP_
+
+#include <array>
+
+namespace mobile_base_controllers_common
+{
+/**
+ * \brief Propagate the covariance of a planar pose by one odometry step.
+ *
+ * Computes P = F P F^T + G Q G^T, linearized around the mean heading of the step, where Q is the
+ * covariance of the linear and angular displacement of the base. Each controller maps the noise
+ * of its wheels to Q.
+ *
+ * \param[in,out] pose_covariance Row-major covariance of x, y and heading
+ * \param heading Heading at the start of the step [rad]
+ * \param linear Linear displacement of the step [m]
+ * \param angular Angular displacement of the step [rad]
+ * \param linear_variance Variance of the linear displacement [m^2]
+ * \param linear_angular_covariance Covariance of the linear and angular displacement [m*rad]
+ * \param angular_variance Variance of the angular displacement [rad^2]
+ */
+void propagate_planar_pose_covariance(
+  std::array<double, 9> & pose_covariance, double heading, double linear, double angular,
+  double linear_variance, double linear_angular_covariance, double angular_variance);
+
+}  // namespace mobile_base_controllers_common
+
+#endif  // MOBILE_BASE_CONTROLLERS_COMMON__POSE_COVARIANCE_PROPAGATION_HPP_
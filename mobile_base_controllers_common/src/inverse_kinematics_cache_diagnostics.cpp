@@ -0,0 +1,89 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mobile_base_controllers_common/inverse_kinematics_cache_diagnostics.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+constexpr auto DEFAULT_DIAGNOSTICS_TOPIC = "/diagnostics";
+constexpr std::chrono::nanoseconds DIAGNOSTICS_PERIOD = std::chrono::seconds(1);
+}  // namespace
+
+namespace mobile_base_controllers_common
+{
+void InverseKinematicsCacheDiagnostics::configure(
+  const std::shared_ptr<rclcpp_lifecycle::LifecycleNode> & node)
+{
+  diagnostics_s_publisher_ =
+    node->create_publisher<DiagnosticsMsg>(DEFAULT_DIAGNOSTICS_TOPIC, rclcpp::SystemDefaultsQoS());
+  diagnostics_publisher_ = std::make_unique<DiagnosticsPublisher>(diagnostics_s_publisher_);
+
+  diagnostics_publisher_->lock();
+  auto & diagnostics_msg = diagnostics_publisher_->msg_;
+  diagnostics_msg.status.resize(1);
+  auto & status = diagnostics_msg.status.front();
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.name = std::string(node->get_name()) + ": inverse kinematics cache";
+  status.values.resize(3);
+  status.values[0].key = "hit rate";
+  status.values[1].key = "hits";
+  status.values[2].key = "lookups";
+  // the values are formatted in the update, without allocation
+  for (auto & value : status.values)
+  {
+    value.value.reserve(32);
+  }
+  diagnostics_publisher_->unlock();
+  stamp_nanoseconds_ = 0;
+}
+
+void InverseKinematicsCacheDiagnostics::publish(
+  const rclcpp::Time & time, uint64_t hits, uint64_t lookups)
+{
+  if (
+    time.nanoseconds() - stamp_nanoseconds_ < DIAGNOSTICS_PERIOD.count() ||
+    !diagnostics_publisher_->trylock())
+  {
+    return;
+  }
+  stamp_nanoseconds_ = time.nanoseconds();
+
+  const uint64_t period_lookups = lookups - reported_lookups_;
+  const uint64_t period_hits = hits - reported_hits_;
+  reported_lookups_ = lookups;
+  reported_hits_ = hits;
+
+  auto & diagnostics_msg = diagnostics_publisher_->msg_;
+  diagnostics_msg.header.stamp = time;
+  auto & values = diagnostics_msg.status.front().values;
+  char buffer[32];
+  // the hit rate is empty without lookups
+  int length = period_lookups > 0 ? std::snprintf(
+                                      buffer, sizeof(buffer), "%.4f",
+                                      static_cast<double>(period_hits) /
+                                        static_cast<double>(period_lookups))
+                                  : 0;
+  values[0].value.assign(buffer, static_cast<size_t>(length));
+  length = std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(hits));
+  values[1].value.assign(buffer, static_cast<size_t>(length));
+  length = std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(lookups));
+  values[2].value.assign(buffer, static_cast<size_t>(length));
+  diagnostics_publisher_->unlockAndPublish();
+}
+
+}  // namespace mobile_base_controllers_common
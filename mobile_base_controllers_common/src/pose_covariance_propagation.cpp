@@ -0,0 +1,59 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mobile_base_controllers_common/pose_covariance_propagation.hpp"
+
+#include <cmath>
+
+namespace mobile_base_controllers_common
+{
+void propagate_planar_pose_covariance(
+  std::array<double, 9> & pose_covariance, double heading, double linear, double angular,
+  double linear_variance, double linear_angular_covariance, double angular_variance)
+{
+  // Jacobians w.r.t. the pose and the linear and angular displacement:
+  // F = [1 0 -linear*sin; 0 1 linear*cos; 0 0 1]
+  // G = [cos -linear/2*sin; sin linear/2*cos; 0 1]
+  const double direction = heading + angular * 0.5;
+  const double cos_direction = std::cos(direction);
+  const double sin_direction = std::sin(direction);
+  const double dx_dheading = -linear * sin_direction;
+  const double dy_dheading = linear * cos_direction;
+
+  auto & p = pose_covariance;
+  const double p_xx = p[0] + 2.0 * dx_dheading * p[2] + dx_dheading * dx_dheading * p[8];
+  const double p_xy =
+    p[1] + dx_dheading * p[5] + dy_dheading * p[2] + dx_dheading * dy_dheading * p[8];
+  const double p_xh = p[2] + dx_dheading * p[8];
+  const double p_yy = p[4] + 2.0 * dy_dheading * p[5] + dy_dheading * dy_dheading * p[8];
+  const double p_yh = p[5] + dy_dheading * p[8];
+
+  // rows of G are (g0, g1), entry (i, j) of G Q G^T
+  const auto gqg = [&](double gi0, double gi1, double gj0, double gj1)
+  {
+    return gi0 * gj0 * linear_variance + (gi0 * gj1 + gi1 * gj0) * linear_angular_covariance +
+           gi1 * gj1 * angular_variance;
+  };
+  const double gx1 = 0.5 * dx_dheading;
+  const double gy1 = 0.5 * dy_dheading;
+
+  p[0] = p_xx + gqg(cos_direction, gx1, cos_direction, gx1);
+  p[1] = p[3] = p_xy + gqg(cos_direction, gx1, sin_direction, gy1);
+  p[2] = p[6] = p_xh + gqg(cos_direction, gx1, 0.0, 1.0);
+  p[4] = p_yy + gqg(sin_direction, gy1, sin_direction, gy1);
+  p[5] = p[7] = p_yh + gqg(sin_direction, gy1, 0.0, 1.0);
+  p[8] += angular_variance;
+}
+
+}  // namespace mobile_base_controllers_common
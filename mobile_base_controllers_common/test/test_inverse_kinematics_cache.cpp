@@ -0,0 +1,59 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <limits>
+
+#include "mobile_base_controllers_common/inverse_kinematics_cache.hpp"
+
+using Cache = mobile_base_controllers_common::InverseKinematicsCache<2, double>;
+
+TEST(InverseKinematicsCacheTest, lookup_hits_only_a_stored_key)
+{
+  Cache cache;
+  EXPECT_EQ(cache.lookup({{0.0, 0.0}}), nullptr);
+
+  cache.store({{1.0, 2.0}}, 3.0);
+  const double * value = cache.lookup({{1.0, 2.0}});
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 3.0);
+  EXPECT_EQ(cache.lookup({{1.0, 2.5}}), nullptr);
+
+  // the latest store replaces the key
+  cache.store({{1.0, 2.5}}, 4.0);
+  EXPECT_EQ(cache.lookup({{1.0, 2.0}}), nullptr);
+  ASSERT_NE(cache.lookup({{1.0, 2.5}}), nullptr);
+
+  cache.invalidate();
+  EXPECT_EQ(cache.lookup({{1.0, 2.5}}), nullptr);
+
+  EXPECT_EQ(cache.hits(), 2u);
+  EXPECT_EQ(cache.lookups(), 6u);
+}
+
+TEST(InverseKinematicsCacheTest, keys_are_compared_bitwise)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  Cache cache;
+
+  // a NaN reference hits although NaN != NaN
+  cache.store({{nan, 0.0}}, 1.0);
+  EXPECT_NE(cache.lookup({{nan, 0.0}}), nullptr);
+
+  // -0.0 == 0.0, but the computation may differ in sign
+  cache.store({{0.0, 0.0}}, 1.0);
+  EXPECT_EQ(cache.lookup({{-0.0, 0.0}}), nullptr);
+  EXPECT_NE(cache.lookup({{0.0, 0.0}}), nullptr);
+}
@@ -0,0 +1,132 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "mobile_base_controllers_common/latest_value_slot.hpp"
+
+using mobile_base_controllers_common::LatestValueSlot;
+
+namespace
+{
+struct Value
+{
+  double first = 0.0;
+  double second = 0.0;
+  int64_t sequence = 0;
+};
+}  // namespace
+
+TEST(LatestValueSlotTest, initial_value_is_read_until_written)
+{
+  LatestValueSlot<Value> slot({1.0, 2.0, 3});
+  Value value;
+  EXPECT_FALSE(slot.read(value));
+  EXPECT_EQ(value.first, 1.0);
+  EXPECT_EQ(value.second, 2.0);
+  EXPECT_EQ(value.sequence, 3);
+}
+
+TEST(LatestValueSlotTest, reads_latest_written_value)
+{
+  LatestValueSlot<Value> slot;
+  Value value;
+
+  slot.write({1.0, -1.0, 1});
+  EXPECT_TRUE(slot.read(value));
+  EXPECT_EQ(value.sequence, 1);
+
+  // the value is kept by later reads
+  EXPECT_FALSE(slot.read(value));
+  EXPECT_EQ(value.sequence, 1);
+  EXPECT_EQ(value.first, 1.0);
+
+  // older values are overwritten
+  slot.write({2.0, -2.0, 2});
+  slot.write({3.0, -3.0, 3});
+  slot.write({4.0, -4.0, 4});
+  EXPECT_TRUE(slot.read(value));
+  EXPECT_EQ(value.sequence, 4);
+  EXPECT_EQ(value.second, -4.0);
+  EXPECT_FALSE(slot.read(value));
+  EXPECT_EQ(value.sequence, 4);
+}
+
+TEST(LatestValueSlotTest, modifying_read_copy_keeps_stored_value)
+{
+  LatestValueSlot<Value> slot;
+  slot.write({1.0, 1.0, 1});
+
+  Value value;
+  slot.read(value);
+  value.first = 0.0;
+
+  slot.read(value);
+  EXPECT_EQ(value.first, 1.0);
+}
+
+TEST(LatestValueSlotTest, reset_discards_written_value)
+{
+  LatestValueSlot<Value> slot;
+  slot.write({1.0, 1.0, 1});
+  slot.reset(Value{});
+
+  Value value;
+  EXPECT_FALSE(slot.read(value));
+  EXPECT_EQ(value.sequence, 0);
+
+  slot.write({2.0, 2.0, 2});
+  EXPECT_TRUE(slot.read(value));
+  EXPECT_EQ(value.sequence, 2);
+}
+
+TEST(LatestValueSlotTest, concurrent_reads_are_consistent_and_monotonic)
+{
+  constexpr int64_t last_sequence = 200000;
+  LatestValueSlot<Value> slot;
+  std::atomic<bool> done{false};
+
+  std::thread writer(
+    [&]()
+    {
+      for (int64_t i = 1; i <= last_sequence; ++i)
+      {
+        const auto x = static_cast<double>(i);
+        slot.write({x, -x, i});
+      }
+      done = true;
+    });
+
+  Value value;
+  int64_t previous_sequence = 0;
+  bool finished = false;
+  while (!finished)
+  {
+    finished = done;
+    slot.read(value);
+    // never a mix of two written values
+    ASSERT_EQ(value.first, static_cast<double>(value.sequence));
+    ASSERT_EQ(value.second, -static_cast<double>(value.sequence));
+    ASSERT_GE(value.sequence, previous_sequence);
+    previous_sequence = value.sequence;
+  }
+  writer.join();
+
+  // the last write is visible once the writer is done
+  EXPECT_EQ(value.sequence, last_sequence);
+}
@@ -0,0 +1,65 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <type_traits>
+
+#include "mobile_base_controllers_common/odometry_reset_request.hpp"
+
+using mobile_base_controllers_common::OdometryResetRequest;
+using mobile_base_controllers_common::planar_pose_covariance;
+using mobile_base_controllers_common::set_planar_pose_covariance;
+
+TEST(OdometryResetRequestTest, request_can_be_handed_over_by_the_slot)
+{
+  EXPECT_TRUE(std::is_trivially_copyable<OdometryResetRequest>::value);
+  // the reset request and a pose without covariance reset the covariance
+  EXPECT_THAT(OdometryResetRequest{}.pose_covariance, ::testing::Each(0.0));
+  const OdometryResetRequest request{true, 1.0, 2.0, 3.0};
+  EXPECT_THAT(request.pose_covariance, ::testing::Each(0.0));
+}
+
+TEST(OdometryResetRequestTest, planar_pose_covariance_selects_x_y_and_yaw)
+{
+  // the entry in row i and column j is 10 * i + j
+  std::array<double, 36> covariance;
+  for (size_t i = 0; i < 6; ++i)
+  {
+    for (size_t j = 0; j < 6; ++j)
+    {
+      covariance[6 * i + j] = 10.0 * static_cast<double>(i) + static_cast<double>(j);
+    }
+  }
+
+  EXPECT_THAT(
+    planar_pose_covariance(covariance),
+    ::testing::ElementsAre(0.0, 1.0, 5.0, 10.0, 11.0, 15.0, 50.0, 51.0, 55.0));
+}
+
+TEST(OdometryResetRequestTest, set_planar_pose_covariance_writes_x_y_and_yaw)
+{
+  std::array<double, 36> covariance;
+  covariance.fill(-1.0);
+  const std::array<double, 9> planar_covariance{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0}};
+  set_planar_pose_covariance(planar_covariance, covariance);
+
+  EXPECT_EQ(planar_pose_covariance(covariance), planar_covariance);
+  // the entries of z, roll and pitch are unchanged
+  EXPECT_EQ(covariance[14], -1.0);
+  EXPECT_EQ(covariance[21], -1.0);
+  EXPECT_EQ(covariance[28], -1.0);
+  EXPECT_EQ(covariance[2], -1.0);
+}
@@ -0,0 +1,58 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cmath>
+
+#include "mobile_base_controllers_common/pose_covariance_propagation.hpp"
+
+using mobile_base_controllers_common::propagate_planar_pose_covariance;
+
+TEST(PoseCovariancePropagationTest, displacement_noise_is_mapped_to_the_pose)
+{
+  // one meter straight ahead along x from a known pose
+  std::array<double, 9> covariance{};
+  propagate_planar_pose_covariance(covariance, 0.0, 1.0, 0.0, 0.01, 0.0, 0.04);
+
+  // the heading error of the step shifts y by half the displacement
+  EXPECT_NEAR(covariance[0], 0.01, 1e-12);
+  EXPECT_NEAR(covariance[4], 0.25 * 0.04, 1e-12);
+  EXPECT_NEAR(covariance[5], 0.5 * 0.04, 1e-12);
+  EXPECT_NEAR(covariance[8], 0.04, 1e-12);
+  EXPECT_NEAR(covariance[1], 0.0, 1e-12);
+  EXPECT_NEAR(covariance[2], 0.0, 1e-12);
+  EXPECT_EQ(covariance[3], covariance[1]);
+  EXPECT_EQ(covariance[6], covariance[2]);
+  EXPECT_EQ(covariance[7], covariance[5]);
+}
+
+TEST(PoseCovariancePropagationTest, heading_uncertainty_grows_the_cross_track_variance)
+{
+  // two meters along y with an uncertain heading and without displacement noise
+  std::array<double, 9> covariance{{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.1}};
+  propagate_planar_pose_covariance(covariance, M_PI_2, 2.0, 0.0, 0.0, 0.0, 0.0);
+
+  EXPECT_NEAR(covariance[0], 4.0 * 0.1, 1e-12);
+  EXPECT_NEAR(covariance[2], -2.0 * 0.1, 1e-12);
+  EXPECT_NEAR(covariance[4], 0.0, 1e-12);
+  EXPECT_NEAR(covariance[5], 0.0, 1e-12);
+  EXPECT_EQ(covariance[8], 0.1);
+
+  // standing still keeps the covariance
+  const auto kept = covariance;
+  propagate_planar_pose_covariance(covariance, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+  EXPECT_EQ(covariance, kept);
+}
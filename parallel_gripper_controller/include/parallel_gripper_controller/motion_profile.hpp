@@ -0,0 +1,96 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PARALLEL_GRIPPER_CONTROLLER__MOTION_PROFILE_HPP_
+#define PARALLEL_GRIPPER_CONTROLLER__MOTION_PROFILE_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace parallel_gripper_action_controller
+{
+/**
+ * \brief Online motion profile generator for a single gripper joint.
+ *
+ * Every call to update() advances the position setpoint by one control period towards the target,
+ * respecting the velocity and acceleration limits (trapezoidal profile). The braking velocity is
+ * computed in closed form from the remaining distance, so the target can change at any time and
+ * the setpoint never overshoots it.
+ *
+ * If a jerk limit is set, the velocity of the trapezoidal profile is additionally averaged over a
+ * window of max_acceleration / max_jerk seconds. The result is a jerk-limited (S-curve) profile
+ * that still ends exactly on the target, delayed by half the window.
+ *
+ * All memory is allocated in configure(), reset() and update() are safe to use from the RT loop.
+ */
+class MotionProfile
+{
+public:
+  /**
+   * \brief Set the limits of the profile
+   * \param [in] max_acceleration Maximum acceleration [m/s^2], must be > 0
+   * \param [in] max_jerk Maximum jerk [m/s^3], NAN or <= 0 disables jerk limiting
+   * \param [in] period Nominal control period [s], must be > 0 if jerk limiting is enabled
+   */
+  void configure(double max_acceleration, double max_jerk = NAN, double period = NAN);
+
+  /**
+   * \brief Restart the profile from the given state, e.g. the measured joint position
+   * \param [in] position Position [m]
+   * \param [in] velocity Velocity [m/s]
+   */
+  void reset(double position, double velocity = 0.0);
+
+  /**
+   * \brief Advance the profile by one control period
+   * \param [in] target Target position [m]
+   * \param [in] max_velocity Maximum velocity [m/s], NAN or <= 0 disables the velocity limit
+   * \param [in] dt Control period [s]
+   * \return Position setpoint [m]
+   */
+  double update(double target, double max_velocity, double dt);
+
+  double position() const { return position_; }
+  double velocity() const { return velocity_; }
+  double acceleration() const { return acceleration_; }
+
+private:
+  /**
+   * \brief Advance the trapezoidal profile by one control period
+   * \return Velocity of the trapezoidal profile over this period [m/s]
+   */
+  double update_trapezoidal(double target, double max_velocity, double dt);
+
+  double max_acceleration_ = 1.0;
+
+  // Trapezoidal profile
+  double trapezoidal_position_ = 0.0;
+  double trapezoidal_velocity_ = 0.0;
+
+  // Moving average over the trapezoidal velocity, empty if jerk limiting is disabled
+  std::vector<double> velocity_window_;
+  size_t window_index_ = 0;
+  double window_sum_ = 0.0;
+  size_t settled_cycles_ = 0;
+
+  // Output
+  double position_ = 0.0;
+  double velocity_ = 0.0;
+  double acceleration_ = 0.0;
+};
+
+}  // namespace parallel_gripper_action_controller
+
+#endif  // PARALLEL_GRIPPER_CONTROLLER__MOTION_PROFILE_HPP_
@@ -18,10 +18,15 @@
 #define PARALLEL_GRIPPER_CONTROLLER__PARALLEL_GRIPPER_ACTION_CONTROLLER_HPP_
 
 // C++ standard
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 // ROS
 #include "rclcpp/rclcpp.hpp"
@@ -40,6 +45,7 @@
 #include "realtime_tools/realtime_server_goal_handle.hpp"
 
 // Project
+#include "parallel_gripper_controller/motion_profile.hpp"
 #include "parallel_gripper_controller/parallel_gripper_action_controller_parameters.hpp"
 
 namespace parallel_gripper_action_controller
@@ -50,6 +56,10 @@ namespace parallel_gripper_action_controller
  * \tparam HardwareInterface Controller hardware interface. Currently \p
  * hardware_interface::HW_IF_POSITION and \p
  * hardware_interface::HW_IF_EFFORT are supported out-of-the-box.
+ *
+ * Several independent grippers can be controlled by one instance by listing them in the
+ * \p additional_joints parameter. All grippers are then updated in a single pass of update() and
+ * each of them gets its own action server named `~/<joint>/gripper_cmd`.
  */
 
 class GripperActionController : public controller_interface::ControllerInterface
@@ -93,9 +103,10 @@ public:
   controller_interface::CallbackReturn on_deactivate(
     const rclcpp_lifecycle::State & previous_state) override;
 
-  realtime_tools::RealtimeBuffer<Commands> command_;
+  /// Commands of all grippers, indexed like #joint_names_
+  realtime_tools::RealtimeBuffer<std::vector<Commands>> command_;
   // pre-allocated memory that is reused to set the realtime buffer
-  Commands command_struct_, command_struct_rt_;
+  std::vector<Commands> command_struct_, command_struct_rt_;
 
 protected:
   using GripperCommandAction = control_msgs::action::ParallelGripperCommand;
@@ -105,57 +116,135 @@ protected:
   using RealtimeGoalHandle =
     realtime_tools::RealtimeServerGoalHandle<control_msgs::action::ParallelGripperCommand>;
   using RealtimeGoalHandlePtr = std::shared_ptr<RealtimeGoalHandle>;
-  using RealtimeGoalHandleBuffer = realtime_tools::RealtimeBuffer<RealtimeGoalHandlePtr>;
+  using LoanedCommandInterfaceRef =
+    std::reference_wrapper<hardware_interface::LoanedCommandInterface>;
+  using LoanedStateInterfaceRef = std::reference_wrapper<hardware_interface::LoanedStateInterface>;
+
+  /**
+   * \brief Goal status shared between the non-RT action callbacks and the RT loop.
+   *
+   * The non-RT side moves the status to \p NEW when a goal is accepted and back to \p IDLE when
+   * it is canceled or finalized. The RT loop only moves \p NEW to \p ACTIVE and \p ACTIVE to one
+   * of the terminal states, so a stale outcome of a preempted goal can never be reported.
+   */
+  enum class GoalStatus : uint8_t
+  {
+    IDLE,
+    NEW,
+    ACTIVE,
+    SUCCEEDED,
+    STALLED,
+    ABORTED
+  };
+
+  /**
+   * \brief Outcome of a goal as evaluated by the RT loop. Only written by the RT loop while the
+   * goal status is \p ACTIVE and only read by the non-RT side once a terminal status is observed.
+   */
+  struct GoalOutcome
+  {
+    double position_;
+    double effort_;  // measured, or the commanded max effort without effort state interface
+  };
+
+  /**
+   * \brief Gripper state sampled by the RT loop for action feedback. Handed over to the non-RT side
+   * through #rt_feedback_ready_, the RT loop only writes it while the flag is cleared.
+   * It holds no stall state, the action feedback has no field for it and a stall ends the goal.
+   */
+  struct FeedbackSample
+  {
+    double position_;
+    double velocity_;
+    double effort_;
+  };
 
   bool update_hold_position_;
 
   bool verbose_ = false;  ///< Hard coded verbose flag to help in debugging
   std::string name_;      ///< Controller name.
-  std::optional<std::reference_wrapper<hardware_interface::LoanedCommandInterface>>
-    joint_command_interface_;
-  std::optional<std::reference_wrapper<hardware_interface::LoanedCommandInterface>>
-    effort_interface_;
-  std::optional<std::reference_wrapper<hardware_interface::LoanedCommandInterface>>
-    speed_interface_;
-  std::optional<std::reference_wrapper<hardware_interface::LoanedStateInterface>>
-    joint_position_state_interface_;
-  std::optional<std::reference_wrapper<hardware_interface::LoanedStateInterface>>
-    joint_velocity_state_interface_;
+
+  /// Controlled gripper joints, the primary `joint` first followed by `additional_joints`
+  std::vector<std::string> joint_names_;
+  /// Optional max effort/velocity interface names per gripper, empty if not claimed
+  std::vector<std::string> max_effort_interface_names_;
+  std::vector<std::string> max_velocity_interface_names_;
+
+  // Per gripper interfaces, indexed like #joint_names_
+  std::vector<LoanedCommandInterfaceRef> joint_command_interfaces_;
+  std::vector<std::optional<LoanedCommandInterfaceRef>> effort_interfaces_;
+  std::vector<std::optional<LoanedCommandInterfaceRef>> speed_interfaces_;
+  std::vector<LoanedStateInterfaceRef> joint_position_state_interfaces_;
+  std::vector<LoanedStateInterfaceRef> joint_velocity_state_interfaces_;
+  std::vector<std::optional<LoanedStateInterfaceRef>> joint_effort_state_interfaces_;
 
   std::shared_ptr<ParamListener> param_listener_;
   Params params_;
 
-  RealtimeGoalHandleBuffer
-    rt_active_goal_;  ///< Container for the currently active action goal, if any.
-  control_msgs::action::ParallelGripperCommand::Result::SharedPtr pre_alloc_result_;
+  /// Motion profile per gripper, empty if the commanded position is forwarded directly
+  std::vector<MotionProfile> motion_profiles_;
+
+  /// Currently active action goal per gripper, if any. Only accessed from non-RT callbacks.
+  std::vector<RealtimeGoalHandlePtr> active_goals_;
+  /// Lock-free RT <-> non-RT channel per gripper
+  std::vector<std::atomic<GoalStatus>> rt_goal_status_;
+  /// Outcome reported by the RT loop per gripper
+  std::vector<GoalOutcome> rt_goal_outcome_;
+  std::vector<control_msgs::action::ParallelGripperCommand::Result::SharedPtr> pre_alloc_result_;
+
+  /// Feedback sample per gripper and the flag handing it over from the RT loop to the timer
+  std::vector<FeedbackSample> rt_feedback_sample_;
+  std::vector<std::atomic<bool>> rt_feedback_ready_;
+  /// Time of the last feedback sample per gripper, only used by the RT loop
+  std::vector<rclcpp::Time> last_feedback_time_;
+  std::vector<control_msgs::action::ParallelGripperCommand::Feedback::SharedPtr>
+    pre_alloc_feedback_;
 
   rclcpp::Duration action_monitor_period_;
+  rclcpp::Duration feedback_period_;  ///< Zero if feedback is disabled
 
   // ROS API
-  ActionServerPtr action_server_;
+  std::vector<ActionServerPtr> action_servers_;
 
-  rclcpp::TimerBase::SharedPtr goal_handle_timer_;
+  std::vector<rclcpp::TimerBase::SharedPtr> goal_handle_timers_;
 
   rclcpp_action::GoalResponse goal_callback(
     const rclcpp_action::GoalUUID & uuid, std::shared_ptr<const GripperCommandAction::Goal> goal);
 
-  rclcpp_action::CancelResponse cancel_callback(const std::shared_ptr<GoalHandle> goal_handle);
+  rclcpp_action::CancelResponse cancel_callback(
+    size_t gripper_index, const std::shared_ptr<GoalHandle> goal_handle);
 
-  void accepted_callback(std::shared_ptr<GoalHandle> goal_handle);
+  void accepted_callback(size_t gripper_index, std::shared_ptr<GoalHandle> goal_handle);
 
-  void preempt_active_goal();
+  void preempt_active_goal(size_t gripper_index);
 
-  void set_hold_position();
+  void set_hold_position(size_t gripper_index);
+
+  /**
+   * \brief Finalize the active goal of a gripper if the RT loop reported an outcome. Runs in the
+   * non-RT goal handle timer, right before the goal handle is serviced.
+   */
+  void finalize_active_goal(size_t gripper_index);
+
+  /**
+   * \brief Hand the latest feedback sample of a gripper, if any, to its goal handle. Runs in the
+   * non-RT goal handle timer, the feedback is then published by the goal handle.
+   */
+  void publish_feedback(size_t gripper_index, const RealtimeGoalHandlePtr & rt_goal);
 
-  rclcpp::Time last_movement_time_ = rclcpp::Time(0, 0, RCL_ROS_TIME);  ///< Store stall time
-  double computed_command_;                                             ///< Computed command
+  /// Store stall time per gripper
+  std::vector<rclcpp::Time> last_movement_time_;
 
   /**
-   * \brief Check for success and publish appropriate result and feedback.
+   * \brief Check for success or stall and report the outcome to the non-RT side.
+   *
+   * Called from the RT loop. It never blocks: the outcome is stored in #rt_goal_outcome_ and
+   * signalled through #rt_goal_status_, the action result is sent by finalize_active_goal().
+   * While the goal is active, feedback samples are taken at the configured feedback rate.
    **/
   void check_for_success(
-    const rclcpp::Time & time, double error_position, double current_position,
-    double current_velocity);
+    size_t gripper_index, const rclcpp::Time & time, double error_position,
+    double current_position, double current_velocity, double current_effort);
 };
 
 }  // namespace parallel_gripper_action_controller
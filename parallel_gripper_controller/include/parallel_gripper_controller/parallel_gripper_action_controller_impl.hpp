@@ -17,6 +17,7 @@
 #ifndef PARALLEL_GRIPPER_CONTROLLER__PARALLEL_GRIPPER_ACTION_CONTROLLER_IMPL_HPP_
 #define PARALLEL_GRIPPER_CONTROLLER__PARALLEL_GRIPPER_ACTION_CONTROLLER_IMPL_HPP_
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -27,15 +28,17 @@
 namespace parallel_gripper_action_controller
 {
 
-void GripperActionController::preempt_active_goal()
+void GripperActionController::preempt_active_goal(size_t gripper_index)
 {
   // Cancels the currently active goal
-  const auto active_goal = *rt_active_goal_.readFromNonRT();
+  const auto active_goal = active_goals_[gripper_index];
   if (active_goal)
   {
+    // Discard any outcome the RT loop might have reported for this goal
+    rt_goal_status_[gripper_index].store(GoalStatus::IDLE, std::memory_order_release);
     // Marks the current goal as canceled
     active_goal->setCanceled(std::make_shared<GripperCommandAction::Result>());
-    rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
+    active_goals_[gripper_index].reset();
   }
 }
 
@@ -55,24 +58,44 @@ controller_interface::CallbackReturn GripperActionController::on_init()
 }
 
 controller_interface::return_type GripperActionController::update(
-  const rclcpp::Time & /*time*/, const rclcpp::Duration & /*period*/)
+  const rclcpp::Time & time, const rclcpp::Duration & period)
 {
-  command_struct_rt_ = *(command_.readFromRT());
-
-  const double current_position = joint_position_state_interface_->get().get_value();
-  const double current_velocity = joint_velocity_state_interface_->get().get_value();
-  const double error_position = command_struct_rt_.position_cmd_ - current_position;
-
-  check_for_success(get_node()->now(), error_position, current_position, current_velocity);
-
-  joint_command_interface_->get().set_value(command_struct_rt_.position_cmd_);
-  if (speed_interface_.has_value())
+  const auto * commands = command_.readFromRT();
+  if (commands && commands->size() == command_struct_rt_.size())
   {
-    speed_interface_->get().set_value(command_struct_rt_.max_velocity_);
+    std::copy(commands->begin(), commands->end(), command_struct_rt_.begin());
   }
-  if (effort_interface_.has_value())
+
+  for (size_t i = 0; i < joint_names_.size(); ++i)
   {
-    effort_interface_->get().set_value(command_struct_rt_.max_effort_);
+    const auto & command = command_struct_rt_[i];
+    const double current_position = joint_position_state_interfaces_[i].get().get_value();
+    const double current_velocity = joint_velocity_state_interfaces_[i].get().get_value();
+    const double current_effort = joint_effort_state_interfaces_[i].has_value()
+                                    ? joint_effort_state_interfaces_[i]->get().get_value()
+                                    : command.max_effort_;
+    const double error_position = command.position_cmd_ - current_position;
+
+    check_for_success(
+      i, time, error_position, current_position, current_velocity, current_effort);
+
+    if (motion_profiles_.empty())
+    {
+      joint_command_interfaces_[i].get().set_value(command.position_cmd_);
+    }
+    else
+    {
+      joint_command_interfaces_[i].get().set_value(motion_profiles_[i].update(
+        command.position_cmd_, command.max_velocity_, period.seconds()));
+    }
+    if (speed_interfaces_[i].has_value())
+    {
+      speed_interfaces_[i]->get().set_value(command.max_velocity_);
+    }
+    if (effort_interfaces_[i].has_value())
+    {
+      effort_interfaces_[i]->get().set_value(command.max_effort_);
+    }
   }
 
   return controller_interface::return_type::OK;
@@ -83,9 +106,6 @@ rclcpp_action::GoalResponse GripperActionController::goal_callback(
 {
   if (goal_handle->command.position.size() != 1)
   {
-    pre_alloc_result_ = std::make_shared<control_msgs::action::ParallelGripperCommand::Result>();
-    pre_alloc_result_->state.position.resize(1);
-    pre_alloc_result_->state.effort.resize(1);
     RCLCPP_ERROR(
       get_node()->get_logger(),
       "Received action goal with wrong number of position values, expects 1, got %zu",
@@ -98,128 +118,214 @@ rclcpp_action::GoalResponse GripperActionController::goal_callback(
 }
 
 void GripperActionController::accepted_callback(
-  std::shared_ptr<GoalHandle> goal_handle)  // Try to update goal
+  size_t gripper_index, std::shared_ptr<GoalHandle> goal_handle)  // Try to update goal
 {
   auto rt_goal = std::make_shared<RealtimeGoalHandle>(goal_handle);
 
   // Accept new goal
-  preempt_active_goal();
+  preempt_active_goal(gripper_index);
 
   // This is the non-realtime command_struct
   // We use command_ for sharing
-  command_struct_.position_cmd_ = goal_handle->get_goal()->command.position[0];
-  if (!params_.max_velocity_interface.empty() && !goal_handle->get_goal()->command.velocity.empty())
+  auto & command = command_struct_[gripper_index];
+  command.position_cmd_ = goal_handle->get_goal()->command.position[0];
+  if (
+    !max_velocity_interface_names_[gripper_index].empty() &&
+    !goal_handle->get_goal()->command.velocity.empty())
   {
-    command_struct_.max_velocity_ = goal_handle->get_goal()->command.velocity[0];
+    command.max_velocity_ = goal_handle->get_goal()->command.velocity[0];
   }
   else
   {
-    command_struct_.max_velocity_ = params_.max_velocity;
+    command.max_velocity_ = params_.max_velocity;
   }
-  if (!params_.max_effort_interface.empty() && !goal_handle->get_goal()->command.effort.empty())
+  if (
+    !max_effort_interface_names_[gripper_index].empty() &&
+    !goal_handle->get_goal()->command.effort.empty())
   {
-    command_struct_.max_effort_ = goal_handle->get_goal()->command.effort[0];
+    command.max_effort_ = goal_handle->get_goal()->command.effort[0];
   }
   else
   {
-    command_struct_.max_effort_ = params_.max_effort;
+    command.max_effort_ = params_.max_effort;
   }
   command_.writeFromNonRT(command_struct_);
 
-  pre_alloc_result_->reached_goal = false;
-  pre_alloc_result_->stalled = false;
+  pre_alloc_result_[gripper_index]->reached_goal = false;
+  pre_alloc_result_[gripper_index]->stalled = false;
 
-  last_movement_time_ = get_node()->now();
   rt_goal->execute();
-  rt_active_goal_.writeFromNonRT(rt_goal);
+  active_goals_[gripper_index] = rt_goal;
+  rt_feedback_ready_[gripper_index].store(false, std::memory_order_release);
+  // The RT loop starts the stall timer with its own clock on the first cycle of the new goal
+  rt_goal_status_[gripper_index].store(GoalStatus::NEW, std::memory_order_release);
 
   // Set smartpointer to expire for create_wall_timer to delete previous entry from timer list
-  goal_handle_timer_.reset();
+  goal_handle_timers_[gripper_index].reset();
 
   // Setup goal status checking timer
-  goal_handle_timer_ = get_node()->create_wall_timer(
+  goal_handle_timers_[gripper_index] = get_node()->create_wall_timer(
     action_monitor_period_.to_chrono<std::chrono::nanoseconds>(),
-    std::bind(&RealtimeGoalHandle::runNonRealtime, rt_goal));
+    [this, gripper_index, rt_goal]()
+    {
+      publish_feedback(gripper_index, rt_goal);
+      finalize_active_goal(gripper_index);
+      rt_goal->runNonRealtime();
+    });
 }
 
 rclcpp_action::CancelResponse GripperActionController::cancel_callback(
-  const std::shared_ptr<GoalHandle> goal_handle)
+  size_t gripper_index, const std::shared_ptr<GoalHandle> goal_handle)
 {
   RCLCPP_INFO(get_node()->get_logger(), "Got request to cancel goal");
 
   // Check that cancel request refers to currently active goal (if any)
-  const auto active_goal = *rt_active_goal_.readFromNonRT();
+  const auto active_goal = active_goals_[gripper_index];
   if (active_goal && active_goal->gh_ == goal_handle)
   {
     // Enter hold current position mode
-    set_hold_position();
+    set_hold_position(gripper_index);
 
     RCLCPP_INFO(
       get_node()->get_logger(), "Canceling active action goal because cancel callback received.");
 
+    // Discard any outcome the RT loop might have reported for this goal
+    rt_goal_status_[gripper_index].store(GoalStatus::IDLE, std::memory_order_release);
+
     // Mark the current goal as canceled
     auto action_res = std::make_shared<GripperCommandAction::Result>();
     active_goal->setCanceled(action_res);
     // Reset current goal
-    rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
+    active_goals_[gripper_index].reset();
   }
   return rclcpp_action::CancelResponse::ACCEPT;
 }
 
-void GripperActionController::set_hold_position()
+void GripperActionController::set_hold_position(size_t gripper_index)
 {
-  command_struct_.position_cmd_ = joint_position_state_interface_->get().get_value();
-  command_struct_.max_effort_ = params_.max_effort;
-  command_struct_.max_velocity_ = params_.max_velocity;
+  auto & command = command_struct_[gripper_index];
+  command.position_cmd_ = joint_position_state_interfaces_[gripper_index].get().get_value();
+  command.max_effort_ = params_.max_effort;
+  command.max_velocity_ = params_.max_velocity;
   command_.writeFromNonRT(command_struct_);
 }
 
 void GripperActionController::check_for_success(
-  const rclcpp::Time & time, double error_position, double current_position,
-  double current_velocity)
+  size_t gripper_index, const rclcpp::Time & time, double error_position,
+  double current_position, double current_velocity, double current_effort)
 {
-  const auto active_goal = *rt_active_goal_.readFromNonRT();
-  if (!active_goal)
+  auto & goal_status = rt_goal_status_[gripper_index];
+  GoalStatus status = goal_status.load(std::memory_order_acquire);
+  if (status == GoalStatus::NEW)
+  {
+    // A CAS failure means the goal was canceled or replaced in the meantime, retry next cycle
+    if (!goal_status.compare_exchange_strong(status, GoalStatus::ACTIVE, std::memory_order_acq_rel))
+    {
+      return;
+    }
+    last_movement_time_[gripper_index] = time;
+    last_feedback_time_[gripper_index] = time;
+  }
+  else if (status != GoalStatus::ACTIVE)
   {
     return;
   }
 
+  GoalStatus outcome = GoalStatus::ACTIVE;
   if (fabs(error_position) < params_.goal_tolerance)
   {
-    pre_alloc_result_->state.effort[0] = computed_command_;
-    pre_alloc_result_->state.position[0] = current_position;
-    pre_alloc_result_->reached_goal = true;
-    pre_alloc_result_->stalled = false;
-    RCLCPP_DEBUG(get_node()->get_logger(), "Successfully moved to goal.");
-    active_goal->setSucceeded(pre_alloc_result_);
-    rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
+    outcome = GoalStatus::SUCCEEDED;
   }
-  else
+  else if (fabs(current_velocity) > params_.stall_velocity_threshold)
+  {
+    last_movement_time_[gripper_index] = time;
+  }
+  else if ((time - last_movement_time_[gripper_index]).seconds() > params_.stall_timeout)
+  {
+    outcome = params_.allow_stalling ? GoalStatus::STALLED : GoalStatus::ABORTED;
+  }
+
+  if (outcome != GoalStatus::ACTIVE)
+  {
+    rt_goal_outcome_[gripper_index].position_ = current_position;
+    rt_goal_outcome_[gripper_index].effort_ = current_effort;
+    // Only publish the outcome if the goal was not canceled or replaced meanwhile
+    status = GoalStatus::ACTIVE;
+    goal_status.compare_exchange_strong(status, outcome, std::memory_order_acq_rel);
+  }
+  else if (
+    feedback_period_.nanoseconds() > 0 &&
+    time - last_feedback_time_[gripper_index] >= feedback_period_)
   {
-    if (fabs(current_velocity) > params_.stall_velocity_threshold)
+    last_feedback_time_[gripper_index] = time;
+    // The sample is skipped if the previous one was not picked up by the timer yet
+    if (!rt_feedback_ready_[gripper_index].load(std::memory_order_acquire))
     {
-      last_movement_time_ = time;
+      auto & sample = rt_feedback_sample_[gripper_index];
+      sample.position_ = current_position;
+      sample.velocity_ = current_velocity;
+      sample.effort_ = current_effort;
+      rt_feedback_ready_[gripper_index].store(true, std::memory_order_release);
     }
-    else if ((time - last_movement_time_).seconds() > params_.stall_timeout)
-    {
-      pre_alloc_result_->state.effort[0] = computed_command_;
-      pre_alloc_result_->state.position[0] = current_position;
-      pre_alloc_result_->reached_goal = false;
-      pre_alloc_result_->stalled = true;
+  }
+}
 
-      if (params_.allow_stalling)
-      {
-        RCLCPP_DEBUG(get_node()->get_logger(), "Stall detected moving to goal. Returning success.");
-        active_goal->setSucceeded(pre_alloc_result_);
-      }
-      else
-      {
-        RCLCPP_DEBUG(get_node()->get_logger(), "Stall detected moving to goal. Aborting action!");
-        active_goal->setAborted(pre_alloc_result_);
-      }
-      rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
+void GripperActionController::publish_feedback(
+  size_t gripper_index, const RealtimeGoalHandlePtr & rt_goal)
+{
+  if (!rt_feedback_ready_[gripper_index].load(std::memory_order_acquire))
+  {
+    return;
+  }
+
+  const auto & sample = rt_feedback_sample_[gripper_index];
+  auto & feedback = pre_alloc_feedback_[gripper_index];
+  feedback->state.header.stamp = get_node()->now();
+  feedback->state.position[0] = sample.position_;
+  feedback->state.velocity[0] = sample.velocity_;
+  feedback->state.effort[0] = sample.effort_;
+  rt_feedback_ready_[gripper_index].store(false, std::memory_order_release);
+
+  rt_goal->setFeedback(feedback);
+}
+
+void GripperActionController::finalize_active_goal(size_t gripper_index)
+{
+  const GoalStatus status = rt_goal_status_[gripper_index].load(std::memory_order_acquire);
+  if (
+    status != GoalStatus::SUCCEEDED && status != GoalStatus::STALLED &&
+    status != GoalStatus::ABORTED)
+  {
+    return;
+  }
+
+  const auto active_goal = active_goals_[gripper_index];
+  if (active_goal)
+  {
+    auto & result = pre_alloc_result_[gripper_index];
+    result->state.effort[0] = rt_goal_outcome_[gripper_index].effort_;
+    result->state.position[0] = rt_goal_outcome_[gripper_index].position_;
+    result->reached_goal = status == GoalStatus::SUCCEEDED;
+    result->stalled = status != GoalStatus::SUCCEEDED;
+
+    if (status == GoalStatus::SUCCEEDED)
+    {
+      RCLCPP_DEBUG(get_node()->get_logger(), "Successfully moved to goal.");
+      active_goal->setSucceeded(result);
     }
+    else if (status == GoalStatus::STALLED)
+    {
+      RCLCPP_DEBUG(get_node()->get_logger(), "Stall detected moving to goal. Returning success.");
+      active_goal->setSucceeded(result);
+    }
+    else
+    {
+      RCLCPP_DEBUG(get_node()->get_logger(), "Stall detected moving to goal. Aborting action!");
+      active_goal->setAborted(result);
+    }
+    active_goals_[gripper_index].reset();
   }
+  rt_goal_status_[gripper_index].store(GoalStatus::IDLE, std::memory_order_release);
 }
 
 controller_interface::CallbackReturn GripperActionController::on_configure(
@@ -233,6 +339,17 @@ controller_interface::CallbackReturn GripperActionController::on_configure(
   RCLCPP_INFO(
     logger, "Action status changes will be monitored at %f Hz.", params_.action_monitor_rate);
 
+  // Action feedback sampling rate
+  if (params_.feedback_rate > 0.0)
+  {
+    feedback_period_ = rclcpp::Duration::from_seconds(1.0 / params_.feedback_rate);
+    RCLCPP_INFO(logger, "Action feedback will be sampled at %f Hz.", params_.feedback_rate);
+  }
+  else
+  {
+    feedback_period_ = rclcpp::Duration::from_seconds(0.0);
+  }
+
   // Controlled joint
   if (params_.joint.empty())
   {
@@ -241,102 +358,199 @@ controller_interface::CallbackReturn GripperActionController::on_configure(
   }
   RCLCPP_INFO(logger, "Joint name is : %s", params_.joint.c_str());
 
+  joint_names_ = {params_.joint};
+  max_effort_interface_names_ = {params_.max_effort_interface};
+  max_velocity_interface_names_ = {params_.max_velocity_interface};
+  for (const auto & joint : params_.additional_joints)
+  {
+    if (std::find(joint_names_.begin(), joint_names_.end(), joint) != joint_names_.end())
+    {
+      RCLCPP_ERROR(logger, "Joint '%s' is listed more than once", joint.c_str());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    RCLCPP_INFO(logger, "Additional joint name is : %s", joint.c_str());
+    joint_names_.push_back(joint);
+    const auto & interfaces = params_.additional_interfaces.additional_joints_map.at(joint);
+    max_effort_interface_names_.push_back(interfaces.max_effort_interface);
+    max_velocity_interface_names_.push_back(interfaces.max_velocity_interface);
+  }
+
+  // Preallocate per gripper storage
+  const size_t n_grippers = joint_names_.size();
+  motion_profiles_.clear();
+  if (params_.motion_profile != "none")
+  {
+    const bool limit_jerk = params_.motion_profile == "jerk_limited";
+    if (limit_jerk && get_update_rate() == 0)
+    {
+      RCLCPP_ERROR(logger, "Controller's update rate is required for the jerk limited profile");
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    const double period = limit_jerk ? 1.0 / static_cast<double>(get_update_rate()) : NAN;
+    motion_profiles_.resize(n_grippers);
+    for (auto & motion_profile : motion_profiles_)
+    {
+      motion_profile.configure(
+        params_.max_acceleration, limit_jerk ? params_.max_jerk : NAN, period);
+    }
+    RCLCPP_INFO(logger, "Using %s motion profile", params_.motion_profile.c_str());
+  }
+
+  command_struct_.resize(n_grippers);
+  command_struct_rt_.resize(n_grippers);
+  active_goals_.assign(n_grippers, RealtimeGoalHandlePtr());
+  rt_goal_status_ = std::vector<std::atomic<GoalStatus>>(n_grippers);
+  rt_goal_outcome_.assign(n_grippers, GoalOutcome{0.0, 0.0});
+  last_movement_time_.assign(n_grippers, rclcpp::Time(0, 0, RCL_ROS_TIME));
+  rt_feedback_sample_.assign(n_grippers, FeedbackSample{0.0, 0.0, 0.0});
+  rt_feedback_ready_ = std::vector<std::atomic<bool>>(n_grippers);
+  last_feedback_time_.assign(n_grippers, rclcpp::Time(0, 0, RCL_ROS_TIME));
+  goal_handle_timers_.resize(n_grippers);
+
   return controller_interface::CallbackReturn::SUCCESS;
 }
 
 controller_interface::CallbackReturn GripperActionController::on_activate(
   const rclcpp_lifecycle::State &)
 {
-  auto command_interface_it = std::find_if(
-    command_interfaces_.begin(), command_interfaces_.end(),
-    [](const hardware_interface::LoanedCommandInterface & command_interface)
-    { return command_interface.get_interface_name() == hardware_interface::HW_IF_POSITION; });
-  if (command_interface_it == command_interfaces_.end())
-  {
-    RCLCPP_ERROR(
-      get_node()->get_logger(), "Expected 1 %s command interface",
-      hardware_interface::HW_IF_POSITION);
-    return controller_interface::CallbackReturn::ERROR;
-  }
-  if (command_interface_it->get_prefix_name() != params_.joint)
-  {
-    RCLCPP_ERROR(
-      get_node()->get_logger(), "Command interface is different than joint name `%s` != `%s`",
-      command_interface_it->get_prefix_name().c_str(), params_.joint.c_str());
-    return controller_interface::CallbackReturn::ERROR;
-  }
-  const auto position_state_interface_it = std::find_if(
-    state_interfaces_.begin(), state_interfaces_.end(),
-    [](const hardware_interface::LoanedStateInterface & state_interface)
-    { return state_interface.get_interface_name() == hardware_interface::HW_IF_POSITION; });
-  if (position_state_interface_it == state_interfaces_.end())
-  {
-    RCLCPP_ERROR(get_node()->get_logger(), "Expected 1 position state interface");
-    return controller_interface::CallbackReturn::ERROR;
-  }
-  if (position_state_interface_it->get_prefix_name() != params_.joint)
+  const auto logger = get_node()->get_logger();
+  const auto find_command_interface = [this](const std::string & name)
   {
-    RCLCPP_ERROR(
-      get_node()->get_logger(),
-      "Position state interface is different than joint name `%s` != `%s`",
-      position_state_interface_it->get_prefix_name().c_str(), params_.joint.c_str());
-    return controller_interface::CallbackReturn::ERROR;
-  }
-  const auto velocity_state_interface_it = std::find_if(
-    state_interfaces_.begin(), state_interfaces_.end(),
-    [](const hardware_interface::LoanedStateInterface & state_interface)
-    { return state_interface.get_interface_name() == hardware_interface::HW_IF_VELOCITY; });
-  if (velocity_state_interface_it == state_interfaces_.end())
+    return std::find_if(
+      command_interfaces_.begin(), command_interfaces_.end(),
+      [&name](const hardware_interface::LoanedCommandInterface & command_interface)
+      { return command_interface.get_name() == name; });
+  };
+  const auto find_state_interface = [this](const std::string & name)
   {
-    RCLCPP_ERROR(get_node()->get_logger(), "Expected 1 velocity state interface");
-    return controller_interface::CallbackReturn::ERROR;
-  }
-  if (velocity_state_interface_it->get_prefix_name() != params_.joint)
+    return std::find_if(
+      state_interfaces_.begin(), state_interfaces_.end(),
+      [&name](const hardware_interface::LoanedStateInterface & state_interface)
+      { return state_interface.get_name() == name; });
+  };
+
+  joint_command_interfaces_.clear();
+  effort_interfaces_.clear();
+  speed_interfaces_.clear();
+  joint_position_state_interfaces_.clear();
+  joint_velocity_state_interfaces_.clear();
+  joint_effort_state_interfaces_.clear();
+  for (size_t i = 0; i < joint_names_.size(); ++i)
   {
-    RCLCPP_ERROR(
-      get_node()->get_logger(),
-      "Velocity command interface is different than joint name `%s` != `%s`",
-      velocity_state_interface_it->get_prefix_name().c_str(), params_.joint.c_str());
-    return controller_interface::CallbackReturn::ERROR;
-  }
+    const auto & joint = joint_names_[i];
+    const auto command_interface_it =
+      find_command_interface(joint + "/" + hardware_interface::HW_IF_POSITION);
+    if (command_interface_it == command_interfaces_.end())
+    {
+      RCLCPP_ERROR(
+        logger, "Expected 1 %s command interface for joint `%s`",
+        hardware_interface::HW_IF_POSITION, joint.c_str());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    const auto position_state_interface_it =
+      find_state_interface(joint + "/" + hardware_interface::HW_IF_POSITION);
+    if (position_state_interface_it == state_interfaces_.end())
+    {
+      RCLCPP_ERROR(logger, "Expected 1 position state interface for joint `%s`", joint.c_str());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+    const auto velocity_state_interface_it =
+      find_state_interface(joint + "/" + hardware_interface::HW_IF_VELOCITY);
+    if (velocity_state_interface_it == state_interfaces_.end())
+    {
+      RCLCPP_ERROR(logger, "Expected 1 velocity state interface for joint `%s`", joint.c_str());
+      return controller_interface::CallbackReturn::ERROR;
+    }
 
-  joint_command_interface_ = *command_interface_it;
-  joint_position_state_interface_ = *position_state_interface_it;
-  joint_velocity_state_interface_ = *velocity_state_interface_it;
+    joint_command_interfaces_.emplace_back(*command_interface_it);
+    joint_position_state_interfaces_.emplace_back(*position_state_interface_it);
+    joint_velocity_state_interfaces_.emplace_back(*velocity_state_interface_it);
 
-  for (auto & interface : command_interfaces_)
-  {
-    if (interface.get_interface_name() == "set_gripper_max_effort")
+    // The measured effort is optional, the commanded max effort is reported if not available
+    joint_effort_state_interfaces_.emplace_back(std::nullopt);
+    const auto effort_state_interface_it =
+      find_state_interface(joint + "/" + hardware_interface::HW_IF_EFFORT);
+    if (effort_state_interface_it != state_interfaces_.end())
+    {
+      joint_effort_state_interfaces_.back() = *effort_state_interface_it;
+    }
+
+    effort_interfaces_.emplace_back(std::nullopt);
+    if (!max_effort_interface_names_[i].empty())
     {
-      effort_interface_ = interface;
+      const auto it = find_command_interface(max_effort_interface_names_[i]);
+      if (it != command_interfaces_.end())
+      {
+        effort_interfaces_.back() = *it;
+      }
     }
-    else if (interface.get_interface_name() == "set_gripper_max_velocity")
+    speed_interfaces_.emplace_back(std::nullopt);
+    if (!max_velocity_interface_names_[i].empty())
     {
-      speed_interface_ = interface;
+      const auto it = find_command_interface(max_velocity_interface_names_[i]);
+      if (it != command_interfaces_.end())
+      {
+        speed_interfaces_.back() = *it;
+      }
     }
   }
 
   // Command - non RT version
-  command_struct_.position_cmd_ = joint_position_state_interface_->get().get_value();
-  command_struct_.max_effort_ = params_.max_effort;
-  command_struct_.max_velocity_ = params_.max_velocity;
+  for (size_t i = 0; i < joint_names_.size(); ++i)
+  {
+    command_struct_[i].position_cmd_ = joint_position_state_interfaces_[i].get().get_value();
+    command_struct_[i].max_effort_ = params_.max_effort;
+    command_struct_[i].max_velocity_ = params_.max_velocity;
+    rt_goal_status_[i].store(GoalStatus::IDLE, std::memory_order_release);
+    rt_feedback_ready_[i].store(false, std::memory_order_release);
+    if (!motion_profiles_.empty())
+    {
+      motion_profiles_[i].reset(command_struct_[i].position_cmd_);
+    }
+  }
   command_.initRT(command_struct_);
+  command_struct_rt_ = command_struct_;
 
   // Result
-  pre_alloc_result_ = std::make_shared<control_msgs::action::ParallelGripperCommand::Result>();
-  pre_alloc_result_->state.position.resize(1);
-  pre_alloc_result_->state.effort.resize(1);
-  pre_alloc_result_->state.position[0] = command_struct_.position_cmd_;
-  pre_alloc_result_->reached_goal = false;
-  pre_alloc_result_->stalled = false;
-
-  // Action interface
-  action_server_ = rclcpp_action::create_server<control_msgs::action::ParallelGripperCommand>(
-    get_node(), "~/gripper_cmd",
-    std::bind(
-      &GripperActionController::goal_callback, this, std::placeholders::_1, std::placeholders::_2),
-    std::bind(&GripperActionController::cancel_callback, this, std::placeholders::_1),
-    std::bind(&GripperActionController::accepted_callback, this, std::placeholders::_1));
+  pre_alloc_result_.clear();
+  for (size_t i = 0; i < joint_names_.size(); ++i)
+  {
+    auto result = std::make_shared<control_msgs::action::ParallelGripperCommand::Result>();
+    result->state.position.resize(1);
+    result->state.effort.resize(1);
+    result->state.position[0] = command_struct_[i].position_cmd_;
+    result->reached_goal = false;
+    result->stalled = false;
+    pre_alloc_result_.push_back(result);
+  }
+
+  // Feedback
+  pre_alloc_feedback_.clear();
+  for (size_t i = 0; i < joint_names_.size(); ++i)
+  {
+    auto feedback = std::make_shared<control_msgs::action::ParallelGripperCommand::Feedback>();
+    feedback->state.name = {joint_names_[i]};
+    feedback->state.position.resize(1);
+    feedback->state.velocity.resize(1);
+    feedback->state.effort.resize(1);
+    pre_alloc_feedback_.push_back(feedback);
+  }
+
+  // Action interface, the original action name is kept if only one gripper is controlled
+  action_servers_.clear();
+  for (size_t i = 0; i < joint_names_.size(); ++i)
+  {
+    const std::string action_name =
+      joint_names_.size() == 1 ? "~/gripper_cmd" : "~/" + joint_names_[i] + "/gripper_cmd";
+    action_servers_.push_back(
+      rclcpp_action::create_server<control_msgs::action::ParallelGripperCommand>(
+        get_node(), action_name,
+        std::bind(
+          &GripperActionController::goal_callback, this, std::placeholders::_1,
+          std::placeholders::_2),
+        std::bind(&GripperActionController::cancel_callback, this, i, std::placeholders::_1),
+        std::bind(&GripperActionController::accepted_callback, this, i, std::placeholders::_1)));
+  }
 
   return controller_interface::CallbackReturn::SUCCESS;
 }
@@ -344,9 +558,16 @@ controller_interface::CallbackReturn GripperActionController::on_activate(
 controller_interface::CallbackReturn GripperActionController::on_deactivate(
   const rclcpp_lifecycle::State &)
 {
-  joint_command_interface_ = std::nullopt;
-  joint_position_state_interface_ = std::nullopt;
-  joint_velocity_state_interface_ = std::nullopt;
+  for (auto & goal_status : rt_goal_status_)
+  {
+    goal_status.store(GoalStatus::IDLE, std::memory_order_release);
+  }
+  joint_command_interfaces_.clear();
+  effort_interfaces_.clear();
+  speed_interfaces_.clear();
+  joint_position_state_interfaces_.clear();
+  joint_velocity_state_interfaces_.clear();
+  joint_effort_state_interfaces_.clear();
   release_interfaces();
   return controller_interface::CallbackReturn::SUCCESS;
 }
@@ -354,14 +575,18 @@ controller_interface::CallbackReturn GripperActionController::on_deactivate(
 controller_interface::InterfaceConfiguration
 GripperActionController::command_interface_configuration() const
 {
-  std::vector<std::string> names = {params_.joint + "/" + hardware_interface::HW_IF_POSITION};
-  if (!params_.max_effort_interface.empty())
+  std::vector<std::string> names;
+  for (size_t i = 0; i < joint_names_.size(); ++i)
   {
-    names.push_back({params_.max_effort_interface});
-  }
-  if (!params_.max_velocity_interface.empty())
-  {
-    names.push_back({params_.max_velocity_interface});
+    names.push_back(joint_names_[i] + "/" + hardware_interface::HW_IF_POSITION);
+    if (!max_effort_interface_names_[i].empty())
+    {
+      names.push_back({max_effort_interface_names_[i]});
+    }
+    if (!max_velocity_interface_names_[i].empty())
+    {
+      names.push_back({max_velocity_interface_names_[i]});
+    }
   }
 
   return {controller_interface::interface_configuration_type::INDIVIDUAL, names};
@@ -371,16 +596,20 @@ controller_interface::InterfaceConfiguration
 GripperActionController::state_interface_configuration() const
 {
   std::vector<std::string> interface_names;
-  for (const auto & interface : params_.state_interfaces)
+  for (const auto & joint : joint_names_)
   {
-    interface_names.push_back(params_.joint + "/" + interface);
+    for (const auto & interface : params_.state_interfaces)
+    {
+      interface_names.push_back(joint + "/" + interface);
+    }
   }
   return {controller_interface::interface_configuration_type::INDIVIDUAL, interface_names};
 }
 
 GripperActionController::GripperActionController()
 : controller_interface::ControllerInterface(),
-  action_monitor_period_(rclcpp::Duration::from_seconds(0))
+  action_monitor_period_(rclcpp::Duration::from_seconds(0)),
+  feedback_period_(rclcpp::Duration::from_seconds(0))
 {
 }
 
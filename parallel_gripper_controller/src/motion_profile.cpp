@@ -0,0 +1,120 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "parallel_gripper_controller/motion_profile.hpp"
+
+namespace parallel_gripper_action_controller
+{
+void MotionProfile::configure(double max_acceleration, double max_jerk, double period)
+{
+  if (!(max_acceleration > 0.0))
+  {
+    throw std::invalid_argument("Max acceleration of the motion profile must be positive.");
+  }
+  max_acceleration_ = max_acceleration;
+
+  velocity_window_.clear();
+  if (max_jerk > 0.0)
+  {
+    if (!(period > 0.0))
+    {
+      throw std::invalid_argument("Control period must be positive to limit the jerk.");
+    }
+    // Averaging over the ramp time max_acceleration / max_jerk limits the jerk
+    const auto window_size =
+      static_cast<size_t>(std::ceil(max_acceleration / (max_jerk * period) - 1e-9));
+    velocity_window_.resize(std::max<size_t>(window_size, 1));
+  }
+  reset(position_, velocity_);
+}
+
+void MotionProfile::reset(double position, double velocity)
+{
+  trapezoidal_position_ = position;
+  trapezoidal_velocity_ = velocity;
+  std::fill(velocity_window_.begin(), velocity_window_.end(), velocity);
+  window_index_ = 0;
+  window_sum_ = velocity * static_cast<double>(velocity_window_.size());
+  settled_cycles_ = 0;
+
+  position_ = position;
+  velocity_ = velocity;
+  acceleration_ = 0.0;
+}
+
+double MotionProfile::update_trapezoidal(double target, double max_velocity, double dt)
+{
+  const double error = target - trapezoidal_position_;
+  const double direction = error >= 0.0 ? 1.0 : -1.0;
+
+  // Discrete version of v^2 = 2 a d: braking from v = k a dt covers a dt^2 k (k + 1) / 2
+  const double dv = max_acceleration_ * dt;
+  double desired_velocity =
+    direction * dv * 0.5 * (std::sqrt(1.0 + 8.0 * std::fabs(error) / (dv * dt)) - 1.0);
+  if (max_velocity > 0.0)
+  {
+    desired_velocity = std::clamp(desired_velocity, -max_velocity, max_velocity);
+  }
+
+  double velocity =
+    trapezoidal_velocity_ + std::clamp(desired_velocity - trapezoidal_velocity_, -dv, dv);
+  // Land on the target instead of crossing it, the discretization would overshoot otherwise
+  if ((error - velocity * dt) * direction < 0.0)
+  {
+    velocity = error / dt;
+    trapezoidal_position_ = target;
+  }
+  else
+  {
+    trapezoidal_position_ += velocity * dt;
+  }
+  trapezoidal_velocity_ = velocity;
+  return velocity;
+}
+
+double MotionProfile::update(double target, double max_velocity, double dt)
+{
+  if (!(dt > 0.0))
+  {
+    return position_;
+  }
+
+  double velocity = update_trapezoidal(target, max_velocity, dt);
+  if (!velocity_window_.empty())
+  {
+    window_sum_ += velocity - velocity_window_[window_index_];
+    velocity_window_[window_index_] = velocity;
+    window_index_ = (window_index_ + 1) % velocity_window_.size();
+    velocity = window_sum_ / static_cast<double>(velocity_window_.size());
+  }
+
+  acceleration_ = (velocity - velocity_) / dt;
+  velocity_ = velocity;
+  position_ += velocity * dt;
+
+  // Remove the round-off of the running sum once the window only holds standstill samples
+  settled_cycles_ = trapezoidal_velocity_ == 0.0 ? settled_cycles_ + 1 : 0;
+  if (settled_cycles_ >= std::max<size_t>(velocity_window_.size(), 1))
+  {
+    window_sum_ = 0.0;
+    velocity_ = 0.0;
+    position_ = trapezoidal_position_;
+  }
+  return position_;
+}
+
+}  // namespace parallel_gripper_action_controller
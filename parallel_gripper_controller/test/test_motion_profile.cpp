@@ -0,0 +1,119 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "parallel_gripper_controller/motion_profile.hpp"
+
+using parallel_gripper_action_controller::MotionProfile;
+
+namespace
+{
+constexpr double dt = 0.001;
+constexpr double eps = 1e-9;
+}  // namespace
+
+TEST(MotionProfileTest, testWrongParams)
+{
+  MotionProfile profile;
+  EXPECT_THROW(profile.configure(0.0), std::invalid_argument);
+  EXPECT_THROW(profile.configure(-1.0), std::invalid_argument);
+  EXPECT_THROW(profile.configure(1.0, 10.0), std::invalid_argument);
+  EXPECT_THROW(profile.configure(1.0, 10.0, 0.0), std::invalid_argument);
+  EXPECT_NO_THROW(profile.configure(1.0, NAN));
+  EXPECT_NO_THROW(profile.configure(1.0, 10.0, 0.001));
+}
+
+TEST(MotionProfileTest, testTrapezoidalLimits)
+{
+  MotionProfile profile;
+  profile.configure(2.0);
+  profile.reset(0.0);
+
+  const double max_velocity = 0.1;
+  double last_velocity = 0.0;
+  int steps = 0;
+  while ((profile.position() != 0.08 || profile.velocity() != 0.0) && steps < 10000)
+  {
+    const double position = profile.update(0.08, max_velocity, dt);
+    EXPECT_LE(position, 0.08);
+    EXPECT_LE(std::fabs(profile.velocity()), max_velocity + eps);
+    EXPECT_LE(std::fabs(profile.velocity() - last_velocity) / dt, 2.0 + eps);
+    last_velocity = profile.velocity();
+    ++steps;
+  }
+  EXPECT_DOUBLE_EQ(profile.position(), 0.08);
+  EXPECT_DOUBLE_EQ(profile.velocity(), 0.0);
+  // accelerate 0.05s, cruise 0.75s, decelerate 0.05s
+  EXPECT_NEAR(steps * dt, 0.85, 0.01);
+}
+
+TEST(MotionProfileTest, testJerkLimits)
+{
+  MotionProfile profile;
+  profile.configure(2.0, 100.0, dt);
+  profile.reset(0.0);
+
+  double last_acceleration = 0.0;
+  int steps = 0;
+  while ((profile.position() != 0.08 || profile.velocity() != 0.0) && steps < 10000)
+  {
+    const double position = profile.update(0.08, 0.1, dt);
+    EXPECT_LE(position, 0.08 + eps);
+    EXPECT_LE(std::fabs(profile.velocity()), 0.1 + eps);
+    EXPECT_LE(std::fabs(profile.acceleration()), 2.0 + eps);
+    // 1e-6 accounts for the round-off of the running average
+    EXPECT_LE(std::fabs(profile.acceleration() - last_acceleration) / dt, 100.0 + 1e-6);
+    last_acceleration = profile.acceleration();
+    ++steps;
+  }
+  EXPECT_DOUBLE_EQ(profile.position(), 0.08);
+  // the trapezoidal profile delayed by the averaging window
+  EXPECT_NEAR(steps * dt, 0.85 + 0.02, 0.01);
+}
+
+TEST(MotionProfileTest, testTargetChange)
+{
+  MotionProfile profile;
+  profile.configure(1.0);
+  profile.reset(0.05);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    profile.update(0.1, 0.2, dt);
+  }
+  EXPECT_GT(profile.velocity(), 0.0);
+
+  // reverse, the setpoint has to slow down first and must never jump
+  double last_position = profile.position();
+  for (int i = 0; i < 5000; ++i)
+  {
+    const double position = profile.update(0.0, 0.2, dt);
+    EXPECT_LE(std::fabs(position - last_position), 0.2 * dt + eps);
+    last_position = position;
+  }
+  EXPECT_DOUBLE_EQ(profile.position(), 0.0);
+}
+
+TEST(MotionProfileTest, testInvalidPeriod)
+{
+  MotionProfile profile;
+  profile.configure(1.0);
+  profile.reset(0.02);
+  EXPECT_DOUBLE_EQ(profile.update(0.1, 0.1, 0.0), 0.02);
+  EXPECT_DOUBLE_EQ(profile.update(0.1, 0.1, -0.001), 0.02);
+}
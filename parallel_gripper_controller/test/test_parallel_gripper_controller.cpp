@@ -149,6 +149,171 @@ TEST_F(GripperControllerTest, ActivateDeactivateActivateSuccess)
     controller_interface::CallbackReturn::SUCCESS);
 }
 
+TEST_F(GripperControllerTest, GoalSuccessReportedFromUpdate)
+{
+  using GoalStatus = FriendGripperController::GoalStatus;
+  this->SetUpController();
+
+  ASSERT_EQ(
+    this->controller_->on_configure(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+  ASSERT_EQ(
+    this->controller_->on_activate(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+
+  // no goal, nothing is reported
+  const rclcpp::Time time(0, 0, RCL_ROS_TIME);
+  const rclcpp::Duration period = rclcpp::Duration::from_seconds(0.01);
+  ASSERT_EQ(this->controller_->update(time, period), controller_interface::return_type::OK);
+  EXPECT_EQ(this->controller_->rt_goal_status_[0].load(), GoalStatus::IDLE);
+
+  // the gripper is already at the commanded (hold) position
+  this->controller_->rt_goal_status_[0].store(GoalStatus::NEW);
+  ASSERT_EQ(this->controller_->update(time, period), controller_interface::return_type::OK);
+  EXPECT_EQ(this->controller_->rt_goal_status_[0].load(), GoalStatus::SUCCEEDED);
+  EXPECT_DOUBLE_EQ(this->controller_->rt_goal_outcome_[0].position_, joint_states_[0]);
+  // without effort state interface, the commanded max effort is reported
+  EXPECT_DOUBLE_EQ(
+    this->controller_->rt_goal_outcome_[0].effort_,
+    this->controller_->command_struct_[0].max_effort_);
+}
+
+TEST_F(GripperControllerTest, GoalStallReportedFromUpdate)
+{
+  using GoalStatus = FriendGripperController::GoalStatus;
+  this->SetUpController();
+
+  ASSERT_EQ(
+    this->controller_->on_configure(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+  ASSERT_EQ(
+    this->controller_->on_activate(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+
+  auto command = this->controller_->command_struct_;
+  command[0].position_cmd_ = joint_states_[0] + 1.0;
+  this->controller_->command_.writeFromNonRT(command);
+  joint_states_[1] = 0.0;
+
+  const rclcpp::Duration period = rclcpp::Duration::from_seconds(0.01);
+  this->controller_->rt_goal_status_[0].store(GoalStatus::NEW);
+  ASSERT_EQ(
+    this->controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), period),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(this->controller_->rt_goal_status_[0].load(), GoalStatus::ACTIVE);
+
+  // the stall timer is driven by the update time, not by the node clock
+  ASSERT_EQ(
+    this->controller_->update(rclcpp::Time(0, 500000000, RCL_ROS_TIME), period),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(this->controller_->rt_goal_status_[0].load(), GoalStatus::ACTIVE);
+  ASSERT_EQ(
+    this->controller_->update(rclcpp::Time(2, 0, RCL_ROS_TIME), period),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(this->controller_->rt_goal_status_[0].load(), GoalStatus::ABORTED);
+
+  // a canceled goal is not overwritten by the RT loop
+  this->controller_->rt_goal_status_[0].store(GoalStatus::IDLE);
+  ASSERT_EQ(
+    this->controller_->update(rclcpp::Time(3, 0, RCL_ROS_TIME), period),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(this->controller_->rt_goal_status_[0].load(), GoalStatus::IDLE);
+}
+
+TEST_F(GripperControllerTest, FeedbackSampledFromUpdate)
+{
+  using GoalStatus = FriendGripperController::GoalStatus;
+  this->SetUpController();
+
+  ASSERT_EQ(
+    this->controller_->on_configure(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+  ASSERT_EQ(
+    this->controller_->on_activate(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+  // feedback is disabled by default
+  EXPECT_EQ(this->controller_->feedback_period_.nanoseconds(), 0);
+  this->controller_->feedback_period_ = rclcpp::Duration::from_seconds(0.1);
+
+  auto command = this->controller_->command_struct_;
+  command[0].position_cmd_ = joint_states_[0] + 1.0;
+  this->controller_->command_.writeFromNonRT(command);
+  this->controller_->rt_goal_status_[0].store(GoalStatus::NEW);
+
+  const rclcpp::Duration period = rclcpp::Duration::from_seconds(0.01);
+  ASSERT_EQ(
+    this->controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), period),
+    controller_interface::return_type::OK);
+  EXPECT_FALSE(this->controller_->rt_feedback_ready_[0].load());
+  ASSERT_EQ(
+    this->controller_->update(rclcpp::Time(0, 50000000, RCL_ROS_TIME), period),
+    controller_interface::return_type::OK);
+  EXPECT_FALSE(this->controller_->rt_feedback_ready_[0].load());
+  ASSERT_EQ(
+    this->controller_->update(rclcpp::Time(0, 100000000, RCL_ROS_TIME), period),
+    controller_interface::return_type::OK);
+  ASSERT_TRUE(this->controller_->rt_feedback_ready_[0].load());
+  EXPECT_DOUBLE_EQ(this->controller_->rt_feedback_sample_[0].position_, joint_states_[0]);
+  EXPECT_DOUBLE_EQ(this->controller_->rt_feedback_sample_[0].velocity_, joint_states_[1]);
+  EXPECT_DOUBLE_EQ(this->controller_->rt_feedback_sample_[0].effort_, command[0].max_effort_);
+}
+
+TEST_F(GripperControllerTest, MultiGripperConfigureAndUpdate)
+{
+  using GoalStatus = FriendGripperController::GoalStatus;
+  const auto result = controller_->init(
+    "test_gripper_action_position_controller_multi", "", 0, "",
+    controller_->define_custom_node_options());
+  ASSERT_EQ(result, controller_interface::return_type::OK);
+
+  ASSERT_EQ(
+    this->controller_->on_configure(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+
+  auto cmd_if_conf = this->controller_->command_interface_configuration();
+  ASSERT_THAT(
+    cmd_if_conf.names,
+    UnorderedElementsAre(
+      "joint1/position", "joint2/position", "joint2/set_gripper_max_effort"));
+  auto state_if_conf = this->controller_->state_interface_configuration();
+  ASSERT_THAT(
+    state_if_conf.names,
+    UnorderedElementsAre(
+      "joint1/position", "joint1/velocity", "joint2/position", "joint2/velocity"));
+
+  std::vector<LoanedCommandInterface> command_ifs;
+  command_ifs.emplace_back(this->joint_1_cmd_);
+  command_ifs.emplace_back(this->joint_2_cmd_);
+  command_ifs.emplace_back(this->joint_2_max_effort_cmd_);
+  std::vector<LoanedStateInterface> state_ifs;
+  state_ifs.emplace_back(this->joint_1_pos_state_);
+  state_ifs.emplace_back(this->joint_1_vel_state_);
+  state_ifs.emplace_back(this->joint_2_pos_state_);
+  state_ifs.emplace_back(this->joint_2_vel_state_);
+  controller_->assign_interfaces(std::move(command_ifs), std::move(state_ifs));
+
+  ASSERT_EQ(
+    this->controller_->on_activate(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+  ASSERT_THAT(this->controller_->action_servers_, SizeIs(2lu));
+
+  // command only the second gripper
+  auto command = this->controller_->command_struct_;
+  command[1].position_cmd_ = 0.5;
+  command[1].max_effort_ = 3.0;
+  this->controller_->command_.writeFromNonRT(command);
+  this->controller_->rt_goal_status_[1].store(GoalStatus::NEW);
+
+  const rclcpp::Time time(0, 0, RCL_ROS_TIME);
+  const rclcpp::Duration period = rclcpp::Duration::from_seconds(0.01);
+  ASSERT_EQ(this->controller_->update(time, period), controller_interface::return_type::OK);
+  EXPECT_DOUBLE_EQ(joint_commands_[0], joint_states_[0]);
+  EXPECT_DOUBLE_EQ(joint_2_commands_[0], 0.5);
+  EXPECT_DOUBLE_EQ(joint_2_commands_[1], 3.0);
+  EXPECT_EQ(this->controller_->rt_goal_status_[0].load(), GoalStatus::IDLE);
+  EXPECT_EQ(this->controller_->rt_goal_status_[1].load(), GoalStatus::ACTIVE);
+}
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleMock(&argc, argv);
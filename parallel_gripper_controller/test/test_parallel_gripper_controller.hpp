@@ -31,6 +31,10 @@ namespace
 class FriendGripperController : public parallel_gripper_action_controller::GripperActionController
 {
   FRIEND_TEST(GripperControllerTest, CommandSuccessTest);
+  FRIEND_TEST(GripperControllerTest, GoalSuccessReportedFromUpdate);
+  FRIEND_TEST(GripperControllerTest, GoalStallReportedFromUpdate);
+  FRIEND_TEST(GripperControllerTest, MultiGripperConfigureAndUpdate);
+  FRIEND_TEST(GripperControllerTest, FeedbackSampledFromUpdate);
 };
 
 class GripperControllerTest : public ::testing::Test
@@ -60,6 +64,20 @@ protected:
     joint_name_, hardware_interface::HW_IF_VELOCITY, &joint_states_[1]};
   hardware_interface::CommandInterface joint_1_cmd_{
     joint_name_, hardware_interface::HW_IF_POSITION, &joint_commands_[0]};
+
+  // second gripper, used by the multi gripper tests
+  const std::string joint_2_name_ = "joint2";
+  std::vector<double> joint_2_states_ = {0.2, 0.0};
+  std::vector<double> joint_2_commands_ = {0.0, 0.0};
+
+  hardware_interface::StateInterface joint_2_pos_state_{
+    joint_2_name_, hardware_interface::HW_IF_POSITION, &joint_2_states_[0]};
+  hardware_interface::StateInterface joint_2_vel_state_{
+    joint_2_name_, hardware_interface::HW_IF_VELOCITY, &joint_2_states_[1]};
+  hardware_interface::CommandInterface joint_2_cmd_{
+    joint_2_name_, hardware_interface::HW_IF_POSITION, &joint_2_commands_[0]};
+  hardware_interface::CommandInterface joint_2_max_effort_cmd_{
+    joint_2_name_, "set_gripper_max_effort", &joint_2_commands_[1]};
 };
 
 }  // anonymous namespace
@@ -25,6 +25,7 @@
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
 #include "semantic_components/pose_sensor.hpp"
+#include "sensor_broadcasters_common/publish_policy.hpp"
 #include "tf2_msgs/msg/tf_message.hpp"
 
 #include "pose_broadcaster/pose_broadcaster_parameters.hpp"
@@ -53,7 +54,12 @@ public:
   controller_interface::return_type update(
     const rclcpp::Time & time, const rclcpp::Duration & period) override;
 
-private:
+protected:
+  /// True if the pose did not leave the deadband around the last published transform and that
+  /// transform is more recent than tf.deadband.max_silence.
+  bool is_within_tf_deadband(
+    const geometry_msgs::msg::Pose & pose, const rclcpp::Time & time) const;
+
   std::shared_ptr<ParamListener> param_listener_;
   Params params_;
 
@@ -66,6 +72,19 @@ private:
   rclcpp::Publisher<tf2_msgs::msg::TFMessage>::SharedPtr tf_publisher_;
   std::unique_ptr<realtime_tools::RealtimePublisher<tf2_msgs::msg::TFMessage>>
     realtime_tf_publisher_;
+
+  // Reduces the poses between two publications, sampled as position and orientation (x, y, z, w)
+  std::array<double, 7> pose_sample_;
+  sensor_broadcasters_common::PublishPolicy publish_policy_;
+  geometry_msgs::msg::Pose pose_;
+
+  // The transform is published every tf_decimation_ pose publications, if it left the deadband
+  size_t tf_decimation_ = 1;
+  size_t tf_skipped_publications_ = 0;
+  bool tf_deadband_enabled_ = false;
+  double cos_half_tf_deadband_orientation_ = 1.0;
+  std::optional<geometry_msgs::msg::Pose> last_tf_pose_;
+  double last_tf_seconds_ = 0.0;
 };
 
 }  // namespace pose_broadcaster
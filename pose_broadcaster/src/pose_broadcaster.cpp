@@ -13,6 +13,7 @@
 // limitations under the License.
 #include "pose_broadcaster/pose_broadcaster.hpp"
 #include <cmath>
+#include <stdexcept>
 #include <rclcpp/logging.hpp>
 
 namespace
@@ -79,6 +80,23 @@ controller_interface::CallbackReturn PoseBroadcaster::on_configure(
 
   pose_sensor_ = std::make_unique<semantic_components::PoseSensor>(params_.pose_name);
 
+  try
+  {
+    publish_policy_.configure_from_params(
+      pose_sample_.size(), static_cast<double>(get_update_rate()), params_.publish_policy);
+    tf_decimation_ = sensor_broadcasters_common::PublishPolicy::decimation_from_rates(
+      static_cast<double>(get_update_rate()) / static_cast<double>(publish_policy_.decimation()),
+      params_.tf.rate);
+  }
+  catch (const std::invalid_argument & ex)
+  {
+    RCLCPP_ERROR(get_node()->get_logger(), "Invalid publish policy: %s", ex.what());
+    return controller_interface::CallbackReturn::ERROR;
+  }
+  tf_deadband_enabled_ =
+    params_.tf.deadband.position > 0.0 || params_.tf.deadband.orientation > 0.0;
+  cos_half_tf_deadband_orientation_ = std::cos(0.5 * params_.tf.deadband.orientation);
+
   try
   {
     pose_publisher_ = get_node()->create_publisher<geometry_msgs::msg::PoseStamped>(
@@ -136,6 +154,9 @@ controller_interface::CallbackReturn PoseBroadcaster::on_activate(
   const rclcpp_lifecycle::State & /*previous_state*/)
 {
   pose_sensor_->assign_loaned_state_interfaces(state_interfaces_);
+  publish_policy_.reset();
+  tf_skipped_publications_ = tf_decimation_ - 1;
+  last_tf_pose_.reset();
   return controller_interface::CallbackReturn::SUCCESS;
 }
 
@@ -146,41 +167,100 @@ controller_interface::CallbackReturn PoseBroadcaster::on_deactivate(
   return controller_interface::CallbackReturn::SUCCESS;
 }
 
+bool PoseBroadcaster::is_within_tf_deadband(
+  const geometry_msgs::msg::Pose & pose, const rclcpp::Time & time) const
+{
+  if (
+    !tf_deadband_enabled_ || !last_tf_pose_ ||
+    time.seconds() - last_tf_seconds_ >= params_.tf.deadband.max_silence)
+  {
+    return false;
+  }
+  const auto & last = *last_tf_pose_;
+  const double dx = pose.position.x - last.position.x;
+  const double dy = pose.position.y - last.position.y;
+  const double dz = pose.position.z - last.position.z;
+  const double max_distance = params_.tf.deadband.position;
+  if (dx * dx + dy * dy + dz * dz > max_distance * max_distance)
+  {
+    return false;
+  }
+  // the rotation angle between two unit quaternions is 2 acos(|q1 . q2|)
+  const double dot =
+    pose.orientation.x * last.orientation.x + pose.orientation.y * last.orientation.y +
+    pose.orientation.z * last.orientation.z + pose.orientation.w * last.orientation.w;
+  return std::abs(dot) >= cos_half_tf_deadband_orientation_;
+}
+
 controller_interface::return_type PoseBroadcaster::update(
   const rclcpp::Time & time, const rclcpp::Duration & /*period*/)
 {
-  geometry_msgs::msg::Pose pose;
-  pose_sensor_->get_values_as_message(pose);
+  pose_sensor_->get_values_as_message(pose_);
+
+  pose_sample_ = {
+    {pose_.position.x, pose_.position.y, pose_.position.z, pose_.orientation.x,
+     pose_.orientation.y, pose_.orientation.z, pose_.orientation.w}};
+  if (!publish_policy_.add_sample(pose_sample_))
+  {
+    return controller_interface::return_type::OK;
+  }
+
+  const auto & sample = publish_policy_.output();
+  pose_.position.x = sample[0];
+  pose_.position.y = sample[1];
+  pose_.position.z = sample[2];
+  using sensor_broadcasters_common::Reduction;
+  const auto reduction = publish_policy_.reduction();
+  const double norm = std::sqrt(
+    sample[3] * sample[3] + sample[4] * sample[4] + sample[5] * sample[5] + sample[6] * sample[6]);
+  if ((reduction == Reduction::AVERAGE || reduction == Reduction::CIC) && norm > 0.0)
+  {
+    // the filtered quaternion has to be normalized again, extrema of the quaternion components
+    // are no orientation and the latest one is kept
+    pose_.orientation.x = sample[3] / norm;
+    pose_.orientation.y = sample[4] / norm;
+    pose_.orientation.z = sample[5] / norm;
+    pose_.orientation.w = sample[6] / norm;
+  }
 
   if (realtime_publisher_ && realtime_publisher_->trylock())
   {
     realtime_publisher_->msg_.header.stamp = time;
-    realtime_publisher_->msg_.pose = pose;
+    realtime_publisher_->msg_.pose = pose_;
     realtime_publisher_->unlockAndPublish();
   }
-  if (!is_pose_valid(pose))
+
+  if (!realtime_tf_publisher_ || ++tf_skipped_publications_ < tf_decimation_)
+  {
+    return controller_interface::return_type::OK;
+  }
+  tf_skipped_publications_ = 0;
+
+  if (!is_pose_valid(pose_))
   {
     RCLCPP_ERROR_THROTTLE(
       get_node()->get_logger(), *get_node()->get_clock(), 1000,
-      "Invalid pose [%f, %f, %f], [%f, %f, %f, %f]", pose.position.x, pose.position.y,
-      pose.position.z, pose.orientation.x, pose.orientation.y, pose.orientation.z,
-      pose.orientation.w);
+      "Invalid pose [%f, %f, %f], [%f, %f, %f, %f]", pose_.position.x, pose_.position.y,
+      pose_.position.z, pose_.orientation.x, pose_.orientation.y, pose_.orientation.z,
+      pose_.orientation.w);
   }
-  else if (realtime_tf_publisher_ && realtime_tf_publisher_->trylock())
+  else if (!is_within_tf_deadband(pose_, time) && realtime_tf_publisher_->trylock())
   {
     auto & tf_transform = realtime_tf_publisher_->msg_.transforms[0];
     tf_transform.header.stamp = time;
 
-    tf_transform.transform.translation.x = pose.position.x;
-    tf_transform.transform.translation.y = pose.position.y;
-    tf_transform.transform.translation.z = pose.position.z;
+    tf_transform.transform.translation.x = pose_.position.x;
+    tf_transform.transform.translation.y = pose_.position.y;
+    tf_transform.transform.translation.z = pose_.position.z;
 
-    tf_transform.transform.rotation.x = pose.orientation.x;
-    tf_transform.transform.rotation.y = pose.orientation.y;
-    tf_transform.transform.rotation.z = pose.orientation.z;
-    tf_transform.transform.rotation.w = pose.orientation.w;
+    tf_transform.transform.rotation.x = pose_.orientation.x;
+    tf_transform.transform.rotation.y = pose_.orientation.y;
+    tf_transform.transform.rotation.z = pose_.orientation.z;
+    tf_transform.transform.rotation.w = pose_.orientation.w;
 
     realtime_tf_publisher_->unlockAndPublish();
+    last_tf_pose_ = pose_;
+    last_tf_seconds_ = time.seconds();
   }
 
   return controller_interface::return_type::OK;
@@ -24,11 +24,11 @@ void PoseBroadcasterTest::SetUp() { pose_broadcaster_ = std::make_unique<PoseBro
 
 void PoseBroadcasterTest::TearDown() { pose_broadcaster_.reset(nullptr); }
 
-void PoseBroadcasterTest::SetUpPoseBroadcaster()
+void PoseBroadcasterTest::SetUpPoseBroadcaster(const std::string & controller_name)
 {
   ASSERT_EQ(
     pose_broadcaster_->init(
-      "test_pose_broadcaster", "", 0, "", pose_broadcaster_->define_custom_node_options()),
+      controller_name, "", 0, "", pose_broadcaster_->define_custom_node_options()),
     controller_interface::return_type::OK);
 
   std::vector<LoanedStateInterface> state_interfaces;
@@ -242,6 +242,50 @@ TEST_F(PoseBroadcasterTest, invalid_pose_no_tf_published)
   ASSERT_EQ(tf_msg.transforms.size(), 0lu);
 }
 
+TEST_F(PoseBroadcasterTest, tf_suppressed_within_deadband)
+{
+  SetUpPoseBroadcaster("test_pose_broadcaster_deadband");
+
+  // Set 'pose_name' and 'frame_id' parameters
+  pose_broadcaster_->get_node()->set_parameter({"pose_name", pose_name_});
+  pose_broadcaster_->get_node()->set_parameter({"frame_id", frame_id_});
+
+  // Configure and activate controller
+  ASSERT_EQ(
+    pose_broadcaster_->on_configure(rclcpp_lifecycle::State{}),
+    controller_interface::CallbackReturn::SUCCESS);
+  ASSERT_EQ(
+    pose_broadcaster_->on_activate(rclcpp_lifecycle::State{}),
+    controller_interface::CallbackReturn::SUCCESS);
+
+  // The first transform is always published
+  tf2_msgs::msg::TFMessage tf_msg;
+  subscribe_and_get_message("/tf", tf_msg);
+  ASSERT_EQ(tf_msg.transforms.size(), 1lu);
+  EXPECT_EQ(tf_msg.transforms[0].transform.translation.x, pose_values_[0]);
+
+  // Moving within the deadband publishes the pose, but no transform
+  ASSERT_TRUE(pose_position_x_.set_value(pose_values_[0] + 0.05));
+  geometry_msgs::msg::PoseStamped pose_msg;
+  subscribe_and_get_message("/test_pose_broadcaster_deadband/pose", pose_msg);
+  EXPECT_EQ(pose_msg.pose.position.x, pose_values_[0]);
+  EXPECT_THROW(subscribe_and_get_message("/tf", tf_msg), std::runtime_error);
+
+  // Leaving it publishes the transform again
+  ASSERT_TRUE(pose_position_x_.set_value(pose_values_[0] + 0.2));
+  subscribe_and_get_message("/tf", tf_msg);
+  ASSERT_EQ(tf_msg.transforms.size(), 1lu);
+  EXPECT_EQ(tf_msg.transforms[0].transform.translation.x, pose_values_[0]);
+
+  // Within the deadband the transform is republished after tf.deadband.max_silence
+  EXPECT_THROW(
+    subscribe_and_get_message("/tf", tf_msg, rclcpp::Time{500000000}), std::runtime_error);
+  subscribe_and_get_message("/tf", tf_msg, rclcpp::Time{1000000000});
+  ASSERT_EQ(tf_msg.transforms.size(), 1lu);
+  EXPECT_EQ(tf_msg.transforms[0].transform.translation.x, pose_values_[0]);
+  EXPECT_EQ(rclcpp::Time(tf_msg.transforms[0].header.stamp).nanoseconds(), 1000000000);
+}
+
 int main(int argc, char * argv[])
 {
   ::testing::InitGoogleMock(&argc, argv);
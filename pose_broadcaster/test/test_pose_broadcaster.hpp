@@ -32,7 +32,7 @@ public:
   void SetUp();
   void TearDown();
 
-  void SetUpPoseBroadcaster();
+  void SetUpPoseBroadcaster(const std::string & controller_name = "test_pose_broadcaster");
 
 protected:
   const std::string pose_name_ = "test_pose";
@@ -57,11 +57,13 @@ protected:
   std::unique_ptr<PoseBroadcaster> pose_broadcaster_;
 
   template <typename T>
-  void subscribe_and_get_message(const std::string & topic, T & msg);
+  void subscribe_and_get_message(
+    const std::string & topic, T & msg, const rclcpp::Time & time = rclcpp::Time{0});
 };
 
 template <typename T>
-void PoseBroadcasterTest::subscribe_and_get_message(const std::string & topic, T & msg)
+void PoseBroadcasterTest::subscribe_and_get_message(
+  const std::string & topic, T & msg, const rclcpp::Time & time)
 {
   // Create node for subscribing
   rclcpp::Node node{"test_subscription_node"};
@@ -83,7 +85,7 @@ void PoseBroadcasterTest::subscribe_and_get_message(const std::string & topic, T
       throw std::runtime_error("Failed to receive message on topic: " + topic);
     }
 
-    pose_broadcaster_->update(rclcpp::Time{0}, rclcpp::Duration::from_seconds(0.01));
+    pose_broadcaster_->update(time, rclcpp::Duration::from_seconds(0.01));
 
     const auto timeout = std::chrono::milliseconds{5};
     const auto until = node.get_clock()->now() + timeout;
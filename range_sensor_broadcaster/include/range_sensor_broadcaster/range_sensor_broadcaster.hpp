@@ -20,12 +20,15 @@
 #define RANGE_SENSOR_BROADCASTER__RANGE_SENSOR_BROADCASTER_HPP_
 
 #include <memory>
+#include <vector>
 
 #include "controller_interface/controller_interface.hpp"
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
 #include "semantic_components/range_sensor.hpp"
+#include "sensor_broadcasters_common/publish_policy.hpp"
 #include "sensor_msgs/msg/range.hpp"
+#include "std_msgs/msg/float64_multi_array.hpp"
 
 #include "range_sensor_broadcaster/range_sensor_broadcaster_parameters.hpp"
 
@@ -55,11 +58,22 @@ protected:
   std::shared_ptr<ParamListener> param_listener_;
   Params params_;
 
-  std::unique_ptr<semantic_components::RangeSensor> range_sensor_;
+  // One sensor for ``sensor_name``, or the sensors of ``sensor_names`` in that order
+  std::vector<std::unique_ptr<semantic_components::RangeSensor>> range_sensors_;
 
   using StatePublisher = realtime_tools::RealtimePublisher<sensor_msgs::msg::Range>;
-  rclcpp::Publisher<sensor_msgs::msg::Range>::SharedPtr sensor_state_publisher_;
-  std::unique_ptr<StatePublisher> realtime_publisher_;
+  std::vector<rclcpp::Publisher<sensor_msgs::msg::Range>::SharedPtr> sensor_state_publishers_;
+  std::vector<std::unique_ptr<StatePublisher>> realtime_publishers_;
+
+  // All ranges in a single message, if ``packed`` is set
+  using PackedPublisher = realtime_tools::RealtimePublisher<std_msgs::msg::Float64MultiArray>;
+  rclcpp::Publisher<std_msgs::msg::Float64MultiArray>::SharedPtr packed_publisher_;
+  std::unique_ptr<PackedPublisher> realtime_packed_publisher_;
+
+  // Latest readings of all sensors and the publish policy reducing them between two publications
+  sensor_msgs::msg::Range range_state_;
+  std::vector<double> ranges_;
+  sensor_broadcasters_common::PublishPolicy publish_policy_;
 };
 
 }  // namespace range_sensor_broadcaster
@@ -18,8 +18,11 @@
 
 #include "range_sensor_broadcaster/range_sensor_broadcaster.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace range_sensor_broadcaster
 {
@@ -44,26 +47,80 @@ controller_interface::CallbackReturn RangeSensorBroadcaster::on_configure(
   const rclcpp_lifecycle::State & /*previous_state*/)
 {
   params_ = param_listener_->get_params();
-  if (params_.sensor_name.empty())
+  const bool multi_sensor = !params_.sensor_names.empty();
+  if (params_.sensor_name.empty() && !multi_sensor)
   {
     RCLCPP_ERROR(get_node()->get_logger(), "'sensor_name' parameter has to be specified.");
     return CallbackReturn::ERROR;
   }
+  if (!params_.sensor_name.empty() && multi_sensor)
+  {
+    RCLCPP_ERROR(
+      get_node()->get_logger(),
+      "'sensor_name' and 'sensor_names' parameters can not be specified together.");
+    return CallbackReturn::ERROR;
+  }
 
-  if (params_.frame_id.empty())
+  if (!multi_sensor && params_.frame_id.empty())
   {
     RCLCPP_ERROR(get_node()->get_logger(), "'frame_id' parameter has to be provided.");
     return CallbackReturn::ERROR;
   }
+  if (multi_sensor && params_.frame_ids.size() != params_.sensor_names.size())
+  {
+    RCLCPP_ERROR(
+      get_node()->get_logger(),
+      "'frame_ids' parameter has to provide a frame_id for each of the %zu sensors.",
+      params_.sensor_names.size());
+    return CallbackReturn::ERROR;
+  }
+
+  const auto sensor_names =
+    multi_sensor ? params_.sensor_names : std::vector<std::string>{params_.sensor_name};
+  const auto frame_ids =
+    multi_sensor ? params_.frame_ids : std::vector<std::string>{params_.frame_id};
+  range_sensors_.clear();
+  for (const auto & sensor_name : sensor_names)
+  {
+    range_sensors_.push_back(std::make_unique<semantic_components::RangeSensor>(
+      semantic_components::RangeSensor(sensor_name)));
+  }
+  ranges_.assign(range_sensors_.size(), 0.0);
 
-  range_sensor_ = std::make_unique<semantic_components::RangeSensor>(
-    semantic_components::RangeSensor(params_.sensor_name));
   try
   {
-    // register ft sensor data publisher
-    sensor_state_publisher_ =
-      get_node()->create_publisher<sensor_msgs::msg::Range>("~/range", rclcpp::SystemDefaultsQoS());
-    realtime_publisher_ = std::make_unique<StatePublisher>(sensor_state_publisher_);
+    publish_policy_.configure_from_params(
+      ranges_.size(), static_cast<double>(get_update_rate()), params_.publish_policy);
+  }
+  catch (const std::invalid_argument & e)
+  {
+    RCLCPP_ERROR(get_node()->get_logger(), "Invalid publish policy: %s", e.what());
+    return CallbackReturn::ERROR;
+  }
+
+  sensor_state_publishers_.clear();
+  realtime_publishers_.clear();
+  packed_publisher_.reset();
+  realtime_packed_publisher_.reset();
+  try
+  {
+    // register range sensor data publishers
+    if (multi_sensor && params_.packed)
+    {
+      packed_publisher_ = get_node()->create_publisher<std_msgs::msg::Float64MultiArray>(
+        "~/ranges", rclcpp::SystemDefaultsQoS());
+      realtime_packed_publisher_ = std::make_unique<PackedPublisher>(packed_publisher_);
+    }
+    else
+    {
+      for (const auto & sensor_name : sensor_names)
+      {
+        sensor_state_publishers_.push_back(get_node()->create_publisher<sensor_msgs::msg::Range>(
+          multi_sensor ? "~/" + sensor_name + "/range" : "~/range", rclcpp::SystemDefaultsQoS()));
+        realtime_publishers_.push_back(
+          std::make_unique<StatePublisher>(sensor_state_publishers_.back()));
+      }
+    }
   }
   catch (const std::exception & e)
   {
@@ -73,17 +130,34 @@ controller_interface::CallbackReturn RangeSensorBroadcaster::on_configure(
     return CallbackReturn::ERROR;
   }
 
-  realtime_publisher_->lock();
-  realtime_publisher_->msg_.header.frame_id = params_.frame_id;
-  realtime_publisher_->msg_.radiation_type = static_cast<uint8_t>(params_.radiation_type);
-  realtime_publisher_->msg_.field_of_view = static_cast<float>(params_.field_of_view);
-  realtime_publisher_->msg_.min_range = static_cast<float>(params_.min_range);
-  realtime_publisher_->msg_.max_range = static_cast<float>(params_.max_range);
+  for (size_t i = 0; i < realtime_publishers_.size(); ++i)
+  {
+    auto & realtime_publisher = realtime_publishers_[i];
+    realtime_publisher->lock();
+    realtime_publisher->msg_.header.frame_id = frame_ids[i];
+    realtime_publisher->msg_.radiation_type = static_cast<uint8_t>(params_.radiation_type);
+    realtime_publisher->msg_.field_of_view = static_cast<float>(params_.field_of_view);
+    realtime_publisher->msg_.min_range = static_cast<float>(params_.min_range);
+    realtime_publisher->msg_.max_range = static_cast<float>(params_.max_range);
 // \note The versions conditioning is added here to support the source-compatibility with Humble
 #if SENSOR_MSGS_VERSION_MAJOR >= 5
-  realtime_publisher_->msg_.variance = params_.variance;
+    realtime_publisher->msg_.variance = params_.variance;
 #endif
-  realtime_publisher_->unlock();
+    realtime_publisher->unlock();
+  }
+
+  if (realtime_packed_publisher_)
+  {
+    realtime_packed_publisher_->lock();
+    auto & msg = realtime_packed_publisher_->msg_;
+    msg.layout.dim.resize(1);
+    msg.layout.dim[0].label = "fields";
+    msg.layout.dim[0].size = static_cast<uint32_t>(2 + ranges_.size());
+    msg.layout.dim[0].stride = msg.layout.dim[0].size;
+    msg.layout.data_offset = 0;
+    msg.data.assign(2 + ranges_.size(), 0.0);
+    realtime_packed_publisher_->unlock();
+  }
 
   RCLCPP_DEBUG(get_node()->get_logger(), "configure successful");
   return CallbackReturn::SUCCESS;
@@ -102,32 +176,69 @@ controller_interface::InterfaceConfiguration RangeSensorBroadcaster::state_inter
 {
   controller_interface::InterfaceConfiguration state_interfaces_config;
   state_interfaces_config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
-  state_interfaces_config.names = range_sensor_->get_state_interface_names();
+  for (const auto & range_sensor : range_sensors_)
+  {
+    const auto names = range_sensor->get_state_interface_names();
+    state_interfaces_config.names.insert(
+      state_interfaces_config.names.end(), names.begin(), names.end());
+  }
   return state_interfaces_config;
 }
 
 controller_interface::CallbackReturn RangeSensorBroadcaster::on_activate(
   const rclcpp_lifecycle::State & /*previous_state*/)
 {
-  range_sensor_->assign_loaned_state_interfaces(state_interfaces_);
+  for (auto & range_sensor : range_sensors_)
+  {
+    range_sensor->assign_loaned_state_interfaces(state_interfaces_);
+  }
+  publish_policy_.reset();
   return CallbackReturn::SUCCESS;
 }
 
 controller_interface::CallbackReturn RangeSensorBroadcaster::on_deactivate(
   const rclcpp_lifecycle::State & /*previous_state*/)
 {
-  range_sensor_->release_interfaces();
+  for (auto & range_sensor : range_sensors_)
+  {
+    range_sensor->release_interfaces();
+  }
   return CallbackReturn::SUCCESS;
 }
 
 controller_interface::return_type RangeSensorBroadcaster::update(
   const rclcpp::Time & time, const rclcpp::Duration & /*period*/)
 {
-  if (realtime_publisher_ && realtime_publisher_->trylock())
+  for (size_t i = 0; i < range_sensors_.size(); ++i)
+  {
+    range_sensors_[i]->get_values_as_message(range_state_);
+    ranges_[i] = static_cast<double>(range_state_.range);
+  }
+  if (!publish_policy_.add_sample(ranges_.data()))
+  {
+    return controller_interface::return_type::OK;
+  }
+
+  const auto & sample = publish_policy_.output();
+  for (size_t i = 0; i < realtime_publishers_.size(); ++i)
+  {
+    auto & realtime_publisher = realtime_publishers_[i];
+    if (realtime_publisher->trylock())
+    {
+      realtime_publisher->msg_.header.stamp = time;
+      realtime_publisher->msg_.range = static_cast<float>(sample[i]);
+      realtime_publisher->unlockAndPublish();
+    }
+  }
+
+  if (realtime_packed_publisher_ && realtime_packed_publisher_->trylock())
   {
-    realtime_publisher_->msg_.header.stamp = time;
-    range_sensor_->get_values_as_message(realtime_publisher_->msg_);
-    realtime_publisher_->unlockAndPublish();
+    auto & data = realtime_packed_publisher_->msg_.data;
+    const int64_t nanoseconds = time.nanoseconds();
+    data[0] = static_cast<double>(nanoseconds / 1000000000);
+    data[1] = static_cast<double>(nanoseconds % 1000000000);
+    std::copy(sample.begin(), sample.end(), data.begin() + 2);
+    realtime_packed_publisher_->unlockAndPublish();
   }
 
   return controller_interface::return_type::OK;
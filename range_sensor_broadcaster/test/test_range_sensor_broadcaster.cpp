@@ -36,11 +36,11 @@ void RangeSensorBroadcasterTest::SetUp()
 void RangeSensorBroadcasterTest::TearDown() { range_broadcaster_.reset(nullptr); }
 
 controller_interface::return_type RangeSensorBroadcasterTest::init_broadcaster(
-  std::string broadcaster_name)
+  std::string broadcaster_name, unsigned int update_rate)
 {
   controller_interface::return_type result = controller_interface::return_type::ERROR;
   result = range_broadcaster_->init(
-    broadcaster_name, "", 0, "", range_broadcaster_->define_custom_node_options());
+    broadcaster_name, "", update_rate, "", range_broadcaster_->define_custom_node_options());
 
   if (controller_interface::return_type::OK == result)
   {
@@ -65,14 +65,16 @@ controller_interface::CallbackReturn RangeSensorBroadcasterTest::configure_broad
   return range_broadcaster_->on_configure(rclcpp_lifecycle::State());
 }
 
-void RangeSensorBroadcasterTest::subscribe_and_get_message(sensor_msgs::msg::Range & range_msg)
+template <typename MessageT>
+void RangeSensorBroadcasterTest::subscribe_and_get_message(
+  MessageT & msg, const std::string & topic)
 {
   // create a new subscriber
-  sensor_msgs::msg::Range::SharedPtr received_msg;
+  typename MessageT::SharedPtr received_msg;
   rclcpp::Node test_subscription_node("test_subscription_node");
-  auto subs_callback = [&](const sensor_msgs::msg::Range::SharedPtr msg) { received_msg = msg; };
-  auto subscription = test_subscription_node.create_subscription<sensor_msgs::msg::Range>(
-    "/test_range_sensor_broadcaster/range", 10, subs_callback);
+  auto subs_callback = [&](const typename MessageT::SharedPtr sub_msg) { received_msg = sub_msg; };
+  auto subscription =
+    test_subscription_node.create_subscription<MessageT>(topic, 10, subs_callback);
   rclcpp::executors::SingleThreadedExecutor executor;
   executor.add_node(test_subscription_node.get_node_base_interface());
 
@@ -100,7 +102,7 @@ void RangeSensorBroadcasterTest::subscribe_and_get_message(sensor_msgs::msg::Ran
   ASSERT_TRUE(received_msg);
 
   // take message from subscription
-  range_msg = *received_msg;
+  msg = *received_msg;
 }
 
 TEST_F(RangeSensorBroadcasterTest, Initialize_RangeBroadcaster_Exception)
@@ -292,6 +294,145 @@ TEST_F(RangeSensorBroadcasterTest, Publish_OutOfBandaries_RangeBroadcaster_Succe
 #endif
 }
 
+TEST_F(RangeSensorBroadcasterTest, Configure_PublishRate_Without_UpdateRate_Error)
+{
+  // the decimation can not be derived without the update rate of the controller
+  init_broadcaster("test_range_sensor_broadcaster_decimated");
+  ASSERT_EQ(
+    range_broadcaster_->on_configure(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::ERROR);
+}
+
+TEST_F(RangeSensorBroadcasterTest, Publish_Decimated_Minimum_RangeBroadcaster_Success)
+{
+  // 100 Hz update rate, published at 25 Hz with the minimum of the last 4 readings
+  init_broadcaster("test_range_sensor_broadcaster_decimated", 100);
+  ASSERT_EQ(
+    range_broadcaster_->on_configure(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+  ASSERT_EQ(
+    range_broadcaster_->on_activate(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+
+  sensor_msgs::msg::Range::SharedPtr received_msg;
+  rclcpp::Node test_subscription_node("test_subscription_node");
+  auto subscription = test_subscription_node.create_subscription<sensor_msgs::msg::Range>(
+    "/test_range_sensor_broadcaster_decimated/range", 10,
+    [&](const sensor_msgs::msg::Range::SharedPtr msg) { received_msg = msg; });
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(test_subscription_node.get_node_base_interface());
+  // only every 4th update publishes, make sure the first message is not missed
+  const auto discovery_timeout = test_subscription_node.get_clock()->now() + rclcpp::Duration(1, 0);
+  while (subscription->get_publisher_count() == 0 &&
+         test_subscription_node.get_clock()->now() < discovery_timeout)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(subscription->get_publisher_count(), 1u);
+
+  for (const double range : {3.0, 1.0, 2.0, 4.0})
+  {
+    EXPECT_FALSE(received_msg);
+    sensor_range_ = range;
+    ASSERT_EQ(
+      range_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)),
+      controller_interface::return_type::OK);
+    executor.spin_some();
+  }
+
+  const auto until = test_subscription_node.get_clock()->now() + rclcpp::Duration(1, 0);
+  while (!received_msg && test_subscription_node.get_clock()->now() < until)
+  {
+    executor.spin_some();
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+  }
+  ASSERT_TRUE(received_msg);
+  EXPECT_EQ(received_msg->header.frame_id, frame_id_);
+  EXPECT_THAT(received_msg->range, ::testing::FloatEq(1.0f));
+}
+
+TEST_F(RangeSensorBroadcasterTest, Configure_MultiSensor_RangeBroadcaster_Error)
+{
+  init_broadcaster("test_range_sensor_broadcaster");
+
+  // 'sensor_name' is set by the parameter file as well
+  std::vector<rclcpp::Parameter> parameters;
+  parameters.emplace_back(
+    rclcpp::Parameter("sensor_names", std::vector<std::string>{sensor_name_, second_sensor_name_}));
+  parameters.emplace_back(
+    rclcpp::Parameter("frame_ids", std::vector<std::string>{frame_id_, "second_frame"}));
+  ASSERT_EQ(configure_broadcaster(parameters), controller_interface::CallbackReturn::ERROR);
+
+  // a frame_id is missing
+  parameters.clear();
+  parameters.emplace_back(rclcpp::Parameter("sensor_name", ""));
+  parameters.emplace_back(rclcpp::Parameter("frame_ids", std::vector<std::string>{frame_id_}));
+  ASSERT_EQ(configure_broadcaster(parameters), controller_interface::CallbackReturn::ERROR);
+}
+
+TEST_F(RangeSensorBroadcasterTest, Publish_MultiSensor_RangeBroadcaster_Success)
+{
+  init_broadcaster("test_range_sensor_broadcaster");
+
+  std::vector<rclcpp::Parameter> parameters;
+  parameters.emplace_back(rclcpp::Parameter("sensor_name", ""));
+  parameters.emplace_back(
+    rclcpp::Parameter("sensor_names", std::vector<std::string>{sensor_name_, second_sensor_name_}));
+  parameters.emplace_back(
+    rclcpp::Parameter("frame_ids", std::vector<std::string>{frame_id_, "second_frame"}));
+  ASSERT_EQ(configure_broadcaster(parameters), controller_interface::CallbackReturn::SUCCESS);
+  ASSERT_THAT(range_broadcaster_->state_interface_configuration().names, SizeIs(2lu));
+
+  std::vector<hardware_interface::LoanedStateInterface> state_interfaces;
+  state_interfaces.emplace_back(range_);
+  state_interfaces.emplace_back(second_range_);
+  range_broadcaster_->assign_interfaces({}, std::move(state_interfaces));
+  ASSERT_EQ(
+    range_broadcaster_->on_activate(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+
+  sensor_msgs::msg::Range range_msg;
+  subscribe_and_get_message(range_msg, "/test_range_sensor_broadcaster/range_sensor/range");
+  EXPECT_EQ(range_msg.header.frame_id, frame_id_);
+  EXPECT_THAT(range_msg.range, ::testing::FloatEq(static_cast<float>(sensor_range_)));
+  EXPECT_EQ(range_msg.radiation_type, radiation_type_);
+
+  subscribe_and_get_message(range_msg, "/test_range_sensor_broadcaster/range_sensor_2/range");
+  EXPECT_EQ(range_msg.header.frame_id, "second_frame");
+  EXPECT_THAT(range_msg.range, ::testing::FloatEq(static_cast<float>(second_sensor_range_)));
+  EXPECT_EQ(range_msg.radiation_type, radiation_type_);
+}
+
+TEST_F(RangeSensorBroadcasterTest, Publish_Packed_RangeBroadcaster_Success)
+{
+  init_broadcaster("test_range_sensor_broadcaster_packed");
+  ASSERT_EQ(
+    range_broadcaster_->on_configure(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+
+  std::vector<hardware_interface::LoanedStateInterface> state_interfaces;
+  state_interfaces.emplace_back(range_);
+  state_interfaces.emplace_back(second_range_);
+  range_broadcaster_->assign_interfaces({}, std::move(state_interfaces));
+  ASSERT_EQ(
+    range_broadcaster_->on_activate(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+
+  std_msgs::msg::Float64MultiArray ranges_msg;
+  subscribe_and_get_message(ranges_msg, "/test_range_sensor_broadcaster_packed/ranges");
+  ASSERT_THAT(ranges_msg.layout.dim, SizeIs(1lu));
+  EXPECT_EQ(ranges_msg.layout.dim[0].size, 4u);
+  ASSERT_THAT(ranges_msg.data, SizeIs(4lu));
+  // stamped with rclcpp::Time(0)
+  EXPECT_EQ(ranges_msg.data[0], 0.0);
+  EXPECT_EQ(ranges_msg.data[1], 0.0);
+  EXPECT_THAT(
+    static_cast<float>(ranges_msg.data[2]), ::testing::FloatEq(static_cast<float>(sensor_range_)));
+  EXPECT_THAT(
+    static_cast<float>(ranges_msg.data[3]),
+    ::testing::FloatEq(static_cast<float>(second_sensor_range_)));
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleMock(&argc, argv);
@@ -48,13 +48,20 @@ protected:
 
   double sensor_range_ = 3.1;
   hardware_interface::StateInterface range_{sensor_name_, "range", &sensor_range_};
+  const std::string second_sensor_name_ = "range_sensor_2";
+  double second_sensor_range_ = 0.7;
+  hardware_interface::StateInterface second_range_{
+    second_sensor_name_, "range", &second_sensor_range_};
 
   std::unique_ptr<range_sensor_broadcaster::RangeSensorBroadcaster> range_broadcaster_;
 
-  controller_interface::return_type init_broadcaster(std::string broadcaster_name);
+  controller_interface::return_type init_broadcaster(
+    std::string broadcaster_name, unsigned int update_rate = 0);
   controller_interface::CallbackReturn configure_broadcaster(
     std::vector<rclcpp::Parameter> & parameters);
-  void subscribe_and_get_message(sensor_msgs::msg::Range & range_msg);
+  template <typename MessageT = sensor_msgs::msg::Range>
+  void subscribe_and_get_message(
+    MessageT & msg, const std::string & topic = "/test_range_sensor_broadcaster/range");
 };
 
 #endif  // TEST_RANGE_SENSOR_BROADCASTER_HPP_
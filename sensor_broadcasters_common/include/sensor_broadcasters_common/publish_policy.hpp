@@ -0,0 +1,138 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SENSOR_BROADCASTERS_COMMON__PUBLISH_POLICY_HPP_
+#define SENSOR_BROADCASTERS_COMMON__PUBLISH_POLICY_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sensor_broadcasters_common
+{
+/// How the samples of one publish period are reduced to the published value.
+enum class Reduction : uint8_t
+{
+  LAST,     ///< plain decimation, the latest sample
+  AVERAGE,  ///< boxcar average over the samples of the period
+  CIC,      ///< cascaded integrator-comb (sinc^N) filter, N boxcars over the period
+  MIN,      ///< smallest sample of the period
+  MAX,      ///< largest sample of the period
+};
+
+/**
+ * \brief Decides on which update cycles a broadcaster publishes and what it publishes.
+ *
+ * The broadcaster feeds one sample of `channels` values per update cycle. Every `decimation`
+ * samples, the samples of the period are reduced to a single output sample, which is then due
+ * for publishing. Averaging over the skipped samples instead of picking one of them suppresses
+ * the aliasing of sensor noise above the publish rate.
+ *
+ * All memory is allocated in configure(), reset() and add_sample() are safe to use from the RT
+ * loop.
+ */
+class PublishPolicy
+{
+public:
+  /**
+   * \brief Parse the reduction from its parameter value
+   * \param [in] name One of "last", "average", "cic", "min", "max"
+   * \throws std::invalid_argument for unknown names
+   */
+  static Reduction reduction_from_string(const std::string & name);
+
+  /**
+   * \brief Number of update cycles per published sample
+   * \param [in] update_rate Update rate of the controller [Hz]
+   * \param [in] publish_rate Desired publish rate [Hz], 0.0 publishes on every update
+   * \throws std::invalid_argument if a publish rate is requested but the update rate is unknown
+   */
+  static size_t decimation_from_rates(double update_rate, double publish_rate);
+
+  /**
+   * \brief Allocate the buffers and reset the policy
+   * \param [in] channels Number of values per sample
+   * \param [in] decimation Number of samples per published sample, must be > 0
+   * \param [in] reduction How the samples of one period are reduced
+   * \param [in] cic_order Number of cascaded boxcars of the CIC filter, must be > 0
+   * \throws std::invalid_argument for invalid arguments
+   */
+  void configure(
+    size_t channels, size_t decimation, Reduction reduction = Reduction::LAST,
+    size_t cic_order = 2);
+
+  /**
+   * \brief Configure from the ``publish_policy`` parameters of a broadcaster
+   * \param [in] channels Number of values per sample
+   * \param [in] update_rate Update rate of the controller [Hz]
+   * \param [in] params The ``publish_policy`` struct generated by generate_parameter_library
+   * \throws std::invalid_argument for invalid parameters
+   */
+  template <typename PublishPolicyParams>
+  void configure_from_params(
+    size_t channels, double update_rate, const PublishPolicyParams & params)
+  {
+    configure(
+      channels, decimation_from_rates(update_rate, params.rate),
+      reduction_from_string(params.reduction), static_cast<size_t>(params.cic_order));
+  }
+
+  /// Drop the samples of the current period, e.g. on activation.
+  void reset();
+
+  /**
+   * \brief Add the sample of this update cycle
+   * \param [in] sample Pointer to `channels()` values
+   * \return true if output() holds a new sample that is due for publishing
+   */
+  bool add_sample(const double * sample);
+
+  template <size_t N>
+  bool add_sample(const std::array<double, N> & sample)
+  {
+    return add_sample(sample.data());
+  }
+
+  /// The reduced sample of the last completed period.
+  const std::vector<double> & output() const { return output_; }
+
+  size_t channels() const { return channels_; }
+  size_t decimation() const { return decimation_; }
+  Reduction reduction() const { return reduction_; }
+
+private:
+  size_t channels_ = 0;
+  size_t decimation_ = 1;
+  Reduction reduction_ = Reduction::LAST;
+
+  // Samples added in the current period
+  size_t sample_count_ = 0;
+  // Running sum, minimum or maximum of the current period
+  std::vector<double> accumulator_;
+
+  // Impulse response of the CIC filter, newest sample first, and the matching sample history
+  // stored interleaved as history_[slot * channels_ + channel]
+  std::vector<double> cic_weights_;
+  std::vector<double> history_;
+  size_t history_index_ = 0;
+  bool history_empty_ = true;
+
+  std::vector<double> output_;
+};
+
+}  // namespace sensor_broadcasters_common
+
+#endif  // SENSOR_BROADCASTERS_COMMON__PUBLISH_POLICY_HPP_
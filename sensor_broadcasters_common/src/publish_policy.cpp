@@ -0,0 +1,213 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sensor_broadcasters_common/publish_policy.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace sensor_broadcasters_common
+{
+Reduction PublishPolicy::reduction_from_string(const std::string & name)
+{
+  if (name == "last")
+  {
+    return Reduction::LAST;
+  }
+  if (name == "average")
+  {
+    return Reduction::AVERAGE;
+  }
+  if (name == "cic")
+  {
+    return Reduction::CIC;
+  }
+  if (name == "min")
+  {
+    return Reduction::MIN;
+  }
+  if (name == "max")
+  {
+    return Reduction::MAX;
+  }
+  throw std::invalid_argument("Unknown publish reduction '" + name + "'.");
+}
+
+size_t PublishPolicy::decimation_from_rates(double update_rate, double publish_rate)
+{
+  if (!(publish_rate > 0.0))
+  {
+    return 1;
+  }
+  if (!(update_rate > 0.0))
+  {
+    throw std::invalid_argument("A publish rate requires a known update rate of the controller.");
+  }
+  return std::max<size_t>(static_cast<size_t>(std::lround(update_rate / publish_rate)), 1);
+}
+
+void PublishPolicy::configure(
+  size_t channels, size_t decimation, Reduction reduction, size_t cic_order)
+{
+  if (decimation == 0)
+  {
+    throw std::invalid_argument("Decimation of the publish policy must be positive.");
+  }
+  if (reduction == Reduction::CIC && cic_order == 0)
+  {
+    throw std::invalid_argument("Order of the CIC filter must be positive.");
+  }
+  channels_ = channels;
+  decimation_ = decimation;
+  reduction_ = reduction;
+
+  accumulator_.assign(channels_, 0.0);
+  output_.assign(channels_, 0.0);
+
+  cic_weights_.clear();
+  history_.clear();
+  if (reduction_ == Reduction::CIC)
+  {
+    // Convolve cic_order boxcars of length decimation, normalized to unit DC gain
+    cic_weights_.assign(1, 1.0);
+    for (size_t stage = 0; stage < cic_order; ++stage)
+    {
+      std::vector<double> convolved(cic_weights_.size() + decimation_ - 1, 0.0);
+      for (size_t i = 0; i < cic_weights_.size(); ++i)
+      {
+        for (size_t j = 0; j < decimation_; ++j)
+        {
+          convolved[i + j] += cic_weights_[i] / static_cast<double>(decimation_);
+        }
+      }
+      cic_weights_ = std::move(convolved);
+    }
+    history_.assign(cic_weights_.size() * channels_, 0.0);
+  }
+  reset();
+}
+
+void PublishPolicy::reset()
+{
+  sample_count_ = 0;
+  std::fill(accumulator_.begin(), accumulator_.end(), 0.0);
+  history_index_ = 0;
+  history_empty_ = true;
+}
+
+bool PublishPolicy::add_sample(const double * sample)
+{
+  switch (reduction_)
+  {
+    case Reduction::LAST:
+      break;
+    case Reduction::AVERAGE:
+      for (size_t c = 0; c < channels_; ++c)
+      {
+        accumulator_[c] += sample[c];
+      }
+      break;
+    case Reduction::MIN:
+      if (sample_count_ == 0)
+      {
+        std::copy(sample, sample + channels_, accumulator_.begin());
+        break;
+      }
+      for (size_t c = 0; c < channels_; ++c)
+      {
+        // like std::fmin, NaN samples are ignored
+        if (sample[c] < accumulator_[c] || std::isnan(accumulator_[c]))
+        {
+          accumulator_[c] = sample[c];
+        }
+      }
+      break;
+    case Reduction::MAX:
+      if (sample_count_ == 0)
+      {
+        std::copy(sample, sample + channels_, accumulator_.begin());
+        break;
+      }
+      for (size_t c = 0; c < channels_; ++c)
+      {
+        if (sample[c] > accumulator_[c] || std::isnan(accumulator_[c]))
+        {
+          accumulator_[c] = sample[c];
+        }
+      }
+      break;
+    case Reduction::CIC:
+    {
+      const size_t slots = cic_weights_.size();
+      if (history_empty_)
+      {
+        // start from steady state instead of ramping up from zero
+        for (size_t slot = 0; slot < slots; ++slot)
+        {
+          std::copy(sample, sample + channels_, history_.begin() + slot * channels_);
+        }
+        history_empty_ = false;
+      }
+      history_index_ = (history_index_ + 1) % slots;
+      std::copy(sample, sample + channels_, history_.begin() + history_index_ * channels_);
+      break;
+    }
+  }
+
+  if (++sample_count_ < decimation_)
+  {
+    return false;
+  }
+  sample_count_ = 0;
+
+  switch (reduction_)
+  {
+    case Reduction::LAST:
+      std::copy(sample, sample + channels_, output_.begin());
+      break;
+    case Reduction::AVERAGE:
+      for (size_t c = 0; c < channels_; ++c)
+      {
+        output_[c] = accumulator_[c] / static_cast<double>(decimation_);
+        accumulator_[c] = 0.0;
+      }
+      break;
+    case Reduction::MIN:
+    case Reduction::MAX:
+      std::copy(accumulator_.begin(), accumulator_.end(), output_.begin());
+      break;
+    case Reduction::CIC:
+    {
+      // the filter only has to be evaluated at the output rate
+      const size_t slots = cic_weights_.size();
+      std::fill(output_.begin(), output_.end(), 0.0);
+      size_t slot = history_index_;
+      for (size_t k = 0; k < slots; ++k)
+      {
+        const double * history_sample = history_.data() + slot * channels_;
+        for (size_t c = 0; c < channels_; ++c)
+        {
+          output_[c] += cic_weights_[k] * history_sample[c];
+        }
+        slot = slot == 0 ? slots - 1 : slot - 1;
+      }
+      break;
+    }
+  }
+  return true;
+}
+
+}  // namespace sensor_broadcasters_common
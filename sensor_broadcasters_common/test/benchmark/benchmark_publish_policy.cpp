@@ -0,0 +1,72 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "sensor_broadcasters_common/publish_policy.hpp"
+
+namespace
+{
+using sensor_broadcasters_common::PublishPolicy;
+using sensor_broadcasters_common::Reduction;
+
+// Adds one 10-channel sample (the size of an IMU sample) per iteration
+void BM_PublishPolicyAddSample(benchmark::State & state)
+{
+  const auto reduction = static_cast<Reduction>(state.range(0));
+  const auto decimation = static_cast<size_t>(state.range(1));
+  PublishPolicy policy;
+  policy.configure(10, decimation, reduction, 3);
+
+  // precomputed so that only the policy is measured
+  std::vector<std::array<double, 10>> samples(1024);
+  for (size_t i = 0; i < samples.size(); ++i)
+  {
+    for (size_t c = 0; c < samples[i].size(); ++c)
+    {
+      samples[i][c] = std::sin(0.001 * static_cast<double>(i) + static_cast<double>(c));
+    }
+  }
+
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(policy.add_sample(samples[i]));
+    i = (i + 1) % samples.size();
+    benchmark::DoNotOptimize(policy.output().data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void ReductionArgs(benchmark::internal::Benchmark * benchmark)
+{
+  for (const auto reduction :
+       {Reduction::LAST, Reduction::AVERAGE, Reduction::CIC, Reduction::MIN, Reduction::MAX})
+  {
+    // every cycle, 1 kHz -> 100 Hz and 1 kHz -> 10 Hz
+    for (const int64_t decimation : {1, 10, 100})
+    {
+      benchmark->Args({static_cast<int64_t>(reduction), decimation});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_PublishPolicyAddSample)->Apply(ReductionArgs);
@@ -0,0 +1,200 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include "sensor_broadcasters_common/publish_policy.hpp"
+
+using sensor_broadcasters_common::PublishPolicy;
+using sensor_broadcasters_common::Reduction;
+
+TEST(PublishPolicyTest, testWrongParams)
+{
+  PublishPolicy policy;
+  EXPECT_THROW(policy.configure(3, 0), std::invalid_argument);
+  EXPECT_THROW(policy.configure(3, 10, Reduction::CIC, 0), std::invalid_argument);
+  EXPECT_THROW(PublishPolicy::reduction_from_string("median"), std::invalid_argument);
+  EXPECT_THROW(PublishPolicy::decimation_from_rates(0.0, 100.0), std::invalid_argument);
+  EXPECT_NO_THROW(policy.configure(3, 10, Reduction::CIC, 3));
+}
+
+TEST(PublishPolicyTest, testDecimationFromRates)
+{
+  EXPECT_EQ(PublishPolicy::decimation_from_rates(1000.0, 0.0), 1u);
+  EXPECT_EQ(PublishPolicy::decimation_from_rates(0.0, 0.0), 1u);
+  EXPECT_EQ(PublishPolicy::decimation_from_rates(1000.0, 100.0), 10u);
+  EXPECT_EQ(PublishPolicy::decimation_from_rates(1000.0, 300.0), 3u);
+  EXPECT_EQ(PublishPolicy::decimation_from_rates(100.0, 1000.0), 1u);
+}
+
+TEST(PublishPolicyTest, testReductionFromString)
+{
+  EXPECT_EQ(PublishPolicy::reduction_from_string("last"), Reduction::LAST);
+  EXPECT_EQ(PublishPolicy::reduction_from_string("average"), Reduction::AVERAGE);
+  EXPECT_EQ(PublishPolicy::reduction_from_string("cic"), Reduction::CIC);
+  EXPECT_EQ(PublishPolicy::reduction_from_string("min"), Reduction::MIN);
+  EXPECT_EQ(PublishPolicy::reduction_from_string("max"), Reduction::MAX);
+}
+
+TEST(PublishPolicyTest, testEveryCycle)
+{
+  PublishPolicy policy;
+  policy.configure(2, 1);
+  for (double i = 0.0; i < 5.0; ++i)
+  {
+    ASSERT_TRUE(policy.add_sample(std::array<double, 2>{{i, -i}}));
+    EXPECT_EQ(policy.output()[0], i);
+    EXPECT_EQ(policy.output()[1], -i);
+  }
+}
+
+TEST(PublishPolicyTest, testReductions)
+{
+  // one period of samples 1, 5, 3, 2
+  const std::array<double, 4> samples = {{1.0, 5.0, 3.0, 2.0}};
+  const std::array<std::pair<Reduction, double>, 4> expected = {
+    {{Reduction::LAST, 2.0},
+     {Reduction::AVERAGE, 2.75},
+     {Reduction::MIN, 1.0},
+     {Reduction::MAX, 5.0}}};
+
+  for (const auto & [reduction, value] : expected)
+  {
+    PublishPolicy policy;
+    policy.configure(1, samples.size(), reduction);
+    // two periods to make sure the accumulator is restarted
+    for (int period = 0; period < 2; ++period)
+    {
+      for (size_t i = 0; i < samples.size(); ++i)
+      {
+        const bool due = policy.add_sample(&samples[i]);
+        EXPECT_EQ(due, i + 1 == samples.size());
+      }
+      EXPECT_DOUBLE_EQ(policy.output()[0], value);
+    }
+  }
+}
+
+TEST(PublishPolicyTest, testMinMaxIgnoreNaN)
+{
+  const std::array<double, 3> samples = {{NAN, 2.0, 1.0}};
+  PublishPolicy policy;
+  policy.configure(1, samples.size(), Reduction::MIN);
+  for (const auto & sample : samples)
+  {
+    policy.add_sample(&sample);
+  }
+  EXPECT_EQ(policy.output()[0], 1.0);
+}
+
+TEST(PublishPolicyTest, testCic)
+{
+  // an order 2 CIC with decimation 3 is the triangular filter [1 2 3 2 1] / 9
+  PublishPolicy policy;
+  policy.configure(1, 3, Reduction::CIC, 2);
+
+  // constant input is passed through from the first output on
+  double value = 4.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(policy.add_sample(&value), i == 2);
+  }
+  EXPECT_DOUBLE_EQ(policy.output()[0], 4.0);
+
+  // impulse response
+  value = 0.0;
+  policy.reset();
+  policy.add_sample(&value);
+  value = 9.0;
+  policy.add_sample(&value);
+  value = 0.0;
+  policy.add_sample(&value);
+  EXPECT_DOUBLE_EQ(policy.output()[0], 2.0);
+  for (int i = 0; i < 3; ++i)
+  {
+    policy.add_sample(&value);
+  }
+  EXPECT_DOUBLE_EQ(policy.output()[0], 1.0);
+  for (int i = 0; i < 3; ++i)
+  {
+    policy.add_sample(&value);
+  }
+  EXPECT_DOUBLE_EQ(policy.output()[0], 0.0);
+}
+
+TEST(PublishPolicyTest, testCicRejectsAliasing)
+{
+  // a tone at the publish rate aliases to DC with plain decimation, the CIC filter removes it
+  constexpr size_t decimation = 10;
+  PublishPolicy last;
+  last.configure(1, decimation, Reduction::LAST);
+  PublishPolicy cic;
+  cic.configure(1, decimation, Reduction::CIC, 3);
+
+  for (size_t i = 0; i < 20 * decimation; ++i)
+  {
+    const double sample = 1.0 + std::sin(2.0 * M_PI * static_cast<double>(i + 1) / decimation);
+    if (last.add_sample(&sample))
+    {
+      ASSERT_TRUE(cic.add_sample(&sample));
+      EXPECT_NEAR(last.output()[0], 1.0, 1e-9);
+      if (i > 3 * decimation)
+      {
+        EXPECT_NEAR(cic.output()[0], 1.0, 1e-9);
+      }
+    }
+    else
+    {
+      ASSERT_FALSE(cic.add_sample(&sample));
+    }
+  }
+
+  // a tone slightly off the publish rate is passed through plain decimation as a slow oscillation
+  last.reset();
+  cic.reset();
+  double max_error_last = 0.0;
+  double max_error_cic = 0.0;
+  for (size_t i = 0; i < 200 * decimation; ++i)
+  {
+    const double sample = std::sin(2.0 * M_PI * 0.11 * static_cast<double>(i));
+    last.add_sample(&sample);
+    if (cic.add_sample(&sample) && i > 3 * decimation)
+    {
+      max_error_last = std::max(max_error_last, std::fabs(last.output()[0]));
+      max_error_cic = std::max(max_error_cic, std::fabs(cic.output()[0]));
+    }
+  }
+  EXPECT_GT(max_error_last, 0.9);
+  EXPECT_LT(max_error_cic, 0.01);
+}
+
+TEST(PublishPolicyTest, testReset)
+{
+  PublishPolicy policy;
+  policy.configure(1, 3, Reduction::AVERAGE);
+  double value = 100.0;
+  policy.add_sample(&value);
+  policy.add_sample(&value);
+
+  policy.reset();
+  value = 1.0;
+  EXPECT_FALSE(policy.add_sample(&value));
+  EXPECT_FALSE(policy.add_sample(&value));
+  EXPECT_TRUE(policy.add_sample(&value));
+  EXPECT_DOUBLE_EQ(policy.output()[0], 1.0);
+}
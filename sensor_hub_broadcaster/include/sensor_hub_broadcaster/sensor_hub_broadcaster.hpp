@@ -0,0 +1,128 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SENSOR_HUB_BROADCASTER__SENSOR_HUB_BROADCASTER_HPP_
+#define SENSOR_HUB_BROADCASTER__SENSOR_HUB_BROADCASTER_HPP_
+
+#include <array>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "controller_interface/controller_interface.hpp"
+#include "geometry_msgs/msg/pose.hpp"
+#include "geometry_msgs/msg/pose_stamped.hpp"
+#include "geometry_msgs/msg/wrench.hpp"
+#include "geometry_msgs/msg/wrench_stamped.hpp"
+#include "rclcpp_lifecycle/state.hpp"
+#include "realtime_tools/realtime_publisher.hpp"
+#include "semantic_components/force_torque_sensor.hpp"
+#include "semantic_components/gps_sensor.hpp"
+#include "semantic_components/imu_sensor.hpp"
+#include "semantic_components/pose_sensor.hpp"
+#include "semantic_components/range_sensor.hpp"
+#include "sensor_broadcasters_common/publish_policy.hpp"
+#include "sensor_msgs/msg/imu.hpp"
+#include "sensor_msgs/msg/nav_sat_fix.hpp"
+#include "sensor_msgs/msg/range.hpp"
+
+#include "sensor_hub_broadcaster/sensor_hub_broadcaster_parameters.hpp"
+
+namespace sensor_hub_broadcaster
+{
+/**
+ * \brief A semantic component hosted by the hub with its own publisher and publish policy.
+ *
+ * \tparam SensorT Semantic component reading the state interfaces
+ * \tparam StateT Message filled by the semantic component
+ * \tparam MessageT Published message
+ * \tparam N Number of values per sample of the publish policy
+ */
+template <typename SensorT, typename StateT, typename MessageT, size_t N>
+struct HostedSensor
+{
+  using Message = MessageT;
+
+  explicit HostedSensor(const std::string & name) : sensor(name) {}
+
+  SensorT sensor;
+  // Latest reading, as message and as sample of the publish policy
+  StateT state;
+  std::array<double, N> sample = {};
+  sensor_broadcasters_common::PublishPolicy publish_policy;
+
+  typename rclcpp::Publisher<MessageT>::SharedPtr publisher;
+  std::unique_ptr<realtime_tools::RealtimePublisher<MessageT>> realtime_publisher;
+};
+
+// orientation, angular velocity, linear acceleration
+using HostedImu = HostedSensor<
+  semantic_components::IMUSensor, sensor_msgs::msg::Imu, sensor_msgs::msg::Imu, 10>;
+// force, torque
+using HostedForceTorque = HostedSensor<
+  semantic_components::ForceTorqueSensor, geometry_msgs::msg::Wrench,
+  geometry_msgs::msg::WrenchStamped, 6>;
+// range
+using HostedRange = HostedSensor<
+  semantic_components::RangeSensor, sensor_msgs::msg::Range, sensor_msgs::msg::Range, 1>;
+// latitude, longitude, altitude
+using HostedGps = HostedSensor<
+  semantic_components::GPSSensor<semantic_components::GPSSensorOption::WithoutCovariance>,
+  sensor_msgs::msg::NavSatFix, sensor_msgs::msg::NavSatFix, 3>;
+// position, orientation
+using HostedPose = HostedSensor<
+  semantic_components::PoseSensor, geometry_msgs::msg::Pose, geometry_msgs::msg::PoseStamped, 7>;
+
+using HostedSensorVariant =
+  std::variant<HostedImu, HostedForceTorque, HostedRange, HostedGps, HostedPose>;
+
+/**
+ * \brief Broadcaster hosting several sensors of different types in one controller.
+ *
+ * Compared to one broadcaster per sensor, all sensors share one node and are read and published
+ * in a single update pass, while each sensor keeps its own topic and publish policy.
+ */
+class SensorHubBroadcaster : public controller_interface::ControllerInterface
+{
+public:
+  controller_interface::InterfaceConfiguration command_interface_configuration() const override;
+
+  controller_interface::InterfaceConfiguration state_interface_configuration() const override;
+
+  controller_interface::CallbackReturn on_init() override;
+
+  controller_interface::CallbackReturn on_configure(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+  controller_interface::CallbackReturn on_activate(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+  controller_interface::CallbackReturn on_deactivate(
+    const rclcpp_lifecycle::State & previous_state) override;
+
+  controller_interface::return_type update(
+    const rclcpp::Time & time, const rclcpp::Duration & period) override;
+
+protected:
+  std::shared_ptr<ParamListener> param_listener_;
+  Params params_;
+
+  // The sensors in the order of the ``sensors`` parameter
+  std::vector<HostedSensorVariant> hosted_sensors_;
+};
+
+}  // namespace sensor_hub_broadcaster
+
+#endif  // SENSOR_HUB_BROADCASTER__SENSOR_HUB_BROADCASTER_HPP_
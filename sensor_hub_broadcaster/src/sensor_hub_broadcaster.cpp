@@ -0,0 +1,355 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sensor_hub_broadcaster/sensor_hub_broadcaster.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using sensor_broadcasters_common::PublishPolicy;
+using sensor_broadcasters_common::Reduction;
+using sensor_hub_broadcaster::HostedForceTorque;
+using sensor_hub_broadcaster::HostedGps;
+using sensor_hub_broadcaster::HostedImu;
+using sensor_hub_broadcaster::HostedPose;
+using sensor_hub_broadcaster::HostedRange;
+using SensorParams =
+  decltype(std::declval<sensor_hub_broadcaster::Params>().sensor_params.sensors_map)::mapped_type;
+
+// Topic of each sensor type, relative to ``~/<sensor>/``
+const char * topic_name(const HostedImu &) { return "imu"; }
+const char * topic_name(const HostedForceTorque &) { return "wrench"; }
+const char * topic_name(const HostedRange &) { return "range"; }
+const char * topic_name(const HostedGps &) { return "gps/fix"; }
+const char * topic_name(const HostedPose &) { return "pose"; }
+
+// Constant fields of the published messages besides the frame_id
+template <typename HostedT>
+void configure_message(HostedT &, const SensorParams &)
+{
+}
+
+void configure_message(HostedRange & hosted, const SensorParams & params)
+{
+  auto & msg = hosted.realtime_publisher->msg_;
+  msg.radiation_type = static_cast<uint8_t>(params.radiation_type);
+  msg.field_of_view = static_cast<float>(params.field_of_view);
+  msg.min_range = static_cast<float>(params.min_range);
+  msg.max_range = static_cast<float>(params.max_range);
+// \note The versions conditioning is added here to support the source-compatibility with Humble
+#if SENSOR_MSGS_VERSION_MAJOR >= 5
+  msg.variance = params.variance;
+#endif
+}
+
+// Latest reading as sample of the publish policy
+void read_sample(HostedImu & hosted)
+{
+  const auto & state = hosted.state;
+  hosted.sample = {
+    {state.orientation.x, state.orientation.y, state.orientation.z, state.orientation.w,
+     state.angular_velocity.x, state.angular_velocity.y, state.angular_velocity.z,
+     state.linear_acceleration.x, state.linear_acceleration.y, state.linear_acceleration.z}};
+}
+
+void read_sample(HostedForceTorque & hosted)
+{
+  const auto & state = hosted.state;
+  hosted.sample = {
+    {state.force.x, state.force.y, state.force.z, state.torque.x, state.torque.y,
+     state.torque.z}};
+}
+
+void read_sample(HostedRange & hosted)
+{
+  hosted.sample = {{static_cast<double>(hosted.state.range)}};
+}
+
+void read_sample(HostedGps & hosted)
+{
+  const auto & state = hosted.state;
+  hosted.sample = {{state.latitude, state.longitude, state.altitude}};
+}
+
+void read_sample(HostedPose & hosted)
+{
+  const auto & state = hosted.state;
+  hosted.sample = {
+    {state.position.x, state.position.y, state.position.z, state.orientation.x,
+     state.orientation.y, state.orientation.z, state.orientation.w}};
+}
+
+/// Filtered quaternions are normalized again, extrema of the quaternion components are no
+/// orientation and the latest one is used instead, like in the IMU sensor and pose broadcasters.
+void write_orientation(
+  const PublishPolicy & policy, const double * q, const geometry_msgs::msg::Quaternion & latest,
+  geometry_msgs::msg::Quaternion & orientation)
+{
+  const auto reduction = policy.reduction();
+  const double norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+  if ((reduction == Reduction::AVERAGE || reduction == Reduction::CIC) && norm > 0.0)
+  {
+    orientation.x = q[0] / norm;
+    orientation.y = q[1] / norm;
+    orientation.z = q[2] / norm;
+    orientation.w = q[3] / norm;
+  }
+  else
+  {
+    orientation = latest;
+  }
+}
+
+// Output of the publish policy as published message
+void write_message(HostedImu & hosted, sensor_msgs::msg::Imu & msg)
+{
+  const auto & sample = hosted.publish_policy.output();
+  write_orientation(
+    hosted.publish_policy, sample.data(), hosted.state.orientation, msg.orientation);
+  msg.angular_velocity.x = sample[4];
+  msg.angular_velocity.y = sample[5];
+  msg.angular_velocity.z = sample[6];
+  msg.linear_acceleration.x = sample[7];
+  msg.linear_acceleration.y = sample[8];
+  msg.linear_acceleration.z = sample[9];
+}
+
+void write_message(HostedForceTorque & hosted, geometry_msgs::msg::WrenchStamped & msg)
+{
+  const auto & sample = hosted.publish_policy.output();
+  msg.wrench.force.x = sample[0];
+  msg.wrench.force.y = sample[1];
+  msg.wrench.force.z = sample[2];
+  msg.wrench.torque.x = sample[3];
+  msg.wrench.torque.y = sample[4];
+  msg.wrench.torque.z = sample[5];
+}
+
+void write_message(HostedRange & hosted, sensor_msgs::msg::Range & msg)
+{
+  msg.range = static_cast<float>(hosted.publish_policy.output()[0]);
+}
+
+void write_message(HostedGps & hosted, sensor_msgs::msg::NavSatFix & msg)
+{
+  const auto & sample = hosted.publish_policy.output();
+  msg.status = hosted.state.status;
+  msg.latitude = sample[0];
+  msg.longitude = sample[1];
+  msg.altitude = sample[2];
+}
+
+void write_message(HostedPose & hosted, geometry_msgs::msg::PoseStamped & msg)
+{
+  const auto & sample = hosted.publish_policy.output();
+  msg.pose.position.x = sample[0];
+  msg.pose.position.y = sample[1];
+  msg.pose.position.z = sample[2];
+  write_orientation(
+    hosted.publish_policy, sample.data() + 3, hosted.state.orientation, msg.pose.orientation);
+}
+}  // namespace
+
+namespace sensor_hub_broadcaster
+{
+controller_interface::CallbackReturn SensorHubBroadcaster::on_init()
+{
+  try
+  {
+    param_listener_ = std::make_shared<ParamListener>(get_node());
+    params_ = param_listener_->get_params();
+  }
+  catch (const std::exception & e)
+  {
+    RCLCPP_ERROR(
+      get_node()->get_logger(), "Exception thrown during init stage with message: %s \n", e.what());
+    return CallbackReturn::ERROR;
+  }
+
+  return CallbackReturn::SUCCESS;
+}
+
+controller_interface::CallbackReturn SensorHubBroadcaster::on_configure(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  params_ = param_listener_->get_params();
+
+  hosted_sensors_.clear();
+  hosted_sensors_.reserve(params_.sensors.size());
+  for (const auto & sensor_name : params_.sensors)
+  {
+    const auto & sensor_params = params_.sensor_params.sensors_map.at(sensor_name);
+    if (sensor_params.frame_id.empty())
+    {
+      RCLCPP_ERROR(
+        get_node()->get_logger(), "'sensor_params.%s.frame_id' parameter has to be provided.",
+        sensor_name.c_str());
+      return CallbackReturn::ERROR;
+    }
+
+    if (sensor_params.type == "imu")
+    {
+      hosted_sensors_.emplace_back(std::in_place_type<HostedImu>, sensor_name);
+    }
+    else if (sensor_params.type == "force_torque")
+    {
+      hosted_sensors_.emplace_back(std::in_place_type<HostedForceTorque>, sensor_name);
+    }
+    else if (sensor_params.type == "range")
+    {
+      hosted_sensors_.emplace_back(std::in_place_type<HostedRange>, sensor_name);
+    }
+    else if (sensor_params.type == "gps")
+    {
+      hosted_sensors_.emplace_back(std::in_place_type<HostedGps>, sensor_name);
+    }
+    else
+    {
+      hosted_sensors_.emplace_back(std::in_place_type<HostedPose>, sensor_name);
+    }
+
+    try
+    {
+      std::visit(
+        [this, &sensor_name, &sensor_params](auto & hosted)
+        {
+          using MessageT = typename std::decay_t<decltype(hosted)>::Message;
+          hosted.publish_policy.configure_from_params(
+            hosted.sample.size(), static_cast<double>(get_update_rate()), sensor_params);
+          hosted.publisher = get_node()->create_publisher<MessageT>(
+            "~/" + sensor_name + "/" + topic_name(hosted), rclcpp::SystemDefaultsQoS());
+          hosted.realtime_publisher =
+            std::make_unique<realtime_tools::RealtimePublisher<MessageT>>(hosted.publisher);
+
+          hosted.realtime_publisher->lock();
+          hosted.realtime_publisher->msg_.header.frame_id = sensor_params.frame_id;
+          configure_message(hosted, sensor_params);
+          hosted.realtime_publisher->unlock();
+        },
+        hosted_sensors_.back());
+    }
+    catch (const std::invalid_argument & e)
+    {
+      RCLCPP_ERROR(
+        get_node()->get_logger(), "Invalid publish policy of sensor '%s': %s",
+        sensor_name.c_str(), e.what());
+      return CallbackReturn::ERROR;
+    }
+    catch (const std::exception & e)
+    {
+      fprintf(
+        stderr,
+        "Exception thrown during publisher creation at configure stage with message : %s \n",
+        e.what());
+      return CallbackReturn::ERROR;
+    }
+  }
+
+  RCLCPP_DEBUG(get_node()->get_logger(), "configure successful");
+  return CallbackReturn::SUCCESS;
+}
+
+controller_interface::InterfaceConfiguration
+SensorHubBroadcaster::command_interface_configuration() const
+{
+  controller_interface::InterfaceConfiguration command_interfaces_config;
+  command_interfaces_config.type = controller_interface::interface_configuration_type::NONE;
+  return command_interfaces_config;
+}
+
+controller_interface::InterfaceConfiguration SensorHubBroadcaster::state_interface_configuration()
+  const
+{
+  controller_interface::InterfaceConfiguration state_interfaces_config;
+  state_interfaces_config.type = controller_interface::interface_configuration_type::INDIVIDUAL;
+  for (const auto & hosted_sensor : hosted_sensors_)
+  {
+    std::visit(
+      [&state_interfaces_config](const auto & hosted)
+      {
+        const auto names = hosted.sensor.get_state_interface_names();
+        state_interfaces_config.names.insert(
+          state_interfaces_config.names.end(), names.begin(), names.end());
+      },
+      hosted_sensor);
+  }
+  return state_interfaces_config;
+}
+
+controller_interface::CallbackReturn SensorHubBroadcaster::on_activate(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  for (auto & hosted_sensor : hosted_sensors_)
+  {
+    std::visit(
+      [this](auto & hosted)
+      {
+        hosted.sensor.assign_loaned_state_interfaces(state_interfaces_);
+        hosted.publish_policy.reset();
+      },
+      hosted_sensor);
+  }
+  return CallbackReturn::SUCCESS;
+}
+
+controller_interface::CallbackReturn SensorHubBroadcaster::on_deactivate(
+  const rclcpp_lifecycle::State & /*previous_state*/)
+{
+  for (auto & hosted_sensor : hosted_sensors_)
+  {
+    std::visit([](auto & hosted) { hosted.sensor.release_interfaces(); }, hosted_sensor);
+  }
+  return CallbackReturn::SUCCESS;
+}
+
+controller_interface::return_type SensorHubBroadcaster::update(
+  const rclcpp::Time & time, const rclcpp::Duration & /*period*/)
+{
+  for (auto & hosted_sensor : hosted_sensors_)
+  {
+    std::visit(
+      [&time](auto & hosted)
+      {
+        hosted.sensor.get_values_as_message(hosted.state);
+        read_sample(hosted);
+        if (!hosted.publish_policy.add_sample(hosted.sample))
+        {
+          return;
+        }
+        if (hosted.realtime_publisher->trylock())
+        {
+          hosted.realtime_publisher->msg_.header.stamp = time;
+          write_message(hosted, hosted.realtime_publisher->msg_);
+          hosted.realtime_publisher->unlockAndPublish();
+        }
+      },
+      hosted_sensor);
+  }
+  return controller_interface::return_type::OK;
+}
+
+}  // namespace sensor_hub_broadcaster
+
+#include "pluginlib/class_list_macros.hpp"
+
+PLUGINLIB_EXPORT_CLASS(
+  sensor_hub_broadcaster::SensorHubBroadcaster, controller_interface::ControllerInterface)
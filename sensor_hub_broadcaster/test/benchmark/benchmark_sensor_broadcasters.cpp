@@ -0,0 +1,341 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "force_torque_sensor_broadcaster/force_torque_sensor_broadcaster.hpp"
+#include "gps_sensor_broadcaster/gps_sensor_broadcaster.hpp"
+#include "hardware_interface/handle.hpp"
+#include "hardware_interface/loaned_state_interface.hpp"
+#include "imu_sensor_broadcaster/imu_sensor_broadcaster.hpp"
+#include "pose_broadcaster/pose_broadcaster.hpp"
+#include "range_sensor_broadcaster/range_sensor_broadcaster.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "sensor_hub_broadcaster/sensor_hub_broadcaster.hpp"
+
+namespace
+{
+// Heap allocations of the benchmark thread while counting is enabled, the publisher threads of
+// the realtime publishers are not counted
+std::atomic<int64_t> allocations{0};
+thread_local bool count_allocations = false;
+}  // namespace
+
+void * operator new(std::size_t size)
+{
+  if (count_allocations)
+  {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (void * ptr = std::malloc(size == 0 ? 1 : size))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept { std::free(ptr); }
+
+void operator delete(void * ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+constexpr unsigned int UPDATE_RATE = 1000;
+// publish_policy.rate of the decimated configurations
+constexpr double DECIMATED_PUBLISH_RATE = 100.0;
+
+// Expose the realtime publisher whose trylock is measured
+class BenchmarkIMUSensorBroadcaster : public imu_sensor_broadcaster::IMUSensorBroadcaster
+{
+public:
+  auto & realtime_publisher() { return *realtime_publisher_; }
+};
+
+class BenchmarkForceTorqueSensorBroadcaster
+: public force_torque_sensor_broadcaster::ForceTorqueSensorBroadcaster
+{
+public:
+  auto & realtime_publisher() { return *realtime_publisher_; }
+};
+
+class BenchmarkRangeSensorBroadcaster : public range_sensor_broadcaster::RangeSensorBroadcaster
+{
+public:
+  auto & realtime_publisher() { return *realtime_publishers_.front(); }
+};
+
+class BenchmarkGPSSensorBroadcaster : public gps_sensor_broadcaster::GPSSensorBroadcaster
+{
+public:
+  auto & realtime_publisher() { return *realtime_publisher_; }
+};
+
+class BenchmarkPoseBroadcaster : public pose_broadcaster::PoseBroadcaster
+{
+public:
+  auto & realtime_publisher() { return *realtime_publisher_; }
+};
+
+class BenchmarkSensorHubBroadcaster : public sensor_hub_broadcaster::SensorHubBroadcaster
+{
+public:
+  // the IMU, which is the first hosted sensor
+  auto & realtime_publisher()
+  {
+    using sensor_hub_broadcaster::HostedImu;
+    return *std::get<HostedImu>(hosted_sensors_.front()).realtime_publisher;
+  }
+};
+
+/// Plausible reading for a state interface, orientations are the identity.
+double state_value(const std::string & name, size_t index)
+{
+  const auto interface_name = name.substr(name.find_last_of('/') + 1);
+  if (interface_name == "orientation.w")
+  {
+    return 1.0;
+  }
+  if (interface_name.rfind("orientation.", 0) == 0 || interface_name == "status")
+  {
+    return 0.0;
+  }
+  return 0.5 + 0.01 * static_cast<double>(index);
+}
+
+/**
+ * \brief Update an active broadcaster, reading mock state interfaces.
+ *
+ * state.range(0): 1 for a thread contending for the lock of the realtime publisher
+ * state.range(1): 1 to publish at DECIMATED_PUBLISH_RATE instead of on every update
+ *
+ * Reports the time per update cycle, the rate of failed trylock calls of the cycles that had to
+ * publish, and the heap allocations per cycle.
+ */
+template <typename BroadcasterT>
+void run_update_benchmark(
+  benchmark::State & state, const std::string & name, std::vector<rclcpp::Parameter> parameters,
+  const std::vector<std::string> & publish_rate_parameters)
+{
+  if (!rclcpp::ok())
+  {
+    rclcpp::init(0, nullptr);
+  }
+  const bool contended = state.range(0) != 0;
+  const bool decimated = state.range(1) != 0;
+  for (const auto & publish_rate_parameter : publish_rate_parameters)
+  {
+    parameters.emplace_back(publish_rate_parameter, decimated ? DECIMATED_PUBLISH_RATE : 0.0);
+  }
+
+  auto broadcaster = std::make_unique<BroadcasterT>();
+  auto node_options = broadcaster->define_custom_node_options();
+  node_options.parameter_overrides(parameters);
+  if (
+    broadcaster->init(name, "", UPDATE_RATE, "", node_options) !=
+      controller_interface::return_type::OK ||
+    broadcaster->on_configure(rclcpp_lifecycle::State()) !=
+      controller_interface::CallbackReturn::SUCCESS)
+  {
+    state.SkipWithError("init or configure failed");
+    return;
+  }
+
+  // mock state interfaces for all interfaces the broadcaster claims
+  const auto names = broadcaster->state_interface_configuration().names;
+  std::vector<double> values(names.size());
+  std::vector<hardware_interface::StateInterface> state_interfaces;
+  state_interfaces.reserve(names.size());
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    const auto separator = names[i].find_last_of('/');
+    values[i] = state_value(names[i], i);
+    state_interfaces.emplace_back(
+      names[i].substr(0, separator), names[i].substr(separator + 1), &values[i]);
+  }
+  std::vector<hardware_interface::LoanedStateInterface> loaned_state_interfaces;
+  for (auto & state_interface : state_interfaces)
+  {
+    loaned_state_interfaces.emplace_back(state_interface);
+  }
+  broadcaster->assign_interfaces({}, std::move(loaned_state_interfaces));
+  if (
+    broadcaster->on_activate(rclcpp_lifecycle::State()) !=
+    controller_interface::CallbackReturn::SUCCESS)
+  {
+    state.SkipWithError("activate failed");
+    return;
+  }
+
+  // a non-RT thread copying the message under the lock, like a publishing thread does
+  auto & realtime_publisher = broadcaster->realtime_publisher();
+  std::atomic<bool> contending{contended};
+  std::thread contender;
+  if (contended)
+  {
+    contender = std::thread(
+      [&realtime_publisher, &contending]()
+      {
+        while (contending.load(std::memory_order_relaxed))
+        {
+          realtime_publisher.lock();
+          auto msg = realtime_publisher.msg_;
+          benchmark::DoNotOptimize(msg);
+          realtime_publisher.unlock();
+          std::this_thread::yield();
+        }
+      });
+  }
+
+  const size_t decimation =
+    decimated ? static_cast<size_t>(UPDATE_RATE / DECIMATED_PUBLISH_RATE) : 1;
+  const rclcpp::Duration period = rclcpp::Duration::from_seconds(1.0 / UPDATE_RATE);
+  int64_t nanoseconds = 0;
+  size_t cycle = 0;
+  int64_t publish_cycles = 0;
+  int64_t failed_trylocks = 0;
+  allocations = 0;
+  for (auto _ : state)
+  {
+    nanoseconds += period.nanoseconds();
+    const rclcpp::Time time(nanoseconds, RCL_ROS_TIME);
+    count_allocations = true;
+    benchmark::DoNotOptimize(broadcaster->update(time, period));
+    count_allocations = false;
+    benchmark::ClobberMemory();
+
+    // the stamp is only written by this thread, after a successful trylock
+    if (++cycle % decimation == 0)
+    {
+      ++publish_cycles;
+      if (rclcpp::Time(realtime_publisher.msg_.header.stamp).nanoseconds() != nanoseconds)
+      {
+        ++failed_trylocks;
+      }
+    }
+  }
+
+  contending = false;
+  if (contender.joinable())
+  {
+    contender.join();
+  }
+  state.counters["trylock_failure_rate"] =
+    publish_cycles > 0
+      ? static_cast<double>(failed_trylocks) / static_cast<double>(publish_cycles)
+      : 0.0;
+  state.counters["allocations_per_cycle"] = benchmark::Counter(
+    static_cast<double>(allocations.load()), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_IMUSensorBroadcasterUpdate(benchmark::State & state)
+{
+  run_update_benchmark<BenchmarkIMUSensorBroadcaster>(
+    state, "benchmark_imu_sensor_broadcaster",
+    {rclcpp::Parameter("sensor_name", "imu_sensor"),
+     rclcpp::Parameter("frame_id", "imu_sensor_frame")},
+    {"publish_policy.rate"});
+}
+
+void BM_ForceTorqueSensorBroadcasterUpdate(benchmark::State & state)
+{
+  run_update_benchmark<BenchmarkForceTorqueSensorBroadcaster>(
+    state, "benchmark_force_torque_sensor_broadcaster",
+    {rclcpp::Parameter("sensor_name", "ft_sensor"),
+     rclcpp::Parameter("frame_id", "ft_sensor_frame")},
+    {"publish_policy.rate"});
+}
+
+void BM_RangeSensorBroadcasterUpdate(benchmark::State & state)
+{
+  run_update_benchmark<BenchmarkRangeSensorBroadcaster>(
+    state, "benchmark_range_sensor_broadcaster",
+    {rclcpp::Parameter("sensor_name", "range_sensor"),
+     rclcpp::Parameter("frame_id", "range_sensor_frame")},
+    {"publish_policy.rate"});
+}
+
+void BM_GPSSensorBroadcasterUpdate(benchmark::State & state)
+{
+  run_update_benchmark<BenchmarkGPSSensorBroadcaster>(
+    state, "benchmark_gps_sensor_broadcaster",
+    {rclcpp::Parameter("sensor_name", "gps_sensor"),
+     rclcpp::Parameter("frame_id", "gps_sensor_frame")},
+    {"publish_policy.rate"});
+}
+
+void BM_PoseBroadcasterUpdate(benchmark::State & state)
+{
+  run_update_benchmark<BenchmarkPoseBroadcaster>(
+    state, "benchmark_pose_broadcaster",
+    {rclcpp::Parameter("pose_name", "pose_sensor"),
+     rclcpp::Parameter("frame_id", "base_link"),
+     rclcpp::Parameter("tf.child_frame_id", "pose_sensor_frame")},
+    {"publish_policy.rate"});
+}
+
+// All of the above in one controller, the trylock failure rate is the one of the IMU
+void BM_SensorHubBroadcasterUpdate(benchmark::State & state)
+{
+  const std::vector<std::pair<std::string, std::string>> sensors = {
+    {"imu_sensor", "imu"},
+    {"ft_sensor", "force_torque"},
+    {"range_sensor", "range"},
+    {"gps_sensor", "gps"},
+    {"pose_sensor", "pose"}};
+  std::vector<std::string> sensor_names;
+  std::vector<rclcpp::Parameter> parameters;
+  std::vector<std::string> publish_rate_parameters;
+  for (const auto & [sensor_name, type] : sensors)
+  {
+    sensor_names.push_back(sensor_name);
+    parameters.emplace_back("sensor_params." + sensor_name + ".type", type);
+    parameters.emplace_back("sensor_params." + sensor_name + ".frame_id", sensor_name + "_frame");
+    publish_rate_parameters.push_back("sensor_params." + sensor_name + ".rate");
+  }
+  parameters.emplace_back("sensors", sensor_names);
+  run_update_benchmark<BenchmarkSensorHubBroadcaster>(
+    state, "benchmark_sensor_hub_broadcaster", parameters, publish_rate_parameters);
+}
+
+void ContentionArgs(benchmark::internal::Benchmark * benchmark)
+{
+  benchmark->ArgNames({"contended", "decimated"});
+  for (const int64_t contended : {0, 1})
+  {
+    for (const int64_t decimated : {0, 1})
+    {
+      benchmark->Args({contended, decimated});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_IMUSensorBroadcasterUpdate)->Apply(ContentionArgs);
+BENCHMARK(BM_ForceTorqueSensorBroadcasterUpdate)->Apply(ContentionArgs);
+BENCHMARK(BM_RangeSensorBroadcasterUpdate)->Apply(ContentionArgs);
+BENCHMARK(BM_GPSSensorBroadcasterUpdate)->Apply(ContentionArgs);
+BENCHMARK(BM_PoseBroadcasterUpdate)->Apply(ContentionArgs);
+BENCHMARK(BM_SensorHubBroadcasterUpdate)->Apply(ContentionArgs);
@@ -0,0 +1,168 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+
+#include "test_sensor_hub_broadcaster.hpp"
+
+#include "hardware_interface/loaned_state_interface.hpp"
+#include "rclcpp/executor.hpp"
+#include "rclcpp/executors.hpp"
+
+using testing::IsEmpty;
+
+void SensorHubBroadcasterTest::SetUp()
+{
+  // initialize controller
+  sensor_hub_broadcaster_ = std::make_unique<sensor_hub_broadcaster::SensorHubBroadcaster>();
+}
+
+void SensorHubBroadcasterTest::TearDown() { sensor_hub_broadcaster_.reset(nullptr); }
+
+controller_interface::return_type SensorHubBroadcasterTest::init_broadcaster(
+  const std::string & broadcaster_name, unsigned int update_rate)
+{
+  controller_interface::return_type result = sensor_hub_broadcaster_->init(
+    broadcaster_name, "", update_rate, "", sensor_hub_broadcaster_->define_custom_node_options());
+
+  if (controller_interface::return_type::OK == result)
+  {
+    std::vector<hardware_interface::LoanedStateInterface> state_interfaces;
+    for (auto & imu_interface : imu_interfaces_)
+    {
+      state_interfaces.emplace_back(imu_interface);
+    }
+    state_interfaces.emplace_back(range_interface_);
+
+    sensor_hub_broadcaster_->assign_interfaces({}, std::move(state_interfaces));
+  }
+
+  return result;
+}
+
+template <typename MessageT>
+void SensorHubBroadcasterTest::subscribe_and_get_message(
+  MessageT & msg, const std::string & topic)
+{
+  // create a new subscriber
+  typename MessageT::SharedPtr received_msg;
+  rclcpp::Node test_subscription_node("test_subscription_node");
+  auto subs_callback = [&](const typename MessageT::SharedPtr sub_msg) { received_msg = sub_msg; };
+  auto subscription =
+    test_subscription_node.create_subscription<MessageT>(topic, 10, subs_callback);
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(test_subscription_node.get_node_base_interface());
+
+  // call update to publish the test value
+  // since update doesn't guarantee a published message, republish until received
+  int max_sub_check_loop_count = 5;  // max number of tries for pub/sub loop
+  while (max_sub_check_loop_count--)
+  {
+    sensor_hub_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01));
+    const auto timeout = std::chrono::milliseconds{5};
+    const auto until = test_subscription_node.get_clock()->now() + timeout;
+    while (!received_msg && test_subscription_node.get_clock()->now() < until)
+    {
+      executor.spin_some();
+      std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+    // check if message has been received
+    if (received_msg.get())
+    {
+      break;
+    }
+  }
+  ASSERT_GE(max_sub_check_loop_count, 0) << "Test was unable to publish a message through "
+                                            "controller/broadcaster update loop";
+  ASSERT_TRUE(received_msg);
+
+  // take message from subscription
+  msg = *received_msg;
+}
+
+TEST_F(SensorHubBroadcasterTest, Initialize_SensorHubBroadcaster_Exception)
+{
+  ASSERT_THROW(init_broadcaster(""), std::exception);
+}
+
+TEST_F(SensorHubBroadcasterTest, Configure_SensorHubBroadcaster_NoFrameId)
+{
+  ASSERT_EQ(
+    init_broadcaster("test_sensor_hub_broadcaster_no_frame_id"),
+    controller_interface::return_type::OK);
+  ASSERT_EQ(
+    sensor_hub_broadcaster_->on_configure(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::ERROR);
+}
+
+TEST_F(SensorHubBroadcasterTest, Configure_SensorHubBroadcaster_Success)
+{
+  ASSERT_EQ(init_broadcaster("test_sensor_hub_broadcaster"), controller_interface::return_type::OK);
+  ASSERT_EQ(
+    sensor_hub_broadcaster_->on_configure(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+
+  // check interface configuration
+  auto cmd_if_conf = sensor_hub_broadcaster_->command_interface_configuration();
+  ASSERT_THAT(cmd_if_conf.names, IsEmpty());
+  EXPECT_EQ(cmd_if_conf.type, controller_interface::interface_configuration_type::NONE);
+
+  // the interfaces of all sensors in the order of the sensors parameter
+  auto state_if_conf = sensor_hub_broadcaster_->state_interface_configuration();
+  EXPECT_EQ(state_if_conf.type, controller_interface::interface_configuration_type::INDIVIDUAL);
+  ASSERT_EQ(state_if_conf.names.size(), imu_interfaces_.size() + 1);
+  for (size_t i = 0; i < imu_interfaces_.size(); ++i)
+  {
+    EXPECT_EQ(state_if_conf.names[i], imu_interfaces_[i].get_name());
+  }
+  EXPECT_EQ(state_if_conf.names.back(), range_interface_.get_name());
+}
+
+TEST_F(SensorHubBroadcasterTest, Publish_SensorHubBroadcaster_Success)
+{
+  ASSERT_EQ(
+    init_broadcaster("test_sensor_hub_broadcaster", 100), controller_interface::return_type::OK);
+  ASSERT_EQ(
+    sensor_hub_broadcaster_->on_configure(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+  ASSERT_EQ(
+    sensor_hub_broadcaster_->on_activate(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+
+  // the IMU is published on every update
+  sensor_msgs::msg::Imu imu_msg;
+  subscribe_and_get_message(imu_msg, "/test_sensor_hub_broadcaster/imu_sensor/imu");
+  EXPECT_EQ(imu_msg.header.frame_id, imu_frame_id_);
+  EXPECT_EQ(imu_msg.orientation.w, imu_values_[3]);
+  EXPECT_EQ(imu_msg.angular_velocity.z, imu_values_[6]);
+  EXPECT_EQ(imu_msg.linear_acceleration.z, imu_values_[9]);
+
+  // the range is published on every second update, as the minimum of both updates
+  ASSERT_EQ(
+    sensor_hub_broadcaster_->on_deactivate(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+  ASSERT_EQ(
+    sensor_hub_broadcaster_->on_activate(rclcpp_lifecycle::State()),
+    controller_interface::CallbackReturn::SUCCESS);
+  range_value_ = 1.5;
+  ASSERT_EQ(
+    sensor_hub_broadcaster_->update(rclcpp::Time(0), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  range_value_ = 3.1;
+  sensor_msgs::msg::Range range_msg;
+  subscribe_and_get_message(range_msg, "/test_sensor_hub_broadcaster/range_sensor/range");
+  EXPECT_EQ(range_msg.header.frame_id, range_frame_id_);
+  EXPECT_THAT(range_msg.range, ::testing::FloatEq(1.5f));
+  EXPECT_THAT(range_msg.max_range, ::testing::FloatEq(7.0f));
+}
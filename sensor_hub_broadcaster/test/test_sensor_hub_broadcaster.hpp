@@ -0,0 +1,64 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_SENSOR_HUB_BROADCASTER_HPP_
+#define TEST_SENSOR_HUB_BROADCASTER_HPP_
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "sensor_hub_broadcaster/sensor_hub_broadcaster.hpp"
+
+class SensorHubBroadcasterTest : public ::testing::Test
+{
+public:
+  void SetUp();
+  void TearDown();
+
+protected:
+  // for the sake of the test
+  // defining the parameter names same as in test/sensor_hub_broadcaster_params.yaml
+  const std::string imu_sensor_name_ = "imu_sensor";
+  const std::string imu_frame_id_ = "imu_sensor_frame";
+  const std::string range_sensor_name_ = "range_sensor";
+  const std::string range_frame_id_ = "range_sensor_frame";
+
+  std::array<double, 10> imu_values_ = {{0.0, 0.0, 0.0, 1.0, 0.1, 0.2, 0.3, 1.1, 1.2, 9.81}};
+  std::vector<hardware_interface::StateInterface> imu_interfaces_{
+    {imu_sensor_name_, "orientation.x", &imu_values_[0]},
+    {imu_sensor_name_, "orientation.y", &imu_values_[1]},
+    {imu_sensor_name_, "orientation.z", &imu_values_[2]},
+    {imu_sensor_name_, "orientation.w", &imu_values_[3]},
+    {imu_sensor_name_, "angular_velocity.x", &imu_values_[4]},
+    {imu_sensor_name_, "angular_velocity.y", &imu_values_[5]},
+    {imu_sensor_name_, "angular_velocity.z", &imu_values_[6]},
+    {imu_sensor_name_, "linear_acceleration.x", &imu_values_[7]},
+    {imu_sensor_name_, "linear_acceleration.y", &imu_values_[8]},
+    {imu_sensor_name_, "linear_acceleration.z", &imu_values_[9]}};
+  double range_value_ = 3.1;
+  hardware_interface::StateInterface range_interface_{range_sensor_name_, "range", &range_value_};
+
+  std::unique_ptr<sensor_hub_broadcaster::SensorHubBroadcaster> sensor_hub_broadcaster_;
+
+  controller_interface::return_type init_broadcaster(
+    const std::string & broadcaster_name, unsigned int update_rate = 0);
+  template <typename MessageT>
+  void subscribe_and_get_message(MessageT & msg, const std::string & topic);
+};
+
+#endif  // TEST_SENSOR_HUB_BROADCASTER_HPP_
@@ -25,10 +25,15 @@
 #include "rclcpp_lifecycle/state.hpp"
 #include "realtime_tools/realtime_buffer.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
+#include "std_srvs/srv/empty.hpp"
 
 // TODO(anyone): Replace with controller specific messages
 #include "control_msgs/msg/steering_controller_status.hpp"
+#include "geometry_msgs/msg/pose_with_covariance_stamped.hpp"
 #include "geometry_msgs/msg/twist_stamped.hpp"
+#include "mobile_base_controllers_common/inverse_kinematics_cache.hpp"
+#include "mobile_base_controllers_common/inverse_kinematics_cache_diagnostics.hpp"
+#include "mobile_base_controllers_common/odometry_reset_request.hpp"
 #include "nav_msgs/msg/odometry.hpp"
 #include "tf2_msgs/msg/tf_message.hpp"
 
@@ -73,6 +78,7 @@ public:
   using ControllerStateMsgOdom = nav_msgs::msg::Odometry;
   using ControllerStateMsgTf = tf2_msgs::msg::TFMessage;
   using SteeringControllerStateMsg = control_msgs::msg::SteeringControllerStatus;
+  using OdometryPoseMsg = geometry_msgs::msg::PoseWithCovarianceStamped;
 
 protected:
   controller_interface::CallbackReturn set_interface_numbers(
@@ -109,6 +115,17 @@ protected:
   rclcpp::Publisher<SteeringControllerStateMsg>::SharedPtr controller_s_publisher_;
   std::unique_ptr<ControllerStatePublisher> controller_state_publisher_;
 
+  // Commands of the last reference, keyed on the reference and the measured steering angle
+  struct SteadyCommands
+  {
+    std::vector<double> traction;
+    std::vector<double> steering;
+  };
+  using SteadyCommandsCache =
+    mobile_base_controllers_common::InverseKinematicsCache<3, SteadyCommands>;
+  SteadyCommandsCache ik_cache_;
+  mobile_base_controllers_common::InverseKinematicsCacheDiagnostics ik_cache_diagnostics_;
+
   // name constants for state interfaces
   size_t nr_state_itfs_;
   // name constants for command interfaces
@@ -123,6 +140,20 @@ protected:
   std::vector<std::string> traction_joints_state_names_;
   std::vector<std::string> steering_joints_state_names_;
 
+  rclcpp::Service<std_srvs::srv::Empty>::SharedPtr reset_odom_service_;
+  rclcpp::Subscription<OdometryPoseMsg>::SharedPtr set_odometry_pose_subscriber_ = nullptr;
+
+  // Odometry reset requested by the service or the set pose subscriber, applied by the next update
+  using OdometryResetRequest = mobile_base_controllers_common::OdometryResetRequest;
+  mobile_base_controllers_common::OdometryResetSlot odometry_reset_slot_;
+
+  void reset_odometry(
+    const std::shared_ptr<rmw_request_id_t> request_header,
+    const std::shared_ptr<std_srvs::srv::Empty::Request> req,
+    std::shared_ptr<std_srvs::srv::Empty::Response> res);
+  void set_odometry_pose(const std::shared_ptr<OdometryPoseMsg> msg);
+  void apply_odometry_reset_request();
+
 private:
   // callback for topic interface
   void reference_callback(const std::shared_ptr<ControllerTwistReferenceMsg> msg);
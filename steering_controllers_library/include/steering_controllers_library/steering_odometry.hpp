@@ -18,6 +18,7 @@
 #ifndef STEERING_CONTROLLERS_LIBRARY__STEERING_ODOMETRY_HPP_
 #define STEERING_CONTROLLERS_LIBRARY__STEERING_ODOMETRY_HPP_
 
+#include <array>
 #include <cmath>
 #include <tuple>
 #include <vector>
@@ -157,6 +158,12 @@ public:
    */
   double get_heading() const { return heading_; }
 
+  /**
+   * \brief steering angle getter
+   * \return measured steering angle of the virtual wheel in the middle of the steering axle [rad]
+   */
+  double get_steer_pos() const { return steer_pos_; }
+
   /**
    * \brief x position getter
    * \return x position [m]
@@ -181,6 +188,12 @@ public:
    */
   double get_angular() const { return angular_; }
 
+  /**
+   * \brief pose covariance getter
+   * \return row-major covariance of x [m], y [m] and heading [rad]
+   */
+  const std::array<double, 9> & get_pose_covariance() const { return pose_covariance_; }
+
   /**
    * \brief Sets the wheel parameters: radius, wheel_base, and wheel_track
    */
@@ -200,6 +213,17 @@ public:
    */
   void set_velocity_rolling_window_size(const size_t velocity_rolling_window_size);
 
+  /**
+   * \brief Enables the propagation of the pose covariance from the wheel noise model
+   * \param enable If false, the pose covariance is not updated
+   * \param traction_wheel_variance_rate Variance of the traction displacement per distance [m^2/m]
+   * \param steering_angle_variance_rate Variance of the steering angle error integrated along the
+   * path per distance [rad^2 m]
+   */
+  void set_pose_covariance_propagation(
+    const bool enable, const double traction_wheel_variance_rate,
+    const double steering_angle_variance_rate);
+
   /**
    * \brief Calculates inverse kinematics for the desired linear and angular velocities
    * \param v_bx     Desired linear velocity of the robot in x_b-axis direction
@@ -218,6 +242,17 @@ public:
    */
   void reset_odometry();
 
+  /**
+   *  \brief Set the pose, e.g., for relocalization
+   * \param x Position in x-axis direction [m]
+   * \param y Position in y-axis direction [m]
+   * \param heading Heading [rad]
+   * \param pose_covariance Row-major covariance of x, y and heading, zero by default
+   */
+  void set_pose(
+    const double x, const double y, const double heading,
+    const std::array<double, 9> & pose_covariance = {});
+
 private:
   /**
    * \brief Uses precomputed linear and angular velocities to compute odometry
@@ -227,6 +262,14 @@ private:
    */
   bool update_odometry(const double v_bx, const double omega_bz, const double dt);
 
+  /**
+   * \brief Propagates the pose covariance through one integration step, before it is integrated
+   * \param traction_displacement Displacement of the traction axle [m]
+   * \param angular_displacement Angular displacement of the base [rad]
+   */
+  void propagate_pose_covariance(
+    const double traction_displacement, const double angular_displacement);
+
   /**
    * \brief Integrates the velocities (linear and angular) using 2nd order Runge-Kutta
    * \param v_bx Linear velocity [m/s]
@@ -285,6 +328,12 @@ private:
   double linear_;   //   [m/s]
   double angular_;  // [rad/s]
 
+  /// Covariance of the pose, propagated by the wheel noise model:
+  bool propagate_pose_covariance_;
+  double traction_wheel_variance_rate_;  // [m^2/m]
+  double steering_angle_variance_rate_;  // [rad^2 m]
+  std::array<double, 9> pose_covariance_;
+
   /// Kinematic parameters
   double wheel_track_traction_;  // [m]
   double wheel_track_steering_;  // [m]
@@ -302,6 +351,8 @@ private:
   size_t velocity_rolling_window_size_;
   RollingMeanAccumulator linear_acc_;
   RollingMeanAccumulator angular_acc_;
+  /// Cleared accumulator of the window size, copied to reset the accumulators without allocation
+  RollingMeanAccumulator empty_acc_;
 };
 }  // namespace steering_odometry
 
@@ -14,13 +14,16 @@
 
 #include "steering_controllers_library/steering_controllers_library.hpp"
 
+#include <array>
 #include <limits>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "tf2/LinearMath/Matrix3x3.hpp"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 
 namespace
@@ -156,6 +159,13 @@ controller_interface::CallbackReturn SteeringControllersLibrary::on_configure(
 
   odometry_.set_velocity_rolling_window_size(
     static_cast<size_t>(params_.velocity_rolling_window_size));
+  odometry_.set_pose_covariance_propagation(
+    params_.pose_covariance_propagation.enable,
+    params_.pose_covariance_propagation.traction_wheel_variance_rate,
+    params_.pose_covariance_propagation.steering_angle_variance_rate);
+  // discard a request which was not applied yet
+  OdometryResetRequest discarded_request;
+  odometry_reset_slot_.read(discarded_request);
 
   if (!params_.traction_joints_state_names.empty())
   {
@@ -339,6 +349,34 @@ controller_interface::CallbackReturn SteeringControllersLibrary::on_configure(
   controller_state_publisher_->msg_.header.stamp = get_node()->now();
   controller_state_publisher_->msg_.header.frame_id = params_.odom_frame_id;
   controller_state_publisher_->unlock();
+
+  if (params_.inverse_kinematics_cache.enable)
+  {
+    try
+    {
+      // inverse kinematics cache statistics publisher
+      ik_cache_diagnostics_.configure(get_node());
+    }
+    catch (const std::exception & e)
+    {
+      fprintf(
+        stderr,
+        "Exception thrown during publisher creation at configure stage with message : %s \n",
+        e.what());
+      return controller_interface::CallbackReturn::ERROR;
+    }
+  }
+  // computed with the previous kinematics
+  ik_cache_.invalidate();
+
+  reset_odom_service_ = get_node()->create_service<std_srvs::srv::Empty>(
+    "~/reset_odometry", std::bind(
+                          &SteeringControllersLibrary::reset_odometry, this, std::placeholders::_1,
+                          std::placeholders::_2, std::placeholders::_3));
+  set_odometry_pose_subscriber_ = get_node()->create_subscription<OdometryPoseMsg>(
+    "~/set_odometry_pose", rclcpp::SystemDefaultsQoS(),
+    std::bind(&SteeringControllersLibrary::set_odometry_pose, this, std::placeholders::_1));
+
   RCLCPP_INFO(get_node()->get_logger(), "configure successful");
   return controller_interface::CallbackReturn::SUCCESS;
 }
@@ -438,6 +476,51 @@ SteeringControllersLibrary::on_export_reference_interfaces()
   return reference_interfaces;
 }
 
+void SteeringControllersLibrary::reset_odometry(
+  const std::shared_ptr<rmw_request_id_t> /*request_header*/,
+  const std::shared_ptr<std_srvs::srv::Empty::Request> /*req*/,
+  std::shared_ptr<std_srvs::srv::Empty::Response> /*res*/)
+{
+  odometry_reset_slot_.write(OdometryResetRequest{});
+  RCLCPP_INFO(get_node()->get_logger(), "Odometry reset requested");
+}
+
+void SteeringControllersLibrary::set_odometry_pose(const std::shared_ptr<OdometryPoseMsg> msg)
+{
+  if (!msg->header.frame_id.empty() && msg->header.frame_id != params_.odom_frame_id)
+  {
+    RCLCPP_WARN(
+      get_node()->get_logger(), "Odometry pose ignored, it is in frame '%s' instead of '%s'",
+      msg->header.frame_id.c_str(), params_.odom_frame_id.c_str());
+    return;
+  }
+
+  tf2::Quaternion orientation;
+  tf2::fromMsg(msg->pose.pose.orientation, orientation);
+  double roll, pitch, yaw;
+  tf2::Matrix3x3(orientation).getRPY(roll, pitch, yaw);
+  odometry_reset_slot_.write(
+    {true, msg->pose.pose.position.x, msg->pose.pose.position.y, yaw,
+     mobile_base_controllers_common::planar_pose_covariance(msg->pose.covariance)});
+}
+
+void SteeringControllersLibrary::apply_odometry_reset_request()
+{
+  OdometryResetRequest request;
+  if (!odometry_reset_slot_.read(request))
+  {
+    return;
+  }
+  if (request.set_pose)
+  {
+    odometry_.set_pose(request.x, request.y, request.heading, request.pose_covariance);
+  }
+  else
+  {
+    odometry_.reset_odometry();
+  }
+}
+
 bool SteeringControllersLibrary::on_set_chained_mode(bool /*chained_mode*/) { return true; }
 
 controller_interface::CallbackReturn SteeringControllersLibrary::on_activate(
@@ -445,6 +528,9 @@ controller_interface::CallbackReturn SteeringControllersLibrary::on_activate(
 {
   // Set default value in command
   reset_controller_reference_msg(*(input_ref_.readFromRT()), get_node());
+  // discard a request which was not applied yet
+  OdometryResetRequest discarded_request;
+  odometry_reset_slot_.read(discarded_request);
 
   return controller_interface::CallbackReturn::SUCCESS;
 }
@@ -456,6 +542,7 @@ controller_interface::CallbackReturn SteeringControllersLibrary::on_deactivate(
   {
     command_interfaces_[i].set_value(std::numeric_limits<double>::quiet_NaN());
   }
+  ik_cache_.invalidate();
   return controller_interface::CallbackReturn::SUCCESS;
 }
 
@@ -476,6 +563,7 @@ controller_interface::return_type SteeringControllersLibrary::update_reference_f
 controller_interface::return_type SteeringControllersLibrary::update_and_write_commands(
   const rclcpp::Time & time, const rclcpp::Duration & period)
 {
+  apply_odometry_reset_request();
   update_odometry(period);
 
   // MOVE ROBOT
@@ -493,17 +581,33 @@ controller_interface::return_type SteeringControllersLibrary::update_and_write_c
     last_linear_velocity_ = timeout ? 0.0 : reference_interfaces_[0];
     last_angular_velocity_ = timeout ? 0.0 : reference_interfaces_[1];
 
-    auto [traction_commands, steering_commands] = odometry_.get_commands(
-      reference_interfaces_[0], reference_interfaces_[1], params_.open_loop,
-      params_.reduce_wheel_speed_until_steering_reached);
+    // the measured steering angle is only used in closed loop
+    const SteadyCommandsCache::Key ik_key = {
+      {reference_interfaces_[0], reference_interfaces_[1],
+       params_.open_loop ? 0.0 : odometry_.get_steer_pos()}};
+    const SteadyCommands * commands =
+      params_.inverse_kinematics_cache.enable ? ik_cache_.lookup(ik_key) : nullptr;
+    SteadyCommands computed_commands;
+    if (!commands)
+    {
+      std::tie(computed_commands.traction, computed_commands.steering) = odometry_.get_commands(
+        reference_interfaces_[0], reference_interfaces_[1], params_.open_loop,
+        params_.reduce_wheel_speed_until_steering_reached);
+      if (params_.inverse_kinematics_cache.enable)
+      {
+        ik_cache_.store(ik_key, computed_commands);
+      }
+      commands = &computed_commands;
+    }
 
     for (size_t i = 0; i < params_.traction_joints_names.size(); i++)
     {
-      command_interfaces_[i].set_value(timeout ? 0.0 : traction_commands[i]);
+      command_interfaces_[i].set_value(timeout ? 0.0 : commands->traction[i]);
     }
     for (size_t i = 0; i < params_.steering_joints_names.size(); i++)
     {
-      command_interfaces_[i + params_.traction_joints_names.size()].set_value(steering_commands[i]);
+      command_interfaces_[i + params_.traction_joints_names.size()].set_value(
+        commands->steering[i]);
     }
   }
 
@@ -521,6 +625,11 @@ controller_interface::return_type SteeringControllersLibrary::update_and_write_c
     rt_odom_state_publisher_->msg_.pose.pose.orientation = tf2::toMsg(orientation);
     rt_odom_state_publisher_->msg_.twist.twist.linear.x = odometry_.get_linear();
     rt_odom_state_publisher_->msg_.twist.twist.angular.z = odometry_.get_angular();
+    if (params_.pose_covariance_propagation.enable)
+    {
+      mobile_base_controllers_common::set_planar_pose_covariance(
+        odometry_.get_pose_covariance(), rt_odom_state_publisher_->msg_.pose.covariance);
+    }
     rt_odom_state_publisher_->unlockAndPublish();
   }
 
@@ -579,6 +688,11 @@ controller_interface::return_type SteeringControllersLibrary::update_and_write_c
   reference_interfaces_[0] = std::numeric_limits<double>::quiet_NaN();
   reference_interfaces_[1] = std::numeric_limits<double>::quiet_NaN();
 
+  if (params_.inverse_kinematics_cache.enable)
+  {
+    ik_cache_diagnostics_.publish(time, ik_cache_.hits(), ik_cache_.lookups());
+  }
+
   return controller_interface::return_type::OK;
 }
 
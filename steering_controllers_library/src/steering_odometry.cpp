@@ -24,15 +24,22 @@
 #include <cmath>
 #include <limits>
 
+#include "mobile_base_controllers_common/pose_covariance_propagation.hpp"
+
 namespace steering_odometry
 {
 SteeringOdometry::SteeringOdometry(size_t velocity_rolling_window_size)
 : timestamp_(0.0),
   x_(0.0),
   y_(0.0),
+  steer_pos_(0.0),
   heading_(0.0),
   linear_(0.0),
   angular_(0.0),
+  propagate_pose_covariance_(false),
+  traction_wheel_variance_rate_(0.0),
+  steering_angle_variance_rate_(0.0),
+  pose_covariance_{},
   wheel_track_traction_(0.0),
   wheel_track_steering_(0.0),
   wheel_base_(0.0),
@@ -42,7 +49,8 @@ SteeringOdometry::SteeringOdometry(size_t velocity_rolling_window_size)
   traction_left_wheel_old_pos_(0.0),
   velocity_rolling_window_size_(velocity_rolling_window_size),
   linear_acc_(velocity_rolling_window_size),
-  angular_acc_(velocity_rolling_window_size)
+  angular_acc_(velocity_rolling_window_size),
+  empty_acc_(velocity_rolling_window_size)
 {
 }
 
@@ -56,6 +64,11 @@ void SteeringOdometry::init(const rclcpp::Time & time)
 bool SteeringOdometry::update_odometry(
   const double linear_velocity, const double angular_velocity, const double dt)
 {
+  if (propagate_pose_covariance_)
+  {
+    propagate_pose_covariance(linear_velocity * dt, angular_velocity * dt);
+  }
+
   /// Integrate odometry:
   integrate_fk(linear_velocity, angular_velocity, dt);
 
@@ -215,10 +228,20 @@ void SteeringOdometry::set_wheel_params(
 void SteeringOdometry::set_velocity_rolling_window_size(size_t velocity_rolling_window_size)
 {
   velocity_rolling_window_size_ = velocity_rolling_window_size;
+  empty_acc_ = RollingMeanAccumulator(velocity_rolling_window_size_);
 
   reset_accumulators();
 }
 
+void SteeringOdometry::set_pose_covariance_propagation(
+  const bool enable, const double traction_wheel_variance_rate,
+  const double steering_angle_variance_rate)
+{
+  propagate_pose_covariance_ = enable;
+  traction_wheel_variance_rate_ = traction_wheel_variance_rate;
+  steering_angle_variance_rate_ = steering_angle_variance_rate;
+}
+
 void SteeringOdometry::set_odometry_type(const unsigned int type)
 {
   config_type_ = static_cast<int>(type);
@@ -351,9 +374,43 @@ void SteeringOdometry::reset_odometry()
   x_ = 0.0;
   y_ = 0.0;
   heading_ = 0.0;
+  pose_covariance_.fill(0.0);
   reset_accumulators();
 }
 
+void SteeringOdometry::set_pose(
+  const double x, const double y, const double heading,
+  const std::array<double, 9> & pose_covariance)
+{
+  x_ = x;
+  y_ = y;
+  heading_ = heading;
+  pose_covariance_ = pose_covariance;
+}
+
+void SteeringOdometry::propagate_pose_covariance(
+  const double traction_displacement, const double angular_displacement)
+{
+  // The displacement error of the traction axle and the steering angle error integrated along the
+  // path grow with the distance travelled, so that the result does not depend on the update rate.
+  // Mapped to the linear and angular displacement of the base, d and d*tan(steer_pos)/wheel_base,
+  // their covariance is:
+  const double distance = std::abs(traction_displacement);
+  const double traction_variance = traction_wheel_variance_rate_ * distance;
+  const double steering_variance = steering_angle_variance_rate_ * distance;
+  const double cos_steer = std::cos(steer_pos_);
+  const double dangular_dtraction = std::tan(steer_pos_) / wheel_base_;
+  const double dangular_dsteer = 1.0 / (wheel_base_ * cos_steer * cos_steer);
+  const double linear_variance = traction_variance;
+  const double linear_angular_covariance = dangular_dtraction * traction_variance;
+  const double angular_variance = dangular_dtraction * dangular_dtraction * traction_variance +
+                                  dangular_dsteer * dangular_dsteer * steering_variance;
+
+  mobile_base_controllers_common::propagate_planar_pose_covariance(
+    pose_covariance_, heading_, traction_displacement, angular_displacement, linear_variance,
+    linear_angular_covariance, angular_variance);
+}
+
 void SteeringOdometry::integrate_runge_kutta_2(
   const double v_bx, const double omega_bz, const double dt)
 {
@@ -389,8 +446,9 @@ void SteeringOdometry::integrate_fk(const double v_bx, const double omega_bz, co
 
 void SteeringOdometry::reset_accumulators()
 {
-  linear_acc_ = RollingMeanAccumulator(velocity_rolling_window_size_);
-  angular_acc_ = RollingMeanAccumulator(velocity_rolling_window_size_);
+  // copy assignment reuses the buffers of the same window size, so this does not allocate
+  linear_acc_ = empty_acc_;
+  angular_acc_ = empty_acc_;
 }
 
 }  // namespace steering_odometry
@@ -18,6 +18,8 @@
 #include <vector>
 
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "tf2/LinearMath/Quaternion.hpp"
+#include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 #include "test_steering_controllers_library.hpp"
 
 class SteeringControllersLibraryTest
@@ -198,6 +200,104 @@ TEST_F(SteeringControllersLibraryTest, test_both_update_methods_for_ref_timeout)
   EXPECT_NEAR(controller_->command_interfaces_[3].get_value(), 0.575875, 1e-6);
 }
 
+TEST_F(SteeringControllersLibraryTest, odometry_reset_is_applied_by_the_next_update)
+{
+  SetUpController();
+
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+
+  auto pose_msg = [](double x, double y, double heading, const std::string & frame_id)
+  {
+    auto msg = std::make_shared<geometry_msgs::msg::PoseWithCovarianceStamped>();
+    msg->header.frame_id = frame_id;
+    msg->pose.pose.position.x = x;
+    msg->pose.pose.position.y = y;
+    tf2::Quaternion orientation;
+    orientation.setRPY(0.0, 0.0, heading);
+    msg->pose.pose.orientation = tf2::toMsg(orientation);
+    return msg;
+  };
+
+  controller_->set_odometry_pose(pose_msg(1.0, -2.0, 0.5, "odom"));
+  // the callbacks only hand the request over
+  EXPECT_EQ(controller_->odometry_.get_x(), 0.0);
+
+  ASSERT_EQ(
+    controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_DOUBLE_EQ(controller_->odometry_.get_x(), 1.0);
+  EXPECT_DOUBLE_EQ(controller_->odometry_.get_y(), -2.0);
+  EXPECT_NEAR(controller_->odometry_.get_heading(), 0.5, 1e-12);
+
+  // a pose in another frame is ignored
+  controller_->set_odometry_pose(pose_msg(3.0, 3.0, 0.0, "map"));
+  ASSERT_EQ(
+    controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_DOUBLE_EQ(controller_->odometry_.get_x(), 1.0);
+
+  // the latest request replaces the one which was not applied yet
+  controller_->set_odometry_pose(pose_msg(2.0, 2.0, 1.0, "odom"));
+  controller_->reset_odometry(nullptr, nullptr, nullptr);
+  ASSERT_EQ(
+    controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(controller_->odometry_.get_x(), 0.0);
+  EXPECT_EQ(controller_->odometry_.get_y(), 0.0);
+  EXPECT_EQ(controller_->odometry_.get_heading(), 0.0);
+
+  // a request which was not applied before the deactivation is discarded
+  controller_->set_odometry_pose(pose_msg(2.0, 2.0, 1.0, "odom"));
+  ASSERT_EQ(controller_->on_deactivate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  ASSERT_EQ(
+    controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(controller_->odometry_.get_x(), 0.0);
+}
+
+TEST_F(SteeringControllersLibraryTest, inverse_kinematics_cache_skips_steady_reference)
+{
+  SetUpController();
+  controller_->get_node()->set_parameter(
+    rclcpp::Parameter("inverse_kinematics_cache.enable", true));
+
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), NODE_SUCCESS);
+  controller_->set_chained_mode(true);
+  ASSERT_EQ(controller_->on_activate(rclcpp_lifecycle::State()), NODE_SUCCESS);
+
+  // imitate a preceding controller setting the same reference in each cycle
+  auto update = [this]()
+  {
+    controller_->reference_interfaces_[0] = 1.5;
+    controller_->reference_interfaces_[1] = 0.3;
+    ASSERT_EQ(
+      controller_->update(controller_->get_node()->now(), rclcpp::Duration::from_seconds(0.01)),
+      controller_interface::return_type::OK);
+  };
+
+  update();
+  const auto computed_commands = joint_command_values_;
+  for (int i = 0; i < 5; ++i)
+  {
+    update();
+    for (size_t j = 0; j < computed_commands.size(); ++j)
+    {
+      EXPECT_EQ(joint_command_values_[j], computed_commands[j]);
+    }
+  }
+  EXPECT_EQ(controller_->ik_cache_.hits(), 5u);
+  EXPECT_EQ(controller_->ik_cache_.lookups(), 6u);
+
+  // the traction commands depend on the measured steering angle in closed loop
+  ASSERT_TRUE(controller_->odometry_.update_from_velocity(0.0, 0.0, 0.1, 0.01));
+  update();
+  EXPECT_EQ(controller_->ik_cache_.hits(), 5u);
+  EXPECT_NE(
+    joint_command_values_[CMD_TRACTION_RIGHT_WHEEL], computed_commands[CMD_TRACTION_RIGHT_WHEEL]);
+}
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
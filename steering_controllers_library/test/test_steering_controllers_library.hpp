@@ -71,6 +71,8 @@ class TestableSteeringControllersLibrary
 {
   FRIEND_TEST(SteeringControllersLibraryTest, check_exported_interfaces);
   FRIEND_TEST(SteeringControllersLibraryTest, test_both_update_methods_for_ref_timeout);
+  FRIEND_TEST(SteeringControllersLibraryTest, odometry_reset_is_applied_by_the_next_update);
+  FRIEND_TEST(SteeringControllersLibraryTest, inverse_kinematics_cache_skips_steady_reference);
 
 public:
   controller_interface::CallbackReturn on_configure(
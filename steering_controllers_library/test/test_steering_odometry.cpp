@@ -378,3 +378,128 @@ TEST(TestSteeringOdometry, tricycle_odometry)
   EXPECT_NEAR(odom.get_x(), .1, 1e-3);
   EXPECT_NEAR(odom.get_heading(), .01, 1e-3);
 }
+
+// ----------------- Reset -----------------
+
+TEST(TestSteeringOdometry, reset_odometry_clears_velocity_mean)
+{
+  steering_odometry::SteeringOdometry odom(2);
+  odom.set_wheel_params(1., 1., 1.);
+  odom.set_odometry_type(steering_odometry::BICYCLE_CONFIG);
+  ASSERT_TRUE(odom.update_from_velocity(1., 0., .1));
+  ASSERT_TRUE(odom.update_from_velocity(3., 0., .1));
+  EXPECT_DOUBLE_EQ(odom.get_linear(), 2.);
+
+  odom.reset_odometry();
+  EXPECT_DOUBLE_EQ(odom.get_x(), 0.);
+  // the previous velocities do not contribute to the mean anymore
+  ASSERT_TRUE(odom.update_from_velocity(5., 0., .1));
+  EXPECT_DOUBLE_EQ(odom.get_linear(), 5.);
+}
+
+TEST(TestSteeringOdometry, set_pose)
+{
+  steering_odometry::SteeringOdometry odom(1);
+  odom.set_wheel_params(1., 1., 1.);
+  odom.set_odometry_type(steering_odometry::BICYCLE_CONFIG);
+  odom.set_pose(1., -2., M_PI_2);
+  EXPECT_DOUBLE_EQ(odom.get_x(), 1.);
+  EXPECT_DOUBLE_EQ(odom.get_y(), -2.);
+  EXPECT_DOUBLE_EQ(odom.get_heading(), M_PI_2);
+
+  // the odometry is integrated from the set pose
+  odom.update_open_loop(2., 0., 0.5);
+  EXPECT_NEAR(odom.get_x(), 1., 1e-12);
+  EXPECT_DOUBLE_EQ(odom.get_y(), -1.);
+}
+
+TEST(TestSteeringOdometry, pose_covariance_propagation)
+{
+  const double traction_wheel_variance_rate = 1e-3;
+  const double steering_angle_variance_rate = 1e-4;
+  steering_odometry::SteeringOdometry odom(1);
+  odom.set_wheel_params(.5, 2.);
+  odom.set_odometry_type(steering_odometry::BICYCLE_CONFIG);
+  odom.set_pose_covariance_propagation(
+    true, traction_wheel_variance_rate, steering_angle_variance_rate);
+
+  // drive straight ahead, .1 m per update
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(odom.update_from_velocity(2., 0., .1));
+  }
+  const auto & covariance = odom.get_pose_covariance();
+  // the traction error is along the path, the steering error turns the heading
+  EXPECT_NEAR(covariance[0], 10 * traction_wheel_variance_rate * .1, 1e-12);
+  EXPECT_NEAR(covariance[8], 10 * .1 * steering_angle_variance_rate / (2. * 2.), 1e-12);
+  EXPECT_GT(covariance[4], 0.);
+  EXPECT_NEAR(covariance[1], 0., 1e-12);
+  EXPECT_NEAR(covariance[2], 0., 1e-12);
+
+  // while turning, the traction error also turns the heading
+  const double heading_variance = covariance[8];
+  ASSERT_TRUE(odom.update_from_velocity(2., .3, .1));
+  EXPECT_GT(covariance[8] - heading_variance, .1 * steering_angle_variance_rate / (2. * 2.));
+  for (size_t row = 0; row < 3; ++row)
+  {
+    for (size_t col = 0; col < 3; ++col)
+    {
+      EXPECT_EQ(covariance[3 * row + col], covariance[3 * col + row]);
+    }
+  }
+
+  // the open loop has no wheel measurement to propagate
+  const auto propagated = covariance;
+  odom.update_open_loop(1., .5, .1);
+  EXPECT_EQ(odom.get_pose_covariance(), propagated);
+
+  odom.reset_odometry();
+  EXPECT_THAT(odom.get_pose_covariance(), ::testing::Each(0.));
+}
+
+TEST(TestSteeringOdometry, pose_covariance_does_not_depend_on_update_rate)
+{
+  const auto drive = [](const int steps)
+  {
+    steering_odometry::SteeringOdometry odom(1);
+    odom.set_wheel_params(.5, 2.);
+    odom.set_odometry_type(steering_odometry::BICYCLE_CONFIG);
+    odom.set_pose_covariance_propagation(true, 1e-3, 1e-4);
+    // the same 1 m path along a constant arc, split into a different number of updates
+    for (int i = 0; i < steps; ++i)
+    {
+      EXPECT_TRUE(odom.update_from_velocity(2., .3, 1. / steps));
+    }
+    return odom.get_pose_covariance();
+  };
+
+  // only the linearization differs between 10 and 100 updates along the path
+  const auto slow = drive(10);
+  const auto fast = drive(100);
+  for (size_t i = 0; i < slow.size(); ++i)
+  {
+    EXPECT_NEAR(fast[i], slow[i], 1e-3 * std::abs(fast[i])) << "at index " << i;
+  }
+}
+
+TEST(TestSteeringOdometry, set_pose_replaces_the_pose_covariance)
+{
+  steering_odometry::SteeringOdometry odom(1);
+  odom.set_wheel_params(.5, 2.);
+  odom.set_odometry_type(steering_odometry::BICYCLE_CONFIG);
+  odom.set_pose_covariance_propagation(true, 1e-3, 1e-4);
+  ASSERT_TRUE(odom.update_from_velocity(2., .3, .1));
+
+  const std::array<double, 9> pose_covariance{{.1, .01, 0., .01, .2, 0., 0., 0., .05}};
+  odom.set_pose(1., -2., .5, pose_covariance);
+  EXPECT_EQ(odom.get_pose_covariance(), pose_covariance);
+
+  // the covariance is propagated from the set one
+  ASSERT_TRUE(odom.update_from_velocity(2., .3, .1));
+  EXPECT_GT(odom.get_pose_covariance()[0], pose_covariance[0]);
+  EXPECT_GT(odom.get_pose_covariance()[8], pose_covariance[8]);
+
+  // a pose without covariance resets it
+  odom.set_pose(0., 0., 0.);
+  EXPECT_THAT(odom.get_pose_covariance(), ::testing::Each(0.));
+}
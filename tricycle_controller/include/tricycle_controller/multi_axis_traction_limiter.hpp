@@ -0,0 +1,86 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRICYCLE_CONTROLLER__MULTI_AXIS_TRACTION_LIMITER_HPP_
+#define TRICYCLE_CONTROLLER__MULTI_AXIS_TRACTION_LIMITER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tricycle_controller/traction_limiter.hpp"
+
+namespace tricycle_controller
+{
+/**
+ * \brief Limits the velocity, acceleration and jerk of N axes at once
+ *
+ * Gives the same results as a TractionLimiter per axis. The limits are stored per kind over all
+ * axes, and the NaN checks of the scalar limiter are replaced by enable masks computed on
+ * construction: every limit is evaluated for every axis and its result is selected by the mask, so
+ * the per axis loops have no branches and can be vectorized by the compiler.
+ */
+class MultiAxisTractionLimiter
+{
+public:
+  MultiAxisTractionLimiter() = default;
+
+  /**
+   * \brief Constructor
+   * \param [in] limiters Limiter of each axis, whose limits are validated by their constructor
+   */
+  explicit MultiAxisTractionLimiter(const std::vector<TractionLimiter> & limiters);
+
+  /// Number of axes
+  size_t size() const { return min_velocity_.size(); }
+
+  /**
+   * \brief Limit the jerk, acceleration and velocity of all axes, as TractionLimiter::limit
+   *
+   * All vectors have one element per axis and must be distinct, no allocation takes place.
+   *
+   * \param [in, out] v  Velocities [m/s] or [rad/s]
+   * \param [in]      v0 Previous velocities to v  [m/s] or [rad/s]
+   * \param [in]      v1 Previous velocities to v0 [m/s] or [rad/s]
+   * \param [in]      dt Time step [s]
+   * \param [out]     limiting_factors Limiting factor of each axis (1.0 if none)
+   */
+  void limit(
+    std::vector<double> & v, const std::vector<double> & v0, const std::vector<double> & v1,
+    double dt, std::vector<double> & limiting_factors) const;
+
+  /// \copydoc limit
+  void limit(
+    double * v, const double * v0, const double * v1, double dt, double * limiting_factors) const;
+
+private:
+  // Limits of each axis, the bounds 0.0 and infinity where a limit is NaN
+  std::vector<double> min_velocity_;
+  std::vector<double> max_velocity_;
+  std::vector<double> min_acceleration_;
+  std::vector<double> max_acceleration_;
+  std::vector<double> min_deceleration_;
+  std::vector<double> max_deceleration_;
+  std::vector<double> min_jerk_;
+  std::vector<double> max_jerk_;
+
+  // all bits set where the limit is enabled, none otherwise
+  std::vector<uint64_t> velocity_mask_;
+  std::vector<uint64_t> acceleration_mask_;
+  std::vector<uint64_t> jerk_mask_;
+};
+
+}  // namespace tricycle_controller
+
+#endif  // TRICYCLE_CONTROLLER__MULTI_AXIS_TRACTION_LIMITER_HPP_
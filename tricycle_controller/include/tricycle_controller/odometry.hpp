@@ -19,6 +19,7 @@
 #ifndef TRICYCLE_CONTROLLER__ODOMETRY_HPP_
 #define TRICYCLE_CONTROLLER__ODOMETRY_HPP_
 
+#include <array>
 #include <cmath>
 
 #include <rclcpp/duration.hpp>
@@ -39,15 +40,22 @@ public:
   bool update(double left_vel, double right_vel, const rclcpp::Duration & dt);
   void updateOpenLoop(double linear, double angular, const rclcpp::Duration & dt);
   void resetOdometry();
+  // The covariance of x, y and heading is row-major, the default resets it
+  void setPose(
+    double x, double y, double heading, const std::array<double, 9> & pose_covariance = {});
 
   double getX() const { return x_; }
   double getY() const { return y_; }
   double getHeading() const { return heading_; }
   double getLinear() const { return linear_; }
   double getAngular() const { return angular_; }
+  // Row-major covariance of x, y and heading
+  const std::array<double, 9> & getPoseCovariance() const { return pose_covariance_; }
 
   void setWheelParams(double wheel_separation, double wheel_radius);
   void setVelocityRollingWindowSize(size_t velocity_rolling_window_size);
+  void setPoseCovariancePropagation(
+    bool enable, double traction_wheel_variance_rate, double steering_angle_variance_rate);
 
 private:
 // \note The versions conditioning is added here to support the source-compatibility with Humble
@@ -59,6 +67,7 @@ private:
 
   void integrateRungeKutta2(double linear, double angular);
   void integrateExact(double linear, double angular);
+  void propagatePoseCovariance(double traction_displacement, double alpha);
   void resetAccumulators();
 
   // Current pose:
@@ -70,6 +79,12 @@ private:
   double linear_;   //   [m/s]
   double angular_;  // [rad/s]
 
+  // Covariance of the pose, propagated by the wheel noise model:
+  bool propagate_pose_covariance_;
+  double traction_wheel_variance_rate_;  // [m^2/m]
+  double steering_angle_variance_rate_;  // [rad^2 m]
+  std::array<double, 9> pose_covariance_;
+
   // Wheel kinematic parameters [m]:
   double wheelbase_;
   double wheel_radius_;
@@ -78,6 +93,8 @@ private:
   size_t velocity_rolling_window_size_;
   RollingMeanAccumulator linear_accumulator_;
   RollingMeanAccumulator angular_accumulator_;
+  // Cleared accumulator of the window size, copied to reset the accumulators without allocation
+  RollingMeanAccumulator empty_accumulator_;
 };
 
 }  // namespace tricycle_controller
@@ -49,6 +49,15 @@ public:
    */
   double limit(double & p, double p0, double p1, double dt);
 
+  /**
+   * \brief Whether a constant position within the position limits passes unchanged for any time
+   * step, i.e., no minimum velocity or acceleration is set
+   */
+  bool holds_constant_position() const
+  {
+    return !(min_velocity_ > 0.0) && !(min_acceleration_ > 0.0);
+  }
+
   /**
    * \brief Limit the jerk
    * \param [in, out] p  position [m] or [rad]
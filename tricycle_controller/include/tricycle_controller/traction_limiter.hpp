@@ -63,6 +63,15 @@ public:
    */
   double limit(double & v, double v0, double v1, double dt);
 
+  /**
+   * \brief Whether a constant velocity within the velocity limits passes unchanged for any time
+   * step, i.e., no minimum acceleration, deceleration or jerk is set
+   */
+  bool holds_constant_velocity() const
+  {
+    return !(min_acceleration_ > 0.0) && !(min_deceleration_ > 0.0) && !(min_jerk_ > 0.0);
+  }
+
   /**
    * \brief Limit the velocity
    * \param [in, out] v Velocity [m/s] or [rad/s]
@@ -91,6 +100,9 @@ public:
   double limit_jerk(double & v, double v0, double v1, double dt);
 
 private:
+  // reads the limits completed by the constructor
+  friend class MultiAxisTractionLimiter;
+
   // Velocity limits:
   double min_velocity_;
   double max_velocity_;
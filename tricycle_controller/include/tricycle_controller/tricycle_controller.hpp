@@ -19,21 +19,27 @@
 #ifndef TRICYCLE_CONTROLLER__TRICYCLE_CONTROLLER_HPP_
 #define TRICYCLE_CONTROLLER__TRICYCLE_CONTROLLER_HPP_
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <memory>
-#include <queue>
 #include <string>
 #include <tuple>
 #include <vector>
 
 #include "ackermann_msgs/msg/ackermann_drive.hpp"
-#include "controller_interface/controller_interface.hpp"
+#include "controller_interface/chainable_controller_interface.hpp"
+#include "geometry_msgs/msg/pose_with_covariance_stamped.hpp"
 #include "geometry_msgs/msg/twist.hpp"
 #include "geometry_msgs/msg/twist_stamped.hpp"
+#include "mobile_base_controllers_common/inverse_kinematics_cache.hpp"
+#include "mobile_base_controllers_common/inverse_kinematics_cache_diagnostics.hpp"
+#include "mobile_base_controllers_common/latest_value_slot.hpp"
+#include "mobile_base_controllers_common/odometry_reset_request.hpp"
 #include "nav_msgs/msg/odometry.hpp"
 #include "rclcpp_lifecycle/state.hpp"
-#include "realtime_tools/realtime_box.hpp"
 #include "realtime_tools/realtime_publisher.hpp"
 #include "std_srvs/srv/empty.hpp"
 #include "tf2_msgs/msg/tf_message.hpp"
@@ -48,11 +54,12 @@ namespace tricycle_controller
 {
 using CallbackReturn = rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn;
 
-class TricycleController : public controller_interface::ControllerInterface
+class TricycleController : public controller_interface::ChainableControllerInterface
 {
   using Twist = geometry_msgs::msg::Twist;
   using TwistStamped = geometry_msgs::msg::TwistStamped;
   using AckermannDrive = ackermann_msgs::msg::AckermannDrive;
+  using PoseWithCovarianceStamped = geometry_msgs::msg::PoseWithCovarianceStamped;
 
 public:
   TricycleController();
@@ -61,7 +68,11 @@ public:
 
   controller_interface::InterfaceConfiguration state_interface_configuration() const override;
 
-  controller_interface::return_type update(
+  // Chainable controller replaces update() with the following two functions
+  controller_interface::return_type update_reference_from_subscribers(
+    const rclcpp::Time & time, const rclcpp::Duration & period) override;
+
+  controller_interface::return_type update_and_write_commands(
     const rclcpp::Time & time, const rclcpp::Duration & period) override;
 
   CallbackReturn on_init() override;
@@ -77,6 +88,12 @@ public:
   CallbackReturn on_error(const rclcpp_lifecycle::State & previous_state) override;
 
 protected:
+  bool on_set_chained_mode(bool chained_mode) override;
+
+  std::vector<hardware_interface::CommandInterface> on_export_reference_interfaces() override;
+
+  std::vector<hardware_interface::StateInterface> on_export_state_interfaces() override;
+
   struct TractionHandle
   {
     std::reference_wrapper<const hardware_interface::LoanedStateInterface> velocity_state;
@@ -121,25 +138,58 @@ protected:
   // Timeout to consider cmd_vel commands old
   std::chrono::milliseconds cmd_vel_timeout_{500};
 
-  bool subscriber_is_active_ = false;
+  std::atomic<bool> subscriber_is_active_{false};
   rclcpp::Subscription<TwistStamped>::SharedPtr velocity_command_subscriber_ = nullptr;
 
-  realtime_tools::RealtimeBox<std::shared_ptr<TwistStamped>> received_velocity_msg_ptr_{nullptr};
-  std::shared_ptr<TwistStamped> last_command_msg_;
+  // The used part of the last received cmd_vel, passed to update() without locks or allocation
+  struct VelocityCommand
+  {
+    double linear = 0.0;   // [m/s]
+    double angular = 0.0;  // [rad/s]
+    int64_t stamp_nanoseconds = 0;
+  };
+  mobile_base_controllers_common::LatestValueSlot<VelocityCommand> received_velocity_command_;
 
   rclcpp::Service<std_srvs::srv::Empty>::SharedPtr reset_odom_service_;
+  rclcpp::Subscription<PoseWithCovarianceStamped>::SharedPtr set_odometry_pose_subscriber_ =
+    nullptr;
+
+  // Odometry reset requested by the service or the set pose subscriber, applied by the next update
+  using OdometryResetRequest = mobile_base_controllers_common::OdometryResetRequest;
+  mobile_base_controllers_common::OdometryResetSlot odometry_reset_slot_;
 
-  std::queue<AckermannDrive> previous_commands_;  // last two commands
+  // Wheel speed and steering angle after limiting, kept in double precision for the limiters
+  struct LimitedCommand
+  {
+    double speed = 0.0;           // [rad/s]
+    double steering_angle = 0.0;  // [rad]
+  };
+  // last two commands, previous_commands_[last_command_index_] is the last one
+  std::array<LimitedCommand, 2> previous_commands_;
+  size_t last_command_index_ = 0;
 
   // speed limiters
   TractionLimiter limiter_traction_;
   SteeringLimiter limiter_steering_;
+  // true if a constant command within the limits passes both limiters unchanged
+  bool limiters_hold_constant_command_ = true;
+
+  // Limited command of the last steady wheel speed and steering angle, keyed on the reference and
+  // the measured steering angle it was computed from
+  using SteadyCommandCache =
+    mobile_base_controllers_common::InverseKinematicsCache<3, LimitedCommand>;
+  SteadyCommandCache ik_cache_;
+  mobile_base_controllers_common::InverseKinematicsCacheDiagnostics ik_cache_diagnostics_;
 
   void reset_odometry(
     const std::shared_ptr<rmw_request_id_t> request_header,
     const std::shared_ptr<std_srvs::srv::Empty::Request> req,
     std::shared_ptr<std_srvs::srv::Empty::Response> res);
+  void set_odometry_pose(const std::shared_ptr<PoseWithCovarianceStamped> msg);
+  void apply_odometry_reset_request();
   bool reset();
+  // Set the reference interfaces and the exported odometry to NaN, i.e. not set
+  void reset_interfaces();
   void halt();
 };
 }  // namespace tricycle_controller
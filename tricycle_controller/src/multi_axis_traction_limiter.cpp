@@ -0,0 +1,146 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "tricycle_controller/multi_axis_traction_limiter.hpp"
+
+namespace tricycle_controller
+{
+namespace
+{
+// A NaN bound makes std::clamp a no-op, as do these bounds for absolute values
+double lower_bound(double limit) { return std::isnan(limit) ? 0.0 : limit; }
+double upper_bound(double limit)
+{
+  return std::isnan(limit) ? std::numeric_limits<double>::infinity() : limit;
+}
+
+// All bits set if the condition holds, none otherwise
+inline uint64_t mask_of(bool condition)
+{
+  return static_cast<uint64_t>(-static_cast<int64_t>(condition));
+}
+
+uint64_t enable_mask(double min_limit, double max_limit)
+{
+  return mask_of(!std::isnan(min_limit) && !std::isnan(max_limit));
+}
+
+// a where the mask is set, b otherwise. Unlike a conditional expression, the compiler cannot
+// move the computation of a or b under a branch.
+inline double blend(uint64_t mask, double a, double b)
+{
+  uint64_t a_bits;
+  uint64_t b_bits;
+  std::memcpy(&a_bits, &a, sizeof(double));
+  std::memcpy(&b_bits, &b, sizeof(double));
+  const uint64_t result_bits = (a_bits & mask) | (b_bits & ~mask);
+  double result;
+  std::memcpy(&result, &result_bits, sizeof(double));
+  return result;
+}
+
+// std::clamp with both comparisons always evaluated, so that the compiler can turn it into
+// min/max instructions
+inline double clamp(double value, double low, double high)
+{
+  const double raised = value < low ? low : value;
+  return high < raised ? high : raised;
+}
+}  // namespace
+
+MultiAxisTractionLimiter::MultiAxisTractionLimiter(const std::vector<TractionLimiter> & limiters)
+{
+  for (const auto & limiter : limiters)
+  {
+    min_velocity_.push_back(lower_bound(limiter.min_velocity_));
+    max_velocity_.push_back(upper_bound(limiter.max_velocity_));
+    min_acceleration_.push_back(lower_bound(limiter.min_acceleration_));
+    max_acceleration_.push_back(upper_bound(limiter.max_acceleration_));
+    min_deceleration_.push_back(lower_bound(limiter.min_deceleration_));
+    max_deceleration_.push_back(upper_bound(limiter.max_deceleration_));
+    min_jerk_.push_back(lower_bound(limiter.min_jerk_));
+    max_jerk_.push_back(upper_bound(limiter.max_jerk_));
+
+    velocity_mask_.push_back(enable_mask(limiter.min_velocity_, limiter.max_velocity_));
+    acceleration_mask_.push_back(
+      enable_mask(limiter.min_acceleration_, limiter.max_acceleration_));
+    jerk_mask_.push_back(enable_mask(limiter.min_jerk_, limiter.max_jerk_));
+  }
+}
+
+void MultiAxisTractionLimiter::limit(
+  std::vector<double> & v, const std::vector<double> & v0, const std::vector<double> & v1,
+  double dt, std::vector<double> & limiting_factors) const
+{
+  limit(v.data(), v0.data(), v1.data(), dt, limiting_factors.data());
+}
+
+// The buffers are declared not to overlap, otherwise the compiler would only vectorize the loop
+// after runtime overlap checks of all the arrays
+void MultiAxisTractionLimiter::limit(
+  double * __restrict v, const double * __restrict v0, const double * __restrict v1, double dt,
+  double * __restrict limiting_factors) const
+{
+  const size_t n = size();
+  const double dt2 = 2. * dt * dt;
+
+  // the same operations as TractionLimiter::limit, with each step applied where enabled
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double tmp = v[i];
+    double result = tmp;
+
+    // jerk
+    {
+      const double dv = result - v0[i];
+      const double dv0 = v0[i] - v1[i];
+      const double da_abs = clamp(std::fabs(dv - dv0), min_jerk_[i] * dt2, max_jerk_[i] * dt2);
+      const double da = dv - dv0 >= 0 ? da_abs : -da_abs;
+      const double limited = v0[i] + dv0 + da;
+      result = blend(jerk_mask_[i], limited, result);
+    }
+
+    // acceleration
+    {
+      const uint64_t accelerating = mask_of(std::fabs(result) >= std::fabs(v0[i]));
+      const double dv_min =
+        blend(accelerating, min_acceleration_[i] * dt, min_deceleration_[i] * dt);
+      const double dv_max =
+        blend(accelerating, max_acceleration_[i] * dt, max_deceleration_[i] * dt);
+      const double dv_abs = clamp(std::fabs(result - v0[i]), dv_min, dv_max);
+      const double dv = result - v0[i] >= 0 ? dv_abs : -dv_abs;
+      const double limited = v0[i] + dv;
+      result = blend(acceleration_mask_[i], limited, result);
+    }
+
+    // velocity
+    {
+      const double limited_abs = clamp(std::fabs(result), min_velocity_[i], max_velocity_[i]);
+      const double limited = result >= 0 ? limited_abs : -limited_abs;
+      result = blend(velocity_mask_[i], limited, result);
+    }
+
+    v[i] = result;
+    // the division is done for all axes, avoiding the division by zero
+    const uint64_t nonzero = mask_of(tmp != 0.0);
+    limiting_factors[i] = blend(nonzero, result / blend(nonzero, tmp, 1.0), 1.0);
+  }
+}
+
+}  // namespace tricycle_controller
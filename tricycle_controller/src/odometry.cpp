@@ -17,6 +17,7 @@
  */
 
 #include "tricycle_controller/odometry.hpp"
+#include "mobile_base_controllers_common/pose_covariance_propagation.hpp"
 
 namespace tricycle_controller
 {
@@ -26,11 +27,16 @@ Odometry::Odometry(size_t velocity_rolling_window_size)
   heading_(0.0),
   linear_(0.0),
   angular_(0.0),
+  propagate_pose_covariance_(false),
+  traction_wheel_variance_rate_(0.0),
+  steering_angle_variance_rate_(0.0),
+  pose_covariance_{},
   wheelbase_(0.0),
   wheel_radius_(0.0),
   velocity_rolling_window_size_(velocity_rolling_window_size),
   linear_accumulator_(velocity_rolling_window_size),
-  angular_accumulator_(velocity_rolling_window_size)
+  angular_accumulator_(velocity_rolling_window_size),
+  empty_accumulator_(velocity_rolling_window_size)
 {
 }
 
@@ -41,6 +47,11 @@ bool Odometry::update(double Ws, double alpha, const rclcpp::Duration & dt)
   double Vx = Vs * std::cos(alpha);
   double theta_dot = Vs * std::sin(alpha) / wheelbase_;
 
+  if (propagate_pose_covariance_)
+  {
+    propagatePoseCovariance(Vs * dt.seconds(), alpha);
+  }
+
   // Integrate odometry:
   integrateExact(Vx * dt.seconds(), theta_dot * dt.seconds());
 
@@ -69,9 +80,19 @@ void Odometry::resetOdometry()
   x_ = 0.0;
   y_ = 0.0;
   heading_ = 0.0;
+  pose_covariance_.fill(0.0);
   resetAccumulators();
 }
 
+void Odometry::setPose(
+  double x, double y, double heading, const std::array<double, 9> & pose_covariance)
+{
+  x_ = x;
+  y_ = y;
+  heading_ = heading;
+  pose_covariance_ = pose_covariance;
+}
+
 void Odometry::setWheelParams(double wheelbase, double wheel_radius)
 {
   wheelbase_ = wheelbase;
@@ -81,10 +102,19 @@ void Odometry::setWheelParams(double wheelbase, double wheel_radius)
 void Odometry::setVelocityRollingWindowSize(size_t velocity_rolling_window_size)
 {
   velocity_rolling_window_size_ = velocity_rolling_window_size;
+  empty_accumulator_ = RollingMeanAccumulator(velocity_rolling_window_size_);
 
   resetAccumulators();
 }
 
+void Odometry::setPoseCovariancePropagation(
+  bool enable, double traction_wheel_variance_rate, double steering_angle_variance_rate)
+{
+  propagate_pose_covariance_ = enable;
+  traction_wheel_variance_rate_ = traction_wheel_variance_rate;
+  steering_angle_variance_rate_ = steering_angle_variance_rate;
+}
+
 void Odometry::integrateRungeKutta2(double linear, double angular)
 {
   const double direction = heading_ + angular * 0.5;
@@ -112,10 +142,38 @@ void Odometry::integrateExact(double linear, double angular)
   }
 }
 
+void Odometry::propagatePoseCovariance(double traction_displacement, double alpha)
+{
+  // The displacement error of the traction wheel along and, through the steering angle error,
+  // across its rolling direction grow with the distance it travels, so that the result does not
+  // depend on the update rate. Mapped to the linear and angular displacement of the base,
+  // d*cos(alpha) and d*sin(alpha)/wheelbase, their covariance is:
+  const double distance = std::abs(traction_displacement);
+  const double traction_variance = traction_wheel_variance_rate_ * distance;
+  const double steering_variance = steering_angle_variance_rate_ * distance;
+  const double cos_alpha = std::cos(alpha);
+  const double sin_alpha = std::sin(alpha);
+  const double linear_variance =
+    cos_alpha * cos_alpha * traction_variance + sin_alpha * sin_alpha * steering_variance;
+  const double linear_angular_covariance =
+    cos_alpha * sin_alpha * (traction_variance - steering_variance) / wheelbase_;
+  const double angular_variance =
+    (sin_alpha * sin_alpha * traction_variance + cos_alpha * cos_alpha * steering_variance) /
+    (wheelbase_ * wheelbase_);
+
+  const double linear = traction_displacement * cos_alpha;
+  const double angular = traction_displacement * sin_alpha / wheelbase_;
+
+  mobile_base_controllers_common::propagate_planar_pose_covariance(
+    pose_covariance_, heading_, linear, angular, linear_variance, linear_angular_covariance,
+    angular_variance);
+}
+
 void Odometry::resetAccumulators()
 {
-  linear_accumulator_ = RollingMeanAccumulator(velocity_rolling_window_size_);
-  angular_accumulator_ = RollingMeanAccumulator(velocity_rolling_window_size_);
+  // copy assignment reuses the buffers of the same window size, so this does not allocate
+  linear_accumulator_ = empty_accumulator_;
+  angular_accumulator_ = empty_accumulator_;
 }
 
 }  // namespace tricycle_controller
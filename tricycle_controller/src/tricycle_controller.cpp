@@ -18,15 +18,20 @@
 
 #define _USE_MATH_DEFINES
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
 #include <memory>
-#include <queue>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
 #include "lifecycle_msgs/msg/state.hpp"
 #include "rclcpp/logging.hpp"
+#include "tf2/LinearMath/Matrix3x3.hpp"
 #include "tf2/LinearMath/Quaternion.hpp"
 #include "tricycle_controller/tricycle_controller.hpp"
 
@@ -37,6 +42,7 @@ constexpr auto DEFAULT_ACKERMANN_OUT_TOPIC = "~/cmd_ackermann";
 constexpr auto DEFAULT_ODOMETRY_TOPIC = "~/odom";
 constexpr auto DEFAULT_TRANSFORM_TOPIC = "/tf";
 constexpr auto DEFAULT_RESET_ODOM_SERVICE = "~/reset_odometry";
+constexpr auto DEFAULT_SET_ODOM_POSE_TOPIC = "~/set_odometry_pose";
 }  // namespace
 
 namespace tricycle_controller
@@ -48,7 +54,7 @@ using hardware_interface::HW_IF_POSITION;
 using hardware_interface::HW_IF_VELOCITY;
 using lifecycle_msgs::msg::State;
 
-TricycleController::TricycleController() : controller_interface::ControllerInterface() {}
+TricycleController::TricycleController() : controller_interface::ChainableControllerInterface() {}
 
 CallbackReturn TricycleController::on_init()
 {
@@ -85,31 +91,53 @@ InterfaceConfiguration TricycleController::state_interface_configuration() const
   return state_interfaces_config;
 }
 
-controller_interface::return_type TricycleController::update(
-  const rclcpp::Time & time, const rclcpp::Duration & period)
+controller_interface::return_type TricycleController::update_reference_from_subscribers(
+  const rclcpp::Time & time, const rclcpp::Duration & /*period*/)
 {
-  // if the mutex is unable to lock, last_command_msg_ won't be updated
-  received_velocity_msg_ptr_.try_get([this](const std::shared_ptr<TwistStamped> & msg)
-                                     { last_command_msg_ = msg; });
-  if (last_command_msg_ == nullptr)
-  {
-    RCLCPP_WARN(get_node()->get_logger(), "Velocity message received was a nullptr.");
-    return controller_interface::return_type::ERROR;
-  }
+  // a local copy, the stored command is only written by the subscriber
+  VelocityCommand command;
+  received_velocity_command_.read(command);
 
-  const auto age_of_last_command = time - last_command_msg_->header.stamp;
-  // Brake if cmd_vel has timeout, override the stored command
+  const auto age_of_last_command =
+    std::chrono::nanoseconds(time.nanoseconds() - command.stamp_nanoseconds);
+  // Brake if cmd_vel has timeout
   if (age_of_last_command > cmd_vel_timeout_)
   {
-    last_command_msg_->twist.linear.x = 0.0;
-    last_command_msg_->twist.angular.z = 0.0;
+    reference_interfaces_[0] = 0.0;
+    reference_interfaces_[1] = 0.0;
+  }
+  else if (std::isfinite(command.linear) && std::isfinite(command.angular))
+  {
+    reference_interfaces_[0] = command.linear;
+    reference_interfaces_[1] = command.angular;
   }
+  else
+  {
+    RCLCPP_WARN_SKIPFIRST_THROTTLE(
+      get_node()->get_logger(), *get_node()->get_clock(),
+      static_cast<double>(cmd_vel_timeout_.count()),
+      "Command message contains NaNs. Not updating reference interfaces.");
+  }
+
+  return controller_interface::return_type::OK;
+}
+
+controller_interface::return_type TricycleController::update_and_write_commands(
+  const rclcpp::Time & time, const rclcpp::Duration & period)
+{
+  apply_odometry_reset_request();
 
   // command may be limited further by Limiters,
-  // without affecting the stored twist command
-  TwistStamped command = *last_command_msg_;
-  double & linear_command = command.twist.linear.x;
-  double & angular_command = command.twist.angular.z;
+  // without affecting the reference interfaces
+  double linear_command = reference_interfaces_[0];
+  double angular_command = reference_interfaces_[1];
+
+  if (!std::isfinite(linear_command) || !std::isfinite(angular_command))
+  {
+    // NaNs occur on initialization when the reference interfaces are not yet set
+    return controller_interface::return_type::OK;
+  }
+
   double Ws_read = traction_joint_[0].velocity_state.get().get_value();     // in radians/s
   double alpha_read = steering_joint_[0].position_state.get().get_value();  // in radians
 
@@ -142,6 +170,11 @@ controller_interface::return_type TricycleController::update(
       odometry_message.pose.pose.orientation.y = orientation.y();
       odometry_message.pose.pose.orientation.z = orientation.z();
       odometry_message.pose.pose.orientation.w = orientation.w();
+      if (params_.pose_covariance_propagation.enable)
+      {
+        mobile_base_controllers_common::set_planar_pose_covariance(
+          odometry_.getPoseCovariance(), odometry_message.pose.covariance);
+      }
     }
     odometry_message.twist.twist.linear.x = odometry_.getLinear();
     odometry_message.twist.twist.angular.z = odometry_.getAngular();
@@ -161,44 +194,69 @@ controller_interface::return_type TricycleController::update(
     realtime_odometry_transform_publisher_->unlockAndPublish();
   }
 
-  // Compute wheel velocity and angle
-  auto [alpha_write, Ws_write] = twist_to_ackermann(linear_command, angular_command);
-
-  // Reduce wheel speed until the target angle has been reached
-  double alpha_delta = abs(alpha_write - alpha_read);
-  double scale;
-  if (alpha_delta < M_PI / 6)
-  {
-    scale = 1;
-  }
-  else if (alpha_delta > M_PI_2)
+  // Compute wheel velocity and angle, unless the inputs are the same as in the last steady cycle
+  double Ws_write;
+  double alpha_write;
+  const SteadyCommandCache::Key ik_key = {{linear_command, angular_command, alpha_read}};
+  const LimitedCommand * cached_command =
+    params_.inverse_kinematics_cache.enable ? ik_cache_.lookup(ik_key) : nullptr;
+  if (cached_command)
   {
-    scale = 0.01;
+    // a fixed point of the limiters, which are skipped as their history would not change
+    Ws_write = cached_command->speed;
+    alpha_write = cached_command->steering_angle;
   }
   else
   {
-    // TODO(anyone): find the best function, e.g convex power functions
-    scale = cos(alpha_delta);
-  }
-  Ws_write *= scale;
+    std::tie(alpha_write, Ws_write) = twist_to_ackermann(linear_command, angular_command);
 
-  auto & last_command = previous_commands_.back();
-  auto & second_to_last_command = previous_commands_.front();
+    // Reduce wheel speed until the target angle has been reached
+    double alpha_delta = abs(alpha_write - alpha_read);
+    double scale;
+    if (alpha_delta < M_PI / 6)
+    {
+      scale = 1;
+    }
+    else if (alpha_delta > M_PI_2)
+    {
+      scale = 0.01;
+    }
+    else
+    {
+      // TODO(anyone): find the best function, e.g convex power functions
+      scale = cos(alpha_delta);
+    }
+    Ws_write *= scale;
 
-  limiter_traction_.limit(
-    Ws_write, last_command.speed, second_to_last_command.speed, period.seconds());
+    const LimitedCommand unlimited_command = {Ws_write, alpha_write};
+    const auto & last_command = previous_commands_[last_command_index_];
+    const auto & second_to_last_command = previous_commands_[1 - last_command_index_];
 
-  limiter_steering_.limit(
-    alpha_write, last_command.steering_angle, second_to_last_command.steering_angle,
-    period.seconds());
+    limiter_traction_.limit(
+      Ws_write, last_command.speed, second_to_last_command.speed, period.seconds());
 
-  previous_commands_.pop();
-  AckermannDrive ackermann_command;
-  // speed in AckermannDrive is defined as desired forward speed (m/s) but it is used here as wheel
-  // speed (rad/s)
-  ackermann_command.speed = static_cast<float>(Ws_write);
-  ackermann_command.steering_angle = static_cast<float>(alpha_write);
-  previous_commands_.emplace(ackermann_command);
+    limiter_steering_.limit(
+      alpha_write, last_command.steering_angle, second_to_last_command.steering_angle,
+      period.seconds());
+
+    // A command which the limiters pass unchanged after the same last command is a fixed point of
+    // limiters without minimum rate of change: they return it for any following period.
+    if (
+      params_.inverse_kinematics_cache.enable && limiters_hold_constant_command_ &&
+      Ws_write == unlimited_command.speed && alpha_write == unlimited_command.steering_angle &&
+      Ws_write == last_command.speed && alpha_write == last_command.steering_angle)
+    {
+      ik_cache_.store(ik_key, {Ws_write, alpha_write});
+    }
+    else
+    {
+      ik_cache_.invalidate();
+    }
+
+    // the second to last command is overwritten by the new last one
+    last_command_index_ = 1 - last_command_index_;
+    previous_commands_[last_command_index_] = {Ws_write, alpha_write};
+  }
 
   //  Publish ackermann command
   if (params_.publish_ackermann_command && realtime_ackermann_command_publisher_->trylock())
@@ -213,6 +271,17 @@ controller_interface::return_type TricycleController::update(
 
   traction_joint_[0].velocity_command.get().set_value(Ws_write);
   steering_joint_[0].position_command.get().set_value(alpha_write);
+
+  state_interfaces_values_[0] = odometry_.getX();
+  state_interfaces_values_[1] = odometry_.getY();
+  state_interfaces_values_[2] = odometry_.getHeading();
+  state_interfaces_values_[3] = odometry_.getLinear();
+  state_interfaces_values_[4] = odometry_.getAngular();
+
+  if (params_.inverse_kinematics_cache.enable)
+  {
+    ik_cache_diagnostics_.publish(time, ik_cache_.hits(), ik_cache_.lookups());
+  }
   return controller_interface::return_type::OK;
 }
 
@@ -229,6 +298,10 @@ CallbackReturn TricycleController::on_configure(const rclcpp_lifecycle::State &
 
   odometry_.setWheelParams(params_.wheelbase, params_.wheel_radius);
   odometry_.setVelocityRollingWindowSize(static_cast<size_t>(params_.velocity_rolling_window_size));
+  odometry_.setPoseCovariancePropagation(
+    params_.pose_covariance_propagation.enable,
+    params_.pose_covariance_propagation.traction_wheel_variance_rate,
+    params_.pose_covariance_propagation.steering_angle_variance_rate);
 
   cmd_vel_timeout_ = std::chrono::milliseconds{params_.cmd_vel_timeout};
   params_.publish_ackermann_command =
@@ -259,19 +332,23 @@ CallbackReturn TricycleController::on_configure(const rclcpp_lifecycle::State &
     RCLCPP_ERROR(get_node()->get_logger(), "Error configuring steering limiter: %s", e.what());
     return CallbackReturn::ERROR;
   }
+  limiters_hold_constant_command_ =
+    limiter_traction_.holds_constant_velocity() && limiter_steering_.holds_constant_position();
 
   if (!reset())
   {
     return CallbackReturn::ERROR;
   }
 
-  last_command_msg_ = std::make_shared<TwistStamped>();
-  received_velocity_msg_ptr_.set([this](std::shared_ptr<TwistStamped> & stored_value)
-                                 { stored_value = last_command_msg_; });
-  // Fill last two commands with default constructed commands
-  const AckermannDrive empty_ackermann_drive;
-  previous_commands_.emplace(empty_ackermann_drive);
-  previous_commands_.emplace(empty_ackermann_drive);
+  // no command yet, which times out immediately
+  received_velocity_command_.reset(VelocityCommand{});
+
+  // Allocate reference and state interfaces if needed
+  reference_interfaces_.resize(2, std::numeric_limits<double>::quiet_NaN());
+  state_interfaces_values_.resize(5, std::numeric_limits<double>::quiet_NaN());
+  // Fill last two commands with zero commands
+  previous_commands_.fill(LimitedCommand{});
+  last_command_index_ = 0;
 
   // initialize ackermann command publisher
   if (params_.publish_ackermann_command)
@@ -301,8 +378,9 @@ CallbackReturn TricycleController::on_configure(const rclcpp_lifecycle::State &
           "time, this message will only be shown once");
         msg->header.stamp = get_node()->get_clock()->now();
       }
-      received_velocity_msg_ptr_.set([msg](std::shared_ptr<TwistStamped> & stored_value)
-                                     { stored_value = std::move(msg); });
+      received_velocity_command_.write(
+        {msg->twist.linear.x, msg->twist.angular.z,
+         rclcpp::Time(msg->header.stamp).nanoseconds()});
     });
 
   // initialize odometry publisher and message
@@ -345,11 +423,20 @@ CallbackReturn TricycleController::on_configure(const rclcpp_lifecycle::State &
     odometry_transform_message.transforms.front().child_frame_id = params_.base_frame_id;
   }
 
+  // initialize the publisher of the inverse kinematics cache statistics
+  if (params_.inverse_kinematics_cache.enable)
+  {
+    ik_cache_diagnostics_.configure(get_node());
+  }
+
   // Create odom reset service
   reset_odom_service_ = get_node()->create_service<std_srvs::srv::Empty>(
     DEFAULT_RESET_ODOM_SERVICE, std::bind(
                                   &TricycleController::reset_odometry, this, std::placeholders::_1,
                                   std::placeholders::_2, std::placeholders::_3));
+  set_odometry_pose_subscriber_ = get_node()->create_subscription<PoseWithCovarianceStamped>(
+    DEFAULT_SET_ODOM_POSE_TOPIC, rclcpp::SystemDefaultsQoS(),
+    [this](const std::shared_ptr<PoseWithCovarianceStamped> msg) { set_odometry_pose(msg); });
 
   return CallbackReturn::SUCCESS;
 }
@@ -382,6 +469,8 @@ CallbackReturn TricycleController::on_deactivate(const rclcpp_lifecycle::State &
 {
   subscriber_is_active_ = false;
   halt();
+  reset_interfaces();
+  ik_cache_.invalidate();
   return CallbackReturn::SUCCESS;
 }
 
@@ -409,17 +498,58 @@ void TricycleController::reset_odometry(
   const std::shared_ptr<std_srvs::srv::Empty::Request> /*req*/,
   std::shared_ptr<std_srvs::srv::Empty::Response> /*res*/)
 {
-  odometry_.resetOdometry();
-  RCLCPP_INFO(get_node()->get_logger(), "Odometry successfully reset");
+  odometry_reset_slot_.write(OdometryResetRequest{});
+  RCLCPP_INFO(get_node()->get_logger(), "Odometry reset requested");
+}
+
+void TricycleController::set_odometry_pose(const std::shared_ptr<PoseWithCovarianceStamped> msg)
+{
+  if (!msg->header.frame_id.empty() && msg->header.frame_id != params_.odom_frame_id)
+  {
+    RCLCPP_WARN(
+      get_node()->get_logger(), "Odometry pose ignored, it is in frame '%s' instead of '%s'",
+      msg->header.frame_id.c_str(), params_.odom_frame_id.c_str());
+    return;
+  }
+
+  const auto & pose = msg->pose.pose;
+  double roll, pitch, yaw;
+  tf2::Matrix3x3(tf2::Quaternion(
+                   pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w))
+    .getRPY(roll, pitch, yaw);
+  odometry_reset_slot_.write(
+    {true, pose.position.x, pose.position.y, yaw,
+     mobile_base_controllers_common::planar_pose_covariance(msg->pose.covariance)});
+}
+
+void TricycleController::apply_odometry_reset_request()
+{
+  OdometryResetRequest request;
+  if (!odometry_reset_slot_.read(request))
+  {
+    return;
+  }
+  if (request.set_pose)
+  {
+    odometry_.setPose(request.x, request.y, request.heading, request.pose_covariance);
+  }
+  else
+  {
+    odometry_.resetOdometry();
+  }
 }
 
 bool TricycleController::reset()
 {
   odometry_.resetOdometry();
+  // discard a request which was not applied yet
+  OdometryResetRequest discarded_request;
+  odometry_reset_slot_.read(discarded_request);
 
-  // release the old queue
-  std::queue<AckermannDrive> empty_ackermann_drive;
-  std::swap(previous_commands_, empty_ackermann_drive);
+  previous_commands_.fill(LimitedCommand{});
+  last_command_index_ = 0;
+  // computed with the previous commands
+  ik_cache_.invalidate();
 
   traction_joint_.clear();
   steering_joint_.clear();
@@ -427,10 +557,21 @@ bool TricycleController::reset()
   subscriber_is_active_ = false;
   velocity_command_subscriber_.reset();
 
-  received_velocity_msg_ptr_.set(nullptr);
+  received_velocity_command_.reset(VelocityCommand{});
+  reset_interfaces();
   return true;
 }
 
+void TricycleController::reset_interfaces()
+{
+  std::fill(
+    reference_interfaces_.begin(), reference_interfaces_.end(),
+    std::numeric_limits<double>::quiet_NaN());
+  std::fill(
+    state_interfaces_values_.begin(), state_interfaces_values_.end(),
+    std::numeric_limits<double>::quiet_NaN());
+}
+
 void TricycleController::halt()
 {
   traction_joint_[0].velocity_command.get().set_value(0.0);
@@ -548,8 +689,45 @@ std::tuple<double, double> TricycleController::twist_to_ackermann(double Vx, dou
   return std::make_tuple(alpha, Ws);
 }
 
+bool TricycleController::on_set_chained_mode(bool /*chained_mode*/) { return true; }
+
+std::vector<hardware_interface::CommandInterface>
+TricycleController::on_export_reference_interfaces()
+{
+  std::vector<hardware_interface::CommandInterface> reference_interfaces;
+  reference_interfaces.reserve(reference_interfaces_.size());
+
+  reference_interfaces.push_back(
+    hardware_interface::CommandInterface(
+      get_node()->get_name() + std::string("/linear"), HW_IF_VELOCITY, &reference_interfaces_[0]));
+
+  reference_interfaces.push_back(
+    hardware_interface::CommandInterface(
+      get_node()->get_name() + std::string("/angular"), HW_IF_VELOCITY,
+      &reference_interfaces_[1]));
+
+  return reference_interfaces;
+}
+
+std::vector<hardware_interface::StateInterface> TricycleController::on_export_state_interfaces()
+{
+  // e.g. <controller_name>/odometry/x, in the order written by update_and_write_commands()
+  const std::string prefix = get_node()->get_name() + std::string("/odometry");
+  const std::array<const char *, 5> names = {
+    {"x", "y", "heading", "linear_velocity", "angular_velocity"}};
+
+  std::vector<hardware_interface::StateInterface> state_interfaces;
+  state_interfaces.reserve(names.size());
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    state_interfaces.push_back(
+      hardware_interface::StateInterface(prefix, names[i], &state_interfaces_values_[i]));
+  }
+  return state_interfaces;
+}
+
 }  // namespace tricycle_controller
 
 #include <pluginlib/class_list_macros.hpp>
 PLUGINLIB_EXPORT_CLASS(
-  tricycle_controller::TricycleController, controller_interface::ControllerInterface)
+  tricycle_controller::TricycleController, controller_interface::ChainableControllerInterface)
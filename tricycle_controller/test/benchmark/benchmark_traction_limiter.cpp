@@ -0,0 +1,113 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+#include "tricycle_controller/multi_axis_traction_limiter.hpp"
+#include "tricycle_controller/traction_limiter.hpp"
+
+namespace
+{
+using tricycle_controller::MultiAxisTractionLimiter;
+using tricycle_controller::TractionLimiter;
+
+// alternately all limits and only some of them enabled
+std::vector<TractionLimiter> make_limiters(size_t axes)
+{
+  std::vector<TractionLimiter> limiters;
+  for (size_t i = 0; i < axes; ++i)
+  {
+    if (i % 2 == 0)
+    {
+      limiters.emplace_back(0.0, 2.0, 0.0, 1.0, 0.0, 3.0, 0.0, 5.0);
+    }
+    else
+    {
+      limiters.emplace_back(NAN, 2.0, NAN, 1.0, NAN, NAN, NAN, NAN);
+    }
+  }
+  return limiters;
+}
+
+// velocities of each cycle, precomputed so that only the limiters are measured
+std::vector<std::vector<double>> make_velocities(size_t axes)
+{
+  std::vector<std::vector<double>> velocities(256, std::vector<double>(axes));
+  for (size_t cycle = 0; cycle < velocities.size(); ++cycle)
+  {
+    for (size_t i = 0; i < axes; ++i)
+    {
+      velocities[cycle][i] =
+        3.0 * std::sin(0.05 * static_cast<double>(cycle) + static_cast<double>(i));
+    }
+  }
+  return velocities;
+}
+
+void BM_TractionLimiterPerAxis(benchmark::State & state)
+{
+  const auto axes = static_cast<size_t>(state.range(0));
+  auto limiters = make_limiters(axes);
+  const auto velocities = make_velocities(axes);
+  std::vector<double> v(axes);
+  std::vector<double> v0(axes, 0.0);
+  std::vector<double> v1(axes, 0.0);
+  std::vector<double> factors(axes);
+  size_t cycle = 0;
+  for (auto _ : state)
+  {
+    v = velocities[cycle];
+    for (size_t i = 0; i < axes; ++i)
+    {
+      factors[i] = limiters[i].limit(v[i], v0[i], v1[i], 0.01);
+    }
+    benchmark::DoNotOptimize(factors.data());
+    benchmark::ClobberMemory();
+    v1.swap(v0);
+    v0.swap(v);
+    cycle = (cycle + 1) % velocities.size();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TractionLimiterPerAxis)->Arg(2)->Arg(4)->Arg(8)->Arg(32);
+
+void BM_MultiAxisTractionLimiter(benchmark::State & state)
+{
+  const auto axes = static_cast<size_t>(state.range(0));
+  const MultiAxisTractionLimiter limiter(make_limiters(axes));
+  const auto velocities = make_velocities(axes);
+  std::vector<double> v(axes);
+  std::vector<double> v0(axes, 0.0);
+  std::vector<double> v1(axes, 0.0);
+  std::vector<double> factors(axes);
+  size_t cycle = 0;
+  for (auto _ : state)
+  {
+    v = velocities[cycle];
+    limiter.limit(v, v0, v1, 0.01, factors);
+    benchmark::DoNotOptimize(factors.data());
+    benchmark::ClobberMemory();
+    v1.swap(v0);
+    v0.swap(v);
+    cycle = (cycle + 1) % velocities.size();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MultiAxisTractionLimiter)->Arg(2)->Arg(4)->Arg(8)->Arg(32);
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,125 @@
+// Copyright 2025 ros2_control development team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "tricycle_controller/multi_axis_traction_limiter.hpp"
+#include "tricycle_controller/traction_limiter.hpp"
+
+using tricycle_controller::MultiAxisTractionLimiter;
+using tricycle_controller::TractionLimiter;
+
+namespace
+{
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+// the limiter configurations of test_traction_limiter.cpp, and with single limits disabled
+std::vector<TractionLimiter> make_limiters()
+{
+  return {
+    TractionLimiter(),
+    TractionLimiter(0.5, 1.0, 0.5, 1.0, 2.0, 3.0, 0.5, 5.0),
+    TractionLimiter(NaN, NaN, 0.5, 1.0, 2.0, 3.0, 0.5, 5.0),
+    TractionLimiter(0.5, 1.0, NaN, NaN, 2.0, 3.0, 0.5, 5.0),
+    TractionLimiter(0.5, 1.0, 0.5, 1.0, NaN, NaN, 0.5, 5.0),
+    TractionLimiter(0.5, 1.0, 0.5, 1.0, 2.0, 3.0, NaN, NaN),
+    TractionLimiter(NaN, NaN, NaN, NaN, NaN, NaN, 0.5, 5.0),
+    TractionLimiter(NaN, 1.0, NaN, 1.0, NaN, 3.0, NaN, 5.0),
+    TractionLimiter(0.0, 2.0, NaN, NaN, 1.0, NaN, NaN, NaN),
+  };
+}
+}  // namespace
+
+TEST(MultiAxisTractionLimiterTest, empty)
+{
+  MultiAxisTractionLimiter limiter;
+  EXPECT_EQ(limiter.size(), 0u);
+  std::vector<double> v, v0, v1, factors;
+  EXPECT_NO_THROW(limiter.limit(v, v0, v1, 0.1, factors));
+}
+
+TEST(MultiAxisTractionLimiterTest, matches_traction_limiter_expectations)
+{
+  // the expectations of SpeedLimiterTest.testVelocityLimits on two axes with the same limits
+  const TractionLimiter axis(0.5, 1.0, 0.5, 1.0, 2.0, 3.0, 0.5, 5.0);
+  MultiAxisTractionLimiter limiter({axis, axis});
+  ASSERT_EQ(limiter.size(), 2u);
+
+  std::vector<double> v = {10.0, -10.0};
+  const std::vector<double> zero = {0.0, 0.0};
+  std::vector<double> factors(2);
+  limiter.limit(v, zero, zero, 0.5, factors);
+  // acceleration is limiting, which is 1.0m.s-2 * 0.5s
+  EXPECT_DOUBLE_EQ(v[0], 0.5);
+  EXPECT_DOUBLE_EQ(v[1], -0.5);
+  EXPECT_DOUBLE_EQ(factors[0], 0.5 / 10.0);
+  EXPECT_DOUBLE_EQ(factors[1], 0.5 / 10.0);
+
+  // SpeedLimiterTest.testNoLimits
+  MultiAxisTractionLimiter unlimited({TractionLimiter(), TractionLimiter()});
+  v = {10.0, -10.0};
+  unlimited.limit(v, zero, zero, 0.5, factors);
+  EXPECT_DOUBLE_EQ(v[0], 10.0);
+  EXPECT_DOUBLE_EQ(v[1], -10.0);
+  EXPECT_THAT(factors, ::testing::Each(1.0));
+}
+
+TEST(MultiAxisTractionLimiterTest, matches_traction_limiter_per_axis)
+{
+  auto scalar_limiters = make_limiters();
+  const MultiAxisTractionLimiter limiter(scalar_limiters);
+  const size_t n = scalar_limiters.size();
+  ASSERT_EQ(limiter.size(), n);
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> velocity(-5.0, 5.0);
+  std::vector<double> v(n), v0(n), v1(n), factors(n);
+  for (const double dt : {0.0, 0.001, 0.01, 0.5})
+  {
+    for (int sample = 0; sample < 1000; ++sample)
+    {
+      for (size_t i = 0; i < n; ++i)
+      {
+        v[i] = velocity(generator);
+        v0[i] = velocity(generator);
+        v1[i] = velocity(generator);
+      }
+      // zero velocities and histories are special cases of the scalar limiter
+      if (sample % 10 == 0)
+      {
+        v[sample % n] = 0.0;
+        v0[(sample + 1) % n] = 0.0;
+        v1[(sample + 2) % n] = v0[(sample + 2) % n];
+      }
+
+      std::vector<double> expected = v;
+      std::vector<double> expected_factors(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        expected_factors[i] = scalar_limiters[i].limit(expected[i], v0[i], v1[i], dt);
+      }
+
+      limiter.limit(v, v0, v1, dt, factors);
+      for (size_t i = 0; i < n; ++i)
+      {
+        EXPECT_DOUBLE_EQ(v[i], expected[i]) << "axis " << i << ", dt " << dt;
+        EXPECT_DOUBLE_EQ(factors[i], expected_factors[i]) << "axis " << i << ", dt " << dt;
+      }
+    }
+  }
+}
@@ -18,6 +18,7 @@
 
 #include <gmock/gmock.h>
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <thread>
@@ -30,6 +31,7 @@
 #include "lifecycle_msgs/msg/state.hpp"
 #include "rclcpp/executor.hpp"
 #include "rclcpp/executors.hpp"
+#include "tf2/LinearMath/Quaternion.hpp"
 #include "tricycle_controller/tricycle_controller.hpp"
 
 using CallbackReturn = controller_interface::CallbackReturn;
@@ -51,14 +53,45 @@ class TestableTricycleController : public tricycle_controller::TricycleControlle
 {
 public:
   using TricycleController::TricycleController;
-  std::shared_ptr<geometry_msgs::msg::TwistStamped> getLastReceivedTwist()
+  VelocityCommand getLastReceivedCommand()
   {
-    std::shared_ptr<geometry_msgs::msg::TwistStamped> ret;
-    received_velocity_msg_ptr_.get(
-      [&ret](const std::shared_ptr<geometry_msgs::msg::TwistStamped> & msg) { ret = msg; });
+    VelocityCommand ret;
+    received_velocity_command_.read(ret);
     return ret;
   }
 
+  // Imitate a preceding controller in chained mode
+  void setReferences(double linear, double angular)
+  {
+    reference_interfaces_[0] = linear;
+    reference_interfaces_[1] = angular;
+  }
+
+  const std::vector<double> & getReferences() const { return reference_interfaces_; }
+
+  const tricycle_controller::Odometry & getOdometry() const { return odometry_; }
+
+  const SteadyCommandCache & getInverseKinematicsCache() const { return ik_cache_; }
+
+  // Imitate the service and subscriber callbacks
+  void callResetOdometry() { reset_odometry(nullptr, nullptr, nullptr); }
+
+  void publishOdometryPose(
+    double x, double y, double heading, const std::string & frame_id = "odom")
+  {
+    auto msg = std::make_shared<geometry_msgs::msg::PoseWithCovarianceStamped>();
+    msg->header.frame_id = frame_id;
+    msg->pose.pose.position.x = x;
+    msg->pose.pose.position.y = y;
+    tf2::Quaternion orientation;
+    orientation.setRPY(0.0, 0.0, heading);
+    msg->pose.pose.orientation.x = orientation.x();
+    msg->pose.pose.orientation.y = orientation.y();
+    msg->pose.pose.orientation.z = orientation.z();
+    msg->pose.pose.orientation.w = orientation.w();
+    set_odometry_pose(msg);
+  }
+
   /**
    * @brief wait_for_twist block until a new twist is received.
    * Requires that the executor is not spinned elsewhere between the
@@ -353,3 +386,402 @@ TEST_F(TestTricycleController, correct_initialization_using_parameters)
   ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
   executor.cancel();
 }
+
+TEST_F(TestTricycleController, timeout_does_not_modify_received_command)
+{
+  ASSERT_EQ(
+    InitController(
+      traction_joint_name, steering_joint_name,
+      {rclcpp::Parameter("wheelbase", 0.4), rclcpp::Parameter("wheel_radius", 1.0)}),
+    controller_interface::return_type::OK);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(controller_->get_node()->get_node_base_interface());
+
+  auto state = controller_->configure();
+  assignResources();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  const double linear = 1.0;
+  const double angular = 0.0;
+  publish(linear, angular);
+  controller_->wait_for_twist(executor);
+
+  // long after the command was sent, the wheels are braked
+  const rclcpp::Time late_time =
+    controller_->get_node()->now() + rclcpp::Duration::from_seconds(10.0);
+  ASSERT_EQ(
+    controller_->update(late_time, rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(0.0, traction_joint_vel_cmd_.get_value());
+
+  // but the received command is unchanged
+  const auto command = controller_->getLastReceivedCommand();
+  EXPECT_EQ(linear, command.linear);
+  EXPECT_EQ(angular, command.angular);
+
+  // and still applied by an update within the timeout
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(1.0, traction_joint_vel_cmd_.get_value());
+
+  state = controller_->get_node()->deactivate();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  executor.cancel();
+}
+
+TEST_F(TestTricycleController, acceleration_limit_uses_double_precision_history)
+{
+  const double max_acceleration = 0.3;
+  ASSERT_EQ(
+    InitController(
+      traction_joint_name, steering_joint_name,
+      {rclcpp::Parameter("wheelbase", 0.4), rclcpp::Parameter("wheel_radius", 1.0),
+       rclcpp::Parameter("traction.max_acceleration", max_acceleration)}),
+    controller_interface::return_type::OK);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(controller_->get_node()->get_node_base_interface());
+
+  auto state = controller_->configure();
+  assignResources();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  publish(1.0, 0.0);
+  controller_->wait_for_twist(executor);
+
+  // each step adds exactly max_acceleration * dt to the last command, without float rounding
+  const auto period = rclcpp::Duration::from_seconds(0.01);
+  double expected_velocity = 0.0;
+  for (int i = 0; i < 5; ++i)
+  {
+    ASSERT_EQ(
+      controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), period),
+      controller_interface::return_type::OK);
+    expected_velocity += max_acceleration * period.seconds();
+    EXPECT_EQ(expected_velocity, traction_joint_vel_cmd_.get_value());
+  }
+
+  state = controller_->get_node()->deactivate();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  executor.cancel();
+}
+
+TEST_F(TestTricycleController, inverse_kinematics_cache_skips_steady_commands)
+{
+  ASSERT_EQ(
+    InitController(
+      traction_joint_name, steering_joint_name,
+      {rclcpp::Parameter("inverse_kinematics_cache.enable", true)}),
+    controller_interface::return_type::OK);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(controller_->get_node()->get_node_base_interface());
+
+  auto state = controller_->configure();
+  assignResources();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  publish(1.0, 0.5);
+  controller_->wait_for_twist(executor);
+
+  const auto period = rclcpp::Duration::from_seconds(0.01);
+  const auto update = [&]()
+  {
+    ASSERT_EQ(
+      controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), period),
+      controller_interface::return_type::OK);
+  };
+  const auto & cache = controller_->getInverseKinematicsCache();
+
+  // the steering joint reaches the commanded angle with the first update, the command is stored
+  // with the second one, when it equals the last command
+  update();
+  update();
+  EXPECT_EQ(cache.hits(), 0u);
+  const double steering_angle = steering_joint_pos_cmd_.get_value();
+  const double traction_velocity = traction_joint_vel_cmd_.get_value();
+
+  for (int i = 0; i < 5; ++i)
+  {
+    update();
+    EXPECT_EQ(steering_angle, steering_joint_pos_cmd_.get_value());
+    EXPECT_EQ(traction_velocity, traction_joint_vel_cmd_.get_value());
+  }
+  EXPECT_EQ(cache.hits(), 5u);
+  EXPECT_EQ(cache.lookups(), 7u);
+
+  // a measured steering angle other than the cached one is a miss
+  position_ = steering_angle + 0.2;
+  update();
+  EXPECT_EQ(cache.hits(), 5u);
+  EXPECT_EQ(steering_angle, steering_joint_pos_cmd_.get_value());
+
+  state = controller_->get_node()->deactivate();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  executor.cancel();
+}
+
+TEST_F(TestTricycleController, reference_interfaces_are_properly_exported)
+{
+  ASSERT_EQ(
+    InitController(traction_joint_name, steering_joint_name),
+    controller_interface::return_type::OK);
+
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), CallbackReturn::SUCCESS);
+
+  auto reference_interfaces = controller_->export_reference_interfaces();
+  ASSERT_EQ(reference_interfaces.size(), 2u)
+    << "Expected exactly 2 reference interfaces: linear and angular";
+
+  const std::string expected_linear_prefix_name =
+    std::string(controller_->get_node()->get_name()) + std::string("/linear");
+  const std::string expected_angular_prefix_name =
+    std::string(controller_->get_node()->get_name()) + std::string("/angular");
+
+  EXPECT_EQ(reference_interfaces[0]->get_prefix_name(), expected_linear_prefix_name);
+  EXPECT_EQ(reference_interfaces[0]->get_interface_name(), HW_IF_VELOCITY);
+  EXPECT_EQ(reference_interfaces[1]->get_prefix_name(), expected_angular_prefix_name);
+  EXPECT_EQ(reference_interfaces[1]->get_interface_name(), HW_IF_VELOCITY);
+}
+
+TEST_F(TestTricycleController, odometry_state_interfaces_are_properly_exported)
+{
+  ASSERT_EQ(
+    InitController(traction_joint_name, steering_joint_name),
+    controller_interface::return_type::OK);
+
+  ASSERT_EQ(controller_->on_configure(rclcpp_lifecycle::State()), CallbackReturn::SUCCESS);
+
+  auto state_interfaces = controller_->export_state_interfaces();
+  ASSERT_EQ(state_interfaces.size(), 5u);
+
+  const std::string prefix = std::string(controller_->get_node()->get_name()) + "/odometry";
+  const std::vector<std::string> expected_names = {
+    "x", "y", "heading", "linear_velocity", "angular_velocity"};
+  for (size_t i = 0; i < expected_names.size(); ++i)
+  {
+    EXPECT_EQ(state_interfaces[i]->get_prefix_name(), prefix);
+    EXPECT_EQ(state_interfaces[i]->get_interface_name(), expected_names[i]);
+    // not set before the first update
+    EXPECT_TRUE(std::isnan(state_interfaces[i]->get_value()));
+  }
+}
+
+// When in chained mode, we want to test that
+// 1. the reference interfaces are used instead of the cmd_vel topic
+// 2. NaN references, i.e. not yet set, do not propagate to the command interfaces
+// 3. the odometry is exported as state interfaces
+TEST_F(TestTricycleController, chainable_controller_chained_mode)
+{
+  ASSERT_EQ(
+    InitController(
+      traction_joint_name, steering_joint_name,
+      {rclcpp::Parameter("wheelbase", 0.4), rclcpp::Parameter("wheel_radius", 1.0)}),
+    controller_interface::return_type::OK);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(controller_->get_node()->get_node_base_interface());
+
+  ASSERT_TRUE(controller_->is_chainable());
+  ASSERT_TRUE(controller_->set_chained_mode(true));
+  ASSERT_TRUE(controller_->is_in_chained_mode());
+
+  auto state = controller_->configure();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  assignResources();
+  auto state_interfaces = controller_->export_state_interfaces();
+
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  for (const auto & reference : controller_->getReferences())
+  {
+    EXPECT_TRUE(std::isnan(reference));
+  }
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_FALSE(std::isnan(steering_joint_pos_cmd_.get_value()));
+  EXPECT_FALSE(std::isnan(traction_joint_vel_cmd_.get_value()));
+
+  // a cmd_vel message is ignored in chained mode
+  waitForSetup();
+  publish(2.0, 0.0);
+  controller_->wait_for_twist(executor);
+
+  const double linear = 1.0;
+  controller_->setReferences(linear, 0.0);
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(0.0, steering_joint_pos_cmd_.get_value());
+  EXPECT_EQ(linear, traction_joint_vel_cmd_.get_value());
+
+  // the odometry is integrated from the joint states
+  for (const auto & state_interface : state_interfaces)
+  {
+    EXPECT_FALSE(std::isnan(state_interface->get_value()));
+  }
+  EXPECT_GT(state_interfaces[3]->get_value(), 0.0);
+
+  state = controller_->get_node()->deactivate();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  EXPECT_EQ(0.0, steering_joint_pos_cmd_.get_value()) << "Wheels are halted on deactivate()";
+  EXPECT_EQ(0.0, traction_joint_vel_cmd_.get_value()) << "Wheels are halted on deactivate()";
+  executor.cancel();
+}
+
+TEST_F(TestTricycleController, odometry_reset_is_applied_by_the_next_update)
+{
+  // open loop, so that the odometry does not move with the zero command
+  ASSERT_EQ(
+    InitController(
+      traction_joint_name, steering_joint_name, {rclcpp::Parameter("open_loop", true)}),
+    controller_interface::return_type::OK);
+
+  auto state = controller_->configure();
+  ASSERT_EQ(State::PRIMARY_STATE_INACTIVE, state.id());
+  assignResources();
+  state = controller_->get_node()->activate();
+  ASSERT_EQ(State::PRIMARY_STATE_ACTIVE, state.id());
+
+  controller_->publishOdometryPose(1.0, -2.0, 0.5);
+  // the callbacks only hand the request over
+  EXPECT_EQ(controller_->getOdometry().getX(), 0.0);
+
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_DOUBLE_EQ(controller_->getOdometry().getX(), 1.0);
+  EXPECT_DOUBLE_EQ(controller_->getOdometry().getY(), -2.0);
+  EXPECT_NEAR(controller_->getOdometry().getHeading(), 0.5, 1e-12);
+
+  // a pose in another frame is ignored
+  controller_->publishOdometryPose(3.0, 3.0, 0.0, "map");
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_DOUBLE_EQ(controller_->getOdometry().getX(), 1.0);
+
+  // the latest request replaces the one which was not applied yet
+  controller_->publishOdometryPose(2.0, 2.0, 1.0);
+  controller_->callResetOdometry();
+  ASSERT_EQ(
+    controller_->update(rclcpp::Time(0, 0, RCL_ROS_TIME), rclcpp::Duration::from_seconds(0.01)),
+    controller_interface::return_type::OK);
+  EXPECT_EQ(controller_->getOdometry().getX(), 0.0);
+  EXPECT_EQ(controller_->getOdometry().getY(), 0.0);
+  EXPECT_EQ(controller_->getOdometry().getHeading(), 0.0);
+}
+
+TEST(TestTricycleOdometry, pose_covariance_is_propagated_from_wheel_noise)
+{
+  constexpr double WHEELBASE = 1.2;
+  constexpr double WHEEL_RADIUS = 0.2;
+  constexpr double TRACTION_WHEEL_VARIANCE_RATE = 1e-3;
+  constexpr double STEERING_ANGLE_VARIANCE_RATE = 1e-4;
+  constexpr double WHEEL_VELOCITY = 5.0;
+  constexpr double DT = 0.01;
+  constexpr int STEPS = 100;
+
+  tricycle_controller::Odometry odometry;
+  odometry.setWheelParams(WHEELBASE, WHEEL_RADIUS);
+  odometry.setPoseCovariancePropagation(
+    true, TRACTION_WHEEL_VARIANCE_RATE, STEERING_ANGLE_VARIANCE_RATE);
+
+  // drive straight ahead
+  for (int i = 0; i < STEPS; ++i)
+  {
+    ASSERT_TRUE(odometry.update(WHEEL_VELOCITY, 0.0, rclcpp::Duration::from_seconds(DT)));
+  }
+  const auto & covariance = odometry.getPoseCovariance();
+  const double displacement = WHEEL_VELOCITY * WHEEL_RADIUS * DT;
+  // the traction error is along the path, the steering error turns the heading
+  EXPECT_NEAR(covariance[0], STEPS * TRACTION_WHEEL_VARIANCE_RATE * displacement, 1e-12);
+  EXPECT_NEAR(
+    covariance[8],
+    STEPS * displacement * STEERING_ANGLE_VARIANCE_RATE / (WHEELBASE * WHEELBASE),
+    1e-12);
+  EXPECT_GT(covariance[4], 0.0);
+  EXPECT_NEAR(covariance[1], 0.0, 1e-12);
+  EXPECT_NEAR(covariance[2], 0.0, 1e-12);
+  for (size_t row = 0; row < 3; ++row)
+  {
+    for (size_t col = 0; col < 3; ++col)
+    {
+      EXPECT_EQ(covariance[3 * row + col], covariance[3 * col + row]);
+    }
+  }
+
+  // the open loop has no wheel measurement to propagate
+  const auto propagated = covariance;
+  odometry.updateOpenLoop(1.0, 0.5, rclcpp::Duration::from_seconds(DT));
+  EXPECT_EQ(odometry.getPoseCovariance(), propagated);
+
+  odometry.resetOdometry();
+  EXPECT_THAT(odometry.getPoseCovariance(), ::testing::Each(0.0));
+}
+
+TEST(TestTricycleOdometry, pose_covariance_does_not_depend_on_update_rate)
+{
+  constexpr double WHEELBASE = 1.2;
+  constexpr double WHEEL_RADIUS = 0.2;
+  constexpr double WHEEL_VELOCITY = 5.0;
+  constexpr double STEERING_ANGLE = 0.3;
+
+  const auto drive = [&](const int steps)
+  {
+    tricycle_controller::Odometry odometry;
+    odometry.setWheelParams(WHEELBASE, WHEEL_RADIUS);
+    odometry.setPoseCovariancePropagation(true, 1e-3, 1e-4);
+    // the same 1 m path along a constant arc, split into a different number of updates
+    const auto dt = rclcpp::Duration::from_seconds(1.0 / steps);
+    for (int i = 0; i < steps; ++i)
+    {
+      EXPECT_TRUE(odometry.update(WHEEL_VELOCITY, STEERING_ANGLE, dt));
+    }
+    return odometry.getPoseCovariance();
+  };
+
+  // only the linearization differs between 10 and 100 updates along the path
+  const auto slow = drive(10);
+  const auto fast = drive(100);
+  for (size_t i = 0; i < slow.size(); ++i)
+  {
+    EXPECT_NEAR(fast[i], slow[i], 1e-3 * std::abs(fast[i])) << "at index " << i;
+  }
+}
+
+TEST(TestTricycleOdometry, set_pose_replaces_the_pose_covariance)
+{
+  constexpr double DT = 0.01;
+
+  tricycle_controller::Odometry odometry;
+  odometry.setWheelParams(1.2, 0.2);
+  odometry.setPoseCovariancePropagation(true, 1e-3, 1e-4);
+  ASSERT_TRUE(odometry.update(5.0, 0.3, rclcpp::Duration::from_seconds(DT)));
+
+  const std::array<double, 9> pose_covariance{{0.1, 0.01, 0.0, 0.01, 0.2, 0.0, 0.0, 0.0, 0.05}};
+  odometry.setPose(1.0, -2.0, 0.5, pose_covariance);
+  EXPECT_EQ(odometry.getPoseCovariance(), pose_covariance);
+
+  // the covariance is propagated from the set one
+  ASSERT_TRUE(odometry.update(5.0, 0.3, rclcpp::Duration::from_seconds(DT)));
+  EXPECT_GT(odometry.getPoseCovariance()[0], pose_covariance[0]);
+  EXPECT_GT(odometry.getPoseCovariance()[8], pose_covariance[8]);
+
+  // a pose without covariance resets it
+  odometry.setPose(0.0, 0.0, 0.0);
+  EXPECT_THAT(odometry.getPoseCovariance(), ::testing::Each(0.0));
+}